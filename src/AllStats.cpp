@@ -14,13 +14,46 @@
 #include "AllStats.h"
 
 
+void resetStats(AllStats& allStats)
+{
+  allStats.vstats.reset();
+  allStats.tstats.reset();
+  allStats.cstats.reset();
+  allStats.refstats.reset();
+  allStats.duplstats.reset();
+  allStats.timers.reset();
+}
+
+
+void serializeStats(
+  const AllStats& allStats,
+  ostream& fout)
+{
+  // The timers are not included, as they describe a particular run.
+  allStats.vstats.serialize(fout);
+  allStats.tstats.serialize(fout);
+  allStats.cstats.serialize(fout);
+  allStats.refstats.serialize(fout);
+  allStats.duplstats.serialize(fout);
+}
+
+
+void deserializeStats(
+  AllStats& allStats,
+  istream& fin)
+{
+  allStats.vstats.deserialize(fin);
+  allStats.tstats.deserialize(fin);
+  allStats.cstats.deserialize(fin);
+  allStats.refstats.deserialize(fin);
+  allStats.duplstats.deserialize(fin);
+}
+
+
 void mergeResults(
   vector<AllStats>& allStatsList,
   const Options& options)
 {
-  if (options.numThreads == 1)
-    return;
-
   for (unsigned i = 1; i < options.numThreads; i++)
   {
     allStatsList[0].vstats += allStatsList[i].vstats;
@@ -31,10 +64,14 @@ void mergeResults(
     allStatsList[0].refstats += allStatsList[i].refstats;
   }
 
+  // The duplicate search relies on the order, also with one thread.
   if (options.equalFlag)
+  {
+    allStatsList[0].duplstats.setLSH(options.lshBands, options.lshRows);
     allStatsList[0].duplstats.sortOverall();
+  }
 
-  if (! options.fileLog.setFlag)
+  if (options.numThreads == 1 || ! options.fileLog.setFlag)
     return;
 
   ofstream fbase(options.fileLog.name, std::ofstream::app);
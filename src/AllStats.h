@@ -36,6 +36,16 @@ struct AllStats
 };
 
 
+void resetStats(AllStats& allStats);
+
+void serializeStats(
+  const AllStats& allStats,
+  ostream& fout);
+
+void deserializeStats(
+  AllStats& allStats,
+  istream& fin);
+
 void mergeResults(
   vector<AllStats>& allStatsList,
   const Options& options);
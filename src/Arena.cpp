@@ -0,0 +1,121 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <cstdint>
+
+#include "Arena.h"
+
+// Most files fit in a few blocks of this size.  Larger requests get
+// a block of their own.
+#define ARENA_BLOCK (1 << 18)
+
+
+static thread_local Arena * currentArena = nullptr;
+
+
+Arena::Arena()
+{
+  blockNo = 0;
+  used = 0;
+  numAllocs = 0;
+  numBytes = 0;
+}
+
+
+Arena::~Arena()
+{
+  for (auto &block: blocks)
+    delete [] block.data;
+}
+
+
+void Arena::reset()
+{
+  // Keeps the blocks for the next task.
+  blockNo = 0;
+  used = 0;
+  numAllocs = 0;
+  numBytes = 0;
+}
+
+
+void * Arena::allocate(
+  const size_t n,
+  const size_t align)
+{
+  numAllocs++;
+  numBytes += n;
+
+  while (blockNo < blocks.size())
+  {
+    Block& block = blocks[blockNo];
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+    const size_t start =
+      ((base + used + align - 1) & ~(align - 1)) - base;
+
+    if (start + n <= block.size)
+    {
+      used = start + n;
+      return block.data + start;
+    }
+
+    blockNo++;
+    used = 0;
+  }
+
+  // new[] of char is aligned for any fundamental type.
+  Block block;
+  block.size = (n > ARENA_BLOCK ? n : ARENA_BLOCK);
+  block.data = new char[block.size];
+  blocks.push_back(block);
+
+  blockNo = static_cast<unsigned>(blocks.size() - 1);
+  used = n;
+  return block.data;
+}
+
+
+unsigned long long Arena::count() const
+{
+  return numAllocs;
+}
+
+
+unsigned long long Arena::bytes() const
+{
+  return numBytes;
+}
+
+
+Arena * Arena::current()
+{
+  return currentArena;
+}
+
+
+void Arena::setCurrent(Arena * arena)
+{
+  currentArena = arena;
+}
+
+
+ArenaScope::ArenaScope(Arena& arenaIn)
+{
+  arena = &arenaIn;
+  previous = Arena::current();
+  Arena::setCurrent(arena);
+}
+
+
+ArenaScope::~ArenaScope()
+{
+  Arena::setCurrent(previous);
+  arena->reset();
+}
+
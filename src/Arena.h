@@ -0,0 +1,160 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// An Arena hands out memory from large blocks and never frees single
+// allocations.  Each dispatch thread has one, and a Group and the
+// boards under it are allocated from it while a task is running.  At
+// the end of the task all of it is released at once, and the blocks
+// are kept for the next task on the thread.
+//
+// The containers of the board tree use ArenaAlloc, which takes the
+// arena that is current on the thread when the container is made.
+// Without a current arena, as in the pipelined mode where a Group
+// moves between threads, it uses the heap as usual.
+
+
+#ifndef BRIDGE_ARENA_H
+#define BRIDGE_ARENA_H
+
+#include <vector>
+#include <deque>
+#include <new>
+
+#include "bconst.h"
+
+using namespace std;
+
+
+class Arena
+{
+  private:
+
+    struct Block
+    {
+      char * data;
+      size_t size;
+    };
+
+    vector<Block> blocks;
+    unsigned blockNo;
+    size_t used;
+
+    unsigned long long numAllocs;
+    unsigned long long numBytes;
+
+
+  public:
+
+    Arena();
+
+    ~Arena();
+
+    void reset();
+
+    void * allocate(
+      const size_t n,
+      const size_t align);
+
+    // Allocations and bytes handed out since the last reset.
+    unsigned long long count() const;
+    unsigned long long bytes() const;
+
+    static Arena * current();
+    static void setCurrent(Arena * arena);
+};
+
+
+// Makes an arena current on this thread for the length of a scope,
+// and releases everything in it at the end.
+
+class ArenaScope
+{
+  private:
+
+    Arena * arena;
+    Arena * previous;
+
+
+  public:
+
+    ArenaScope(Arena& arenaIn);
+
+    ~ArenaScope();
+};
+
+
+template <class T>
+class ArenaAlloc
+{
+  public:
+
+    typedef T value_type;
+
+    // A container keeps the arena it was made with, also when it is
+    // moved or swapped.  A copy goes into the current arena.
+    typedef true_type propagate_on_container_move_assignment;
+    typedef true_type propagate_on_container_swap;
+
+    Arena * arena;
+
+    ArenaAlloc() : arena(Arena::current()) {}
+
+    template <class U>
+    ArenaAlloc(const ArenaAlloc<U>& a2) : arena(a2.arena) {}
+
+    ArenaAlloc select_on_container_copy_construction() const
+    {
+      return ArenaAlloc();
+    }
+
+    T * allocate(const size_t n)
+    {
+      if (arena == nullptr)
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+      else
+        return static_cast<T *>(arena->allocate(n * sizeof(T),
+          alignof(T)));
+    }
+
+    void deallocate(
+      T * p,
+      const size_t n)
+    {
+      UNUSED(n);
+      if (arena == nullptr)
+        ::operator delete(p);
+    }
+};
+
+
+template <class T, class U>
+bool operator == (
+  const ArenaAlloc<T>& a1,
+  const ArenaAlloc<U>& a2)
+{
+  return (a1.arena == a2.arena);
+}
+
+
+template <class T, class U>
+bool operator != (
+  const ArenaAlloc<T>& a1,
+  const ArenaAlloc<U>& a2)
+{
+  return (a1.arena != a2.arena);
+}
+
+
+template <class T>
+using ArenaVector = vector<T, ArenaAlloc<T>>;
+
+template <class T>
+using ArenaDeque = deque<T, ArenaAlloc<T>>;
+
+#endif
+
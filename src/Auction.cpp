@@ -8,26 +8,17 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
-#include <map>
-#include <regex>
-
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.thread.h"
-  #include "mingw.mutex.h"
-#else
-  #include <thread>
-  #include <mutex>
-#endif
+#include <cstring>
 
 #include "Auction.h"
+#include "append.h"
 #include "Contract.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
-
-static mutex mtx;
+#include "ctable.h"
 
 
 #define AUCTION_SEQ_INIT 12
@@ -35,6 +26,14 @@ static mutex mtx;
 
 #define AUCTION_NUM_CALLS 38
 
+// The longest legal auction has 319 calls.
+#define AUCTION_MAX_LEN 319
+
+// Room for the views of the longest PBN auction, where every call
+// may have a note line, and an alert and a NAG word.
+#define AUCTION_PBN_LINES (2 * AUCTION_MAX_LEN + 1)
+#define AUCTION_PBN_WORDS (3 * AUCTION_MAX_LEN)
+
 static string AUCTION_NO_TO_CALL_LIN[AUCTION_NUM_CALLS]; // And RBN
 static string AUCTION_NO_TO_CALL_PBN[AUCTION_NUM_CALLS];
 static string AUCTION_NO_TO_CALL_TXT[AUCTION_NUM_CALLS];
@@ -51,22 +50,22 @@ static const string AUCTION_DENOM_PBN[BRIDGE_DENOMS] =
   "C", "D", "H", "S", "NT"
 };
 
-static map<string, unsigned> AUCTION_CALL_TO_NO; // All syntaxes
+// Bids are decoded directly from their characters, in the order
+// of AUCTION_DENOM_LIN.  The table is fixed at compile time.
+
+static constexpr unsigned auctionCharToDenom(const unsigned c)
+{
+  return (c == 'C' ? 0 : c == 'D' ? 1 : c == 'H' ? 2 : c == 'S' ? 3 :
+    c == 'N' ? 4 : BRIDGE_DENOMS);
+}
 
-static bool setAuctionTables = false;
+static constexpr unsigned AUCTION_CHAR_TO_DENOM[256] =
+  { CTABLE_256(auctionCharToDenom, 0) };
 
 
 Auction::Auction()
 {
   Auction::reset();
-  if (! setAuctionTables)
-  {
-    mtx.lock();
-    if (! setAuctionTables)
-      Auction::setTables();
-    setAuctionTables = true;
-    mtx.unlock();
-  }
 }
 
 
@@ -78,6 +77,8 @@ Auction::~Auction()
 void Auction::reset()
 {
   setDVFlag = false;
+  dealer = BRIDGE_PLAYER_SIZE;
+  vul = BRIDGE_VUL_SIZE;
   len = 0;
   lenMax = AUCTION_SEQ_INIT;
   sequence.resize(lenMax);
@@ -124,16 +125,42 @@ void Auction::setTables()
       p++;
     }
   }
+}
+
 
-  for (p = 0; p < AUCTION_NUM_CALLS; p++)
+static unsigned callToNo(const string& call)
+{
+  // Accepts all syntaxes.  Returns AUCTION_NUM_CALLS if not a call.
+  const size_t l = call.length();
+  if (l >= 2 && call[0] >= '1' && call[0] <= '7')
   {
-    AUCTION_CALL_TO_NO[AUCTION_NO_TO_CALL_LIN[p]] = p;
-    AUCTION_CALL_TO_NO[AUCTION_NO_TO_CALL_PBN[p]] = p;
-    AUCTION_CALL_TO_NO[AUCTION_NO_TO_CALL_EML[p]] = p;
-    AUCTION_CALL_TO_NO[AUCTION_NO_TO_CALL_TXT[p]] = p;
+    const unsigned level = static_cast<unsigned>(call[0] - '0');
+    const unsigned denom =
+      AUCTION_CHAR_TO_DENOM[static_cast<unsigned char>(call[1])];
+    if (denom == BRIDGE_DENOMS)
+      return AUCTION_NUM_CALLS;
+
+    if (l == 3 && (denom != BRIDGE_NOTRUMP || call[2] != 'T'))
+      return AUCTION_NUM_CALLS;
+    else if (l > 3)
+      return AUCTION_NUM_CALLS;
+
+    return 3 + BRIDGE_DENOMS * (level-1) + denom;
   }
 
-  AUCTION_CALL_TO_NO["PASS"] = 0;
+  for (unsigned p = 0; p < 3; p++)
+  {
+    if (call == AUCTION_NO_TO_CALL_LIN[p] ||
+        call == AUCTION_NO_TO_CALL_PBN[p] ||
+        call == AUCTION_NO_TO_CALL_EML[p] ||
+        call == AUCTION_NO_TO_CALL_TXT[p])
+      return p;
+  }
+
+  if (call == "PASS")
+    return 0;
+
+  return AUCTION_NUM_CALLS;
 }
 
 
@@ -295,11 +322,10 @@ void Auction::addCall(
   if (len == lenMax)
     Auction::extend();
 
-  auto it = AUCTION_CALL_TO_NO.find(c);
-  if (it == AUCTION_CALL_TO_NO.end())
+  const unsigned n = callToNo(c);
+  if (n == AUCTION_NUM_CALLS)
     THROW("Illegal call: " + call);
 
-  unsigned n = it->second;
   if (n == 0)
     numPasses++;
   else if (n == 1)
@@ -483,33 +509,50 @@ void Auction::addAuctionLIN(const string& text)
 
 
 bool Auction::isPBNNote(
-  const string& text,
+  const StrView& text,
   int& no,
   string& alert) const
 {
-  regex re("^\\[Note \"(\\d+):(.*)\"\\]$");
-  smatch match;
-  if (regex_search(text, match, re) && match.size() >= 2)
+  // [Note "n:alert"] where n is one or more digits.
+  const unsigned l = text.len;
+  if (l < 11 || strncmp(text.text, "[Note \"", 7) != 0 ||
+      text.text[l-2] != '"' || text.text[l-1] != ']')
+    return false;
+
+  unsigned pos = 7;
+  while (pos < l-2 && text.text[pos] >= '0' && text.text[pos] <= '9')
+    pos++;
+
+  if (pos == 7 || pos == l-2 || text.text[pos] != ':')
+    return false;
+
+  for (unsigned i = pos+1; i < l-2; i++)
   {
-    if (! str2int(match.str(1), no))
+    if (text.text[i] == '\n' || text.text[i] == '\r')
       return false;
-
-    alert = match.str(2);
-    if (alert == "")
-      alert = "!";
-    return true;
   }
-  else
+
+  if (! str2int(string(text.text + 7, pos-7), no))
     return false;
+
+  alert = string(text.text + pos + 1, l - pos - 3);
+  if (alert == "")
+    alert = "!";
+  return true;
 }
 
 
-void Auction::addAuctionPBN(const vector<string>& list)
+void Auction::addAuctionPBN(
+  const StrView list[],
+  const unsigned count)
 {
   if (! setDVFlag)
     THROW("Dealer and vul should be set by now");
 
-  Player dlr = str2player(list[0]);
+  if (count == 0)
+    THROW("Empty PBN auction");
+
+  Player dlr = str2player(view2str(list[0]));
   if (dlr == BRIDGE_PLAYER_SIZE)
     THROW("Not a PBN dealer");
 
@@ -517,7 +560,7 @@ void Auction::addAuctionPBN(const vector<string>& list)
     THROW("Auction has different dealer");
 
   // Get the alerts from the back.
-  unsigned end = static_cast<unsigned>(list.size()) - 1;
+  unsigned end = count - 1;
   vector<string> alerts;
   alerts.clear();
   int no;
@@ -528,52 +571,52 @@ void Auction::addAuctionPBN(const vector<string>& list)
     end--;
   }
 
-  // Get the auction (all of it for convenience).
-  string word;
-  vector<string> words;
-  words.clear();
+  // Get the auction (all of it for convenience).  Calls are short,
+  // so the strings made from the views below are not allocated.
+  StrView words[AUCTION_PBN_WORDS];
+  unsigned l = 0;
   for (unsigned i = 1; i <= end; i++)
   {
-    vector<string> ll;
-    splitIntoWords(list[i], ll);
-    for (auto &s: ll)
-      words.push_back(s);
+    unsigned n;
+    if (! splitIntoWords(list[i], words + l, AUCTION_PBN_WORDS - l, n))
+      THROW("Too many words in PBN auction");
+    l += n;
   }
 
-  const size_t l = words.size();
   for (size_t i = 0; i < l; i++)
   {
-    if (i < l-1 && words[i+1].at(0) == '=')
+    const string word = view2str(words[i]);
+    const string next = (i < l-1 ? view2str(words[i+1]) : "");
+    if (next.length() > 0 && next.at(0) == '=')
     {
       // Alert was spaced from bid.
       unsigned ano;
-      words[i+1].erase(0, 1);
-      if (! str2upos(words[i+1], ano))
+      if (! str2upos(next.substr(1), ano))
         THROW("Not an alert number");
 
       if (ano == 0 || ano > alerts.size())
         THROW("Alert number out of range: " + STR(ano));
 
-      Auction::addCall(words[i], alerts[ano-1]);
+      Auction::addCall(word, alerts[ano-1]);
 
       // Consume the alert.
       i++;
     }
-    else if (i < l-1 && words[i+1] == "$15")
+    else if (next == "$15")
     {
-      Auction::addCall(words[i] + "!", "");
+      Auction::addCall(word + "!", "");
       i++;
     }
-    else if (words[i].length() >= 4 &&
-        words[i].at(words[i].length()-1) == '=')
+    else if (word.length() >= 4 &&
+        word.at(word.length()-1) == '=')
     {
       // Alert is with bid (1S=1=).
       
-      size_t p = words[i].find("=");
-      const unsigned ll = words[i].length();
+      size_t p = word.find("=");
+      const unsigned ll = word.length();
       if (p == string::npos || p == 0 || p > ll-3)
-        THROW("Odd string: " + words[i]);
-      const string a = words[i].substr(p+1);
+        THROW("Odd string: " + word);
+      const string a = word.substr(p+1);
 
       unsigned ano;
       if (! str2upos(a, ano))
@@ -582,15 +625,15 @@ void Auction::addAuctionPBN(const vector<string>& list)
       if (ano == 0 || ano > alerts.size())
         THROW("Alert number out of range: " + STR(ano));
 
-      Auction::addCall(words[i].substr(0, p), alerts[ano-1]);
+      Auction::addCall(word.substr(0, p), alerts[ano-1]);
     }
-    else if (i == l-1 && words[i] == "AP")
+    else if (i == l-1 && word == "AP")
     {
       Auction::addPasses();
       return;
     }
     else
-      Auction::addCall(words[i]);
+      Auction::addCall(word);
   }
 }
 
@@ -701,9 +744,11 @@ void Auction::addAuction(
     
     case BRIDGE_FORMAT_PBN:
       {
-        vector<string> lines;
-        str2lines(text, lines);
-        Auction::addAuctionPBN(lines);
+        StrView lines[AUCTION_PBN_LINES];
+        unsigned count;
+        if (! str2lines(str2view(text), lines, AUCTION_PBN_LINES, count))
+          THROW("Too many lines in PBN auction");
+        Auction::addAuctionPBN(lines, count);
       }
       break;
     
@@ -797,6 +842,88 @@ bool Auction::lateAlerts() const
 }
 
 
+void Auction::writeBDB(BDBWriter& bw) const
+{
+  bw.putBool(setDVFlag);
+  bw.putByte(dealer);
+  bw.putByte(vul);
+
+  bw.putUnsigned(len);
+  for (unsigned l = 0; l < len; l++)
+  {
+    bw.putByte(sequence[l].no);
+    bw.putString(sequence[l].alert);
+  }
+
+  bw.putByte(numPasses);
+  bw.putByte(multiplier);
+  bw.putByte(activeCNo);
+  bw.putUnsigned(activeBNo);
+}
+
+
+void Auction::readBDB(BDBReader& br)
+{
+  Auction::reset();
+
+  setDVFlag = br.getBool();
+
+  // An unset dealer or vulnerability is stored as the enum size.
+  const unsigned d = br.getByte();
+  if (d > BRIDGE_WEST && d != BRIDGE_PLAYER_SIZE)
+    THROW("Bad dealer: " + STR(d));
+  dealer = static_cast<Player>(d);
+
+  const unsigned v = br.getByte();
+  if (v > BRIDGE_VUL_SIZE)
+    THROW("Bad vulnerability: " + STR(v));
+  vul = static_cast<Vul>(v);
+
+  len = br.getUnsigned();
+  if (len > AUCTION_MAX_LEN)
+    THROW("Too many calls: " + STR(len));
+  if (len > lenMax)
+  {
+    lenMax = len;
+    sequence.resize(lenMax);
+  }
+
+  for (unsigned l = 0; l < len; l++)
+  {
+    sequence[l].no = br.getByte();
+    if (sequence[l].no >= AUCTION_NUM_CALLS)
+      THROW("Bad call: " + STR(sequence[l].no));
+    sequence[l].alert = br.getString();
+  }
+
+  numPasses = br.getByte();
+  if (numPasses > 4)
+    THROW("Too many passes: " + STR(numPasses));
+
+  const unsigned m = br.getByte();
+  if (m > BRIDGE_MULT_REDOUBLED)
+    THROW("Bad multiplier: " + STR(m));
+  multiplier = static_cast<Multiplier>(m);
+
+  activeCNo = br.getByte();
+  if (activeCNo >= AUCTION_NUM_CALLS)
+    THROW("Bad active call: " + STR(activeCNo));
+
+  activeBNo = br.getUnsigned();
+  if (activeBNo > 0 && activeBNo >= len)
+    THROW("Bad active bid: " + STR(activeBNo));
+}
+
+
+size_t Auction::heapSize() const
+{
+  size_t n = sequence.capacity() * sizeof(Call);
+  for (auto &call: sequence)
+    n += ::heapSize(call.alert);
+  return n;
+}
+
+
 bool Auction::operator == (const Auction& auction2) const
 {
   if (setDVFlag != auction2.setDVFlag)
@@ -829,66 +956,65 @@ string Auction::strTXTHeader(const int * lengths) const
   if (lengths == nullptr)
     THROW("lengths is nullptr");
 
-  stringstream ss;
-  ss << left <<
-       setw(lengths[0]) << "West" << 
-       setw(lengths[1]) << "North" << 
-       setw(lengths[2]) << "East" << 
-       "South" << "\n";
-  return ss.str();
+  string st;
+  appendLeft(st, "West", static_cast<unsigned>(lengths[0]));
+  appendLeft(st, "North", static_cast<unsigned>(lengths[1]));
+  appendLeft(st, "East", static_cast<unsigned>(lengths[2]));
+  return st + "South\n";
 }
 
 
 string Auction::strEMLHeader() const
 {
-  stringstream ss;
-  ss << setw(9) << left << "west" <<
-      setw(9) << left << "north" <<
-      setw(9) << left << "east" <<
-      setw(9) << left << "south" << "\n\n\n";
-  return ss.str();
+  return "west     north    east     south    \n\n\n";
 }
 
 
-string Auction::strLIN() const
+void Auction::appendLIN(string& st) const
 {
-  stringstream ss;
   for (unsigned b = 0; b < len; b++)
   {
     const Call& c = sequence[b];
-    ss << "mb|" << AUCTION_NO_TO_CALL_LIN[c.no];
+    st += "mb|";
+    st += AUCTION_NO_TO_CALL_LIN[c.no];
     
     if (c.alert == "")
-      ss << "|";
+      st += "|";
     else if (c.alert == "!")
-      ss << "!|";
+      st += "!|";
     else
-      ss << "|an|" << c.alert << "|";
+    {
+      st += "|an|";
+      st += c.alert;
+      st += "|";
+    }
   }
-  ss << "pg||";
-  return ss.str();
+  st += "pg||";
 }
 
 
-string Auction::strLIN_RP() const
+void Auction::appendLIN_RP(string& st) const
 {
-  stringstream ss;
-  ss << "\nmb|";
+  st += "\nmb|";
   for (unsigned b = 0; b < len; b++)
-    ss << AUCTION_NO_TO_CALL_LIN[sequence[b].no];
-  ss << "|pg||\n";
-  return ss.str();
+    st += AUCTION_NO_TO_CALL_LIN[sequence[b].no];
+  st += "|pg||\n";
 }
 
 
-string Auction::strPBN() const
+void Auction::appendPBN(string& st) const
 {
-  stringstream ss, alerts;
-  ss << "[Auction \"" << PLAYER_NAMES_SHORT[dealer] << "\"]\n";
+  st += "[Auction \"";
+  st += PLAYER_NAMES_SHORT[dealer];
+  st += "\"]\n";
 
   if (Auction::isPassedOut() && ! lateAlerts())
-    return ss.str() + "AP\n";
+  {
+    st += "AP\n";
+    return;
+  }
 
+  string alerts;
   const bool shorten = (numPasses == 3 && ! lateAlerts());
   unsigned end = (shorten ? len-3 : len);
   unsigned aNo = 1;
@@ -896,99 +1022,99 @@ string Auction::strPBN() const
   {
     const Call& c = sequence[b];
     if (b % 4 > 0)
-      ss << " ";
-    ss << AUCTION_NO_TO_CALL_PBN[c.no];
+      st += " ";
+    st += AUCTION_NO_TO_CALL_PBN[c.no];
     if (c.alert != "")
     {
       if (c.alert == "!")
-        ss << " $15";
+        st += " $15";
       else
       {
-        ss << " =" << aNo << "=";
-	alerts << "[Note \"" << aNo << ":" << c.alert << "\"]\n";
+        st += " =";
+        appendUnsigned(st, aNo);
+        st += "=";
+	alerts += "[Note \"";
+	appendUnsigned(alerts, aNo);
+	alerts += ":" + c.alert + "\"]\n";
 	aNo++;
       }
     }
     if (b != end-1 && b % 4 == 3)
-      ss << "\n";
+      st += "\n";
   }
 
-  string st = trimTrailing(ss.str());
+  // Trim only the calls, which come after the newline of the header.
+  while (st.back() == ' ')
+    st.pop_back();
+
   if (shorten)
   {
     st += (end % 4 == 0 ? "\n" : " ");
     st += "AP";
   }
 
-  return st + "\n" + alerts.str();
+  st += "\n";
+  st += alerts;
 }
 
 
-string Auction::strRBNCore(const bool RBNflag) const
+void Auction::appendRBNCore(
+  string& st,
+  const bool RBNflag) const
 {
-  stringstream s, alerts;
-  s << PLAYER_NAMES_SHORT[dealer] << VUL_NAMES_RBN[vul] << ":";
+  st += PLAYER_NAMES_SHORT[dealer];
+  st += VUL_NAMES_RBN[vul];
+  st += ":";
   
   if (Auction::isPassedOut())
-    return s.str() + "A";
+  {
+    st += "A";
+    return;
+  }
 
+  string astr;
   unsigned end = (numPasses == 3 ? len-3 : len);
   unsigned aNo = 1;
   for (unsigned b = 0; b < end; b++)
   {
     const Call& c = sequence[b];
     if (c.no == 1)
-      s << "X";
+      st += "X";
     else
-      s << AUCTION_NO_TO_CALL_LIN[c.no];
+      st += AUCTION_NO_TO_CALL_LIN[c.no];
     if (c.alert == "!")
     {
-      s << "*";
+      st += "*";
     }
     else if (c.alert != "")
     {
-      s << "^" << aNo;
+      st += "^";
+      appendUnsigned(st, aNo);
+      appendUnsigned(astr, aNo);
       if (RBNflag)
-        alerts << aNo << " " << c.alert << "\n";
+        astr += " " + c.alert + "\n";
       else
-        alerts << aNo << "{" << c.alert << "}";
+        astr += "{" + c.alert + "}";
       aNo++;
     }
     if (b != end-1 && b % 4 == 3)
-      s << ":";
+      st += ":";
   }
 
   if (numPasses == 3)
   {
     if (end % 4 == 0)
-      s << ":";
-    s << "A";
+      st += ":";
+    st += "A";
   }
 
-  string astr = alerts.str();
-  string sep;
-  if (astr == "")
-  {
-    sep = "";
-  }
-  else
+  if (astr != "")
   {
-    sep = (RBNflag ? "\n" : "");
+    if (RBNflag)
+      st += "\n";
     astr.pop_back(); // Remove last newline
+    st += astr;
   }
-  return s.str() + sep + astr;
-}
-
-
-string Auction::strRBN() const
-{
-  return "A " + Auction::strRBNCore(true) + "\n";
-}
-
-
-string Auction::strRBX() const
-{
-  return "A{" + Auction::strRBNCore(false) + "}";
 }
 
 
@@ -998,28 +1124,28 @@ string Auction::strTXT(const int * lengths) const
     ((dealer + 4 - BRIDGE_WEST) % 4);
   const unsigned wrap = 3 - numSkips;
 
-  stringstream ss;
+  string st;
   for (unsigned i = 0; i < numSkips; i++)
-    ss << setw(lengths[i]) << "";
+    appendSpaces(st, static_cast<unsigned>(lengths[i]));
   
   if (Auction::isPassedOut())
-    return ss.str() + "All Pass\n";
+    return st + "All Pass\n";
 
   unsigned end = (numPasses == 3 ? len-3 : len);
   for (unsigned b = 0; b < end; b++)
   {
     const string& call = AUCTION_NO_TO_CALL_TXT[sequence[b].no];
     if (b % 4 == wrap)
-      ss << call << "\n";
+      st += call + "\n";
     else
-      ss << setw(lengths[(b+numSkips) % 4]) << left << 
-        AUCTION_NO_TO_CALL_TXT[sequence[b].no];
+      appendLeft(st, call,
+        static_cast<unsigned>(lengths[(b+numSkips) % 4]));
   }
 
   if (numPasses == 3)
-    return ss.str() + "All Pass\n";
+    return st + "All Pass\n";
 
-  string st = trimTrailing(ss.str());
+  st = trimTrailing(st);
 
   if ((end-1) % 4 != wrap)
     st += "\n";
@@ -1037,22 +1163,21 @@ string Auction::strEML() const
     ((dealer + 4 - BRIDGE_WEST) % 4);
   const unsigned wrap = 3 - numSkips;
 
-  stringstream ss;
-  for (unsigned i = 0; i < numSkips; i++)
-    ss << setw(9) << "";
+  string st;
+  appendSpaces(st, 9 * numSkips);
   
   unsigned end = (numPasses == 3 ? len-3 : len);
   for (unsigned b = 0; b < end; b++)
   {
-    ss << setw(9) << left << AUCTION_NO_TO_CALL_EML[sequence[b].no];
+    appendLeft(st, AUCTION_NO_TO_CALL_EML[sequence[b].no], 9);
     if (b % 4 == wrap)
-      ss << "\n";
+      st += "\n";
   }
 
   if (numPasses == 3)
-    return ss.str() + "(all pass)\n";
+    return st + "(all pass)\n";
 
-  string st = trimTrailing(ss.str());
+  st = trimTrailing(st);
 
   if ((end-1) % 4 != wrap)
     st += "\n";
@@ -1067,27 +1192,26 @@ string Auction::strREC() const
     ((dealer + 4 - BRIDGE_WEST) % 4);
   const unsigned wrap = 3 - numSkips;
 
-  stringstream ss;
-  for (unsigned i = 0; i < numSkips; i++)
-    ss << setw(9) << "";
+  string st;
+  appendSpaces(st, 9 * numSkips);
   
   if (Auction::isPassedOut())
-    return ss.str() + "All Pass\n\n";
+    return st + "All Pass\n\n";
 
   unsigned end = (numPasses == 3 ? len-3 : len);
   for (unsigned b = 0; b < end; b++)
   {
     const string& call = AUCTION_NO_TO_CALL_TXT[sequence[b].no];
     if (b % 4 == wrap)
-      ss << call << "\n";
+      st += call + "\n";
     else
-      ss << setw(9) << left << call;
+      appendLeft(st, call, 9);
   }
 
   if (numPasses == 3)
-    return ss.str() + "All Pass\n\n";
+    return st + "All Pass\n\n";
 
-  string st = trimTrailing(ss.str());
+  st = trimTrailing(st);
 
   if ((end-1) % 4 != wrap)
     st += "\n";
@@ -1096,59 +1220,67 @@ string Auction::strREC() const
 }
 
 
-string Auction::str(
+void Auction::appendStr(
+  string& st,
   const Format format,
   const int * lengths) const
 {
   if (! setDVFlag)
     DIFF("Dealer/vul not set");
 
-  string header;
   if (format == BRIDGE_FORMAT_TXT)
-  {
-    header = Auction::strTXTHeader(lengths);
-    if (len == 0)
-      return header;
-  }
+    st += Auction::strTXTHeader(lengths);
   else if (format == BRIDGE_FORMAT_EML)
-    header = Auction::strEMLHeader();
-  else
-    header = "";
+    st += Auction::strEMLHeader();
 
   if (len == 0)
-    return header;
+    return;
 
   switch(format)
   {
     case BRIDGE_FORMAT_LIN:
     case BRIDGE_FORMAT_LIN_TRN:
-      return Auction::strLIN();
+      Auction::appendLIN(st);
+      break;
 
     case BRIDGE_FORMAT_LIN_RP:
-      return Auction::strLIN_RP();
+      Auction::appendLIN_RP(st);
+      break;
     
     case BRIDGE_FORMAT_LIN_VG:
-      return Auction::strLIN() + "\n";
+      Auction::appendLIN(st);
+      st += "\n";
+      break;
 
     case BRIDGE_FORMAT_PBN:
-      return Auction::strPBN();
+      Auction::appendPBN(st);
+      break;
     
     case BRIDGE_FORMAT_RBN:
-      return Auction::strRBN();
+      st += "A ";
+      Auction::appendRBNCore(st, true);
+      st += "\n";
+      break;
     
     case BRIDGE_FORMAT_RBX:
-      return Auction::strRBX();
+      st += "A{";
+      Auction::appendRBNCore(st, false);
+      st += "}";
+      break;
     
     case BRIDGE_FORMAT_TXT:
       if (lengths == nullptr)
         THROW("TXT needs lengths");
-      return header + Auction::strTXT(lengths);
+      st += Auction::strTXT(lengths);
+      break;
     
     case BRIDGE_FORMAT_EML:
-      return header + Auction::strEML();
+      st += Auction::strEML();
+      break;
     
     case BRIDGE_FORMAT_REC:
-      return Auction::strREC();
+      st += Auction::strREC();
+      break;
     
     default:
       THROW("Invalid format: " + STR(format));
@@ -1156,6 +1288,16 @@ string Auction::str(
 }
 
 
+string Auction::str(
+  const Format format,
+  const int * lengths) const
+{
+  string st;
+  Auction::appendStr(st, format, lengths);
+  return st;
+}
+
+
 string Auction::strDealer(const Format format) const
 {
   if (! setDVFlag)
@@ -1164,7 +1306,7 @@ string Auction::strDealer(const Format format) const
   switch(format)
   {
     case BRIDGE_FORMAT_LIN:
-      return STR(PLAYER_DDS_TO_LIN_DEALER[dealer]);
+      return to_string(PLAYER_DDS_TO_LIN_DEALER[dealer]);
     
     case BRIDGE_FORMAT_PBN:
     case BRIDGE_FORMAT_RBN:
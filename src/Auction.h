@@ -15,10 +15,15 @@
 #include <vector>
 
 #include "bconst.h"
+#include "Arena.h"
 
 using namespace std;
 
+
+class BDBWriter;
+class BDBReader;
 class Contract;
+struct StrView;
 
 
 class Auction
@@ -37,15 +42,13 @@ class Auction
 
     unsigned len;
     unsigned lenMax;
-    vector<Call> sequence;
+    ArenaVector<Call> sequence;
     unsigned numPasses;
     Multiplier multiplier;
     unsigned activeCNo; // Contract number
     unsigned activeBNo; // Number in auction list
 
 
-    void setTables();
-
     void setDealerLIN(const string& text);
     void setDealerPBN(const string& text);
 
@@ -63,12 +66,14 @@ class Auction
       const bool extendedFlag) const;
 
     bool isPBNNote(
-      const string& text,
+      const StrView& text,
       int& no,
       string& alert) const;
 
     void addAuctionLIN(const string& list);
-    void addAuctionPBN(const vector<string>& list);
+    void addAuctionPBN(
+      const StrView list[],
+      const unsigned count);
     void addAuctionRBN(const string& text);
     void addAuctionRBNCore(
       const string& text,
@@ -76,12 +81,12 @@ class Auction
 
     string strTXTHeader(const int * lengths) const;
     string strEMLHeader() const;
-    string strLIN() const;
-    string strLIN_RP() const;
-    string strPBN() const;
-    string strRBNCore(const bool RBNflag) const;
-    string strRBN() const;
-    string strRBX() const;
+    void appendLIN(string& st) const;
+    void appendLIN_RP(string& st) const;
+    void appendPBN(string& st) const;
+    void appendRBNCore(
+      string& st,
+      const bool RBNflag) const;
     string strEML() const;
     string strTXT(const int * lengths) const;
     string strREC() const;
@@ -95,6 +100,8 @@ class Auction
 
     ~Auction();
 
+    static void setTables();
+
     void reset();
 
     // Dealer and vulnerability.
@@ -145,10 +152,21 @@ class Auction
     bool isEmpty() const;
 
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
+    size_t heapSize() const;
+
     bool operator == (const Auction& a2) const;
     bool operator != (const Auction& a2) const;
 
 
+    // The file writers append straight onto their output text.
+    void appendStr(
+      string& st,
+      const Format format,
+      const int * lengths = nullptr) const;
+
     string str(
       const Format format,
       const int * lengths = nullptr) const;
@@ -0,0 +1,270 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <sstream>
+#include <cstring>
+
+#include "BDB.h"
+#include "bconst.h"
+#include "Bexcept.h"
+
+#define BDB_MAGIC "BDB\x01"
+#define BDB_MAGIC_LEN 4
+
+
+BDBWriter::BDBWriter()
+{
+  BDBWriter::reset();
+}
+
+
+BDBWriter::~BDBWriter()
+{
+}
+
+
+void BDBWriter::reset()
+{
+  body = "";
+  strings.clear();
+  stringIndex.clear();
+}
+
+
+void BDBWriter::putByte(const unsigned u)
+{
+  if (u > 0xff)
+    THROW("Byte out of range: " + STR(u));
+
+  body += static_cast<char>(u);
+}
+
+
+void BDBWriter::putUnsigned(const unsigned u)
+{
+  unsigned v = u;
+  while (v >= 0x80)
+  {
+    body += static_cast<char>((v & 0x7f) | 0x80);
+    v >>= 7;
+  }
+  body += static_cast<char>(v);
+}
+
+
+void BDBWriter::putInt(const int i)
+{
+  // Zig-zag, so that small negative numbers stay short.
+  const unsigned u = static_cast<unsigned>(i);
+  BDBWriter::putUnsigned(i < 0 ? ((~u) << 1) | 1 : u << 1);
+}
+
+
+void BDBWriter::putFloat(const float f)
+{
+  char b[sizeof(float)];
+  memcpy(b, &f, sizeof(float));
+  body.append(b, sizeof(float));
+}
+
+
+void BDBWriter::putBool(const bool b)
+{
+  body += (b ? '\x01' : '\x00');
+}
+
+
+void BDBWriter::putHolding(const unsigned h)
+{
+  // 13 bits of cards, two bytes.
+  body += static_cast<char>(h & 0xff);
+  body += static_cast<char>((h >> 8) & 0xff);
+}
+
+
+void BDBWriter::putString(const string& st)
+{
+  auto it = stringIndex.find(st);
+  if (it == stringIndex.end())
+  {
+    const unsigned no = static_cast<unsigned>(strings.size());
+    it = stringIndex.emplace(st, no).first;
+    strings.push_back(&it->first);
+  }
+  BDBWriter::putUnsigned(it->second);
+}
+
+
+void BDBWriter::finish(string& text) const
+{
+  BDBWriter header;
+  header.body = string(BDB_MAGIC, BDB_MAGIC_LEN);
+  header.putUnsigned(static_cast<unsigned>(strings.size()));
+  for (auto sp: strings)
+  {
+    header.putUnsigned(static_cast<unsigned>(sp->size()));
+    header.body += * sp;
+  }
+
+  text = header.body + body;
+}
+
+
+void BDBWriter::takeBody(string& text)
+{
+  // Moves the body so far onto the end of text, but keeps the
+  // strings, so later bodies can refer to them.
+  text += body;
+  body.clear();
+}
+
+
+const vector<string const *>& BDBWriter::table() const
+{
+  return strings;
+}
+
+
+BDBReader::BDBReader()
+{
+  BDBReader::reset();
+}
+
+
+BDBReader::~BDBReader()
+{
+}
+
+
+void BDBReader::reset()
+{
+  pos = nullptr;
+  end = nullptr;
+  strings.clear();
+  sharedStrings = nullptr;
+}
+
+
+void BDBReader::check(const size_t n) const
+{
+  if (static_cast<size_t>(end - pos) < n)
+    THROW("BDB data truncated");
+}
+
+
+void BDBReader::set(
+  const char * data,
+  const size_t len)
+{
+  BDBReader::reset();
+  pos = data;
+  end = data + len;
+
+  BDBReader::check(BDB_MAGIC_LEN);
+  if (memcmp(pos, BDB_MAGIC, BDB_MAGIC_LEN) != 0)
+    THROW("Not a BDB file, or a different version");
+  pos += BDB_MAGIC_LEN;
+
+  const unsigned n = BDBReader::getUnsigned();
+  strings.resize(n);
+  for (unsigned i = 0; i < n; i++)
+  {
+    const unsigned l = BDBReader::getUnsigned();
+    BDBReader::check(l);
+    strings[i].assign(pos, l);
+    pos += l;
+  }
+}
+
+
+void BDBReader::setBody(
+  const char * data,
+  const size_t len,
+  const vector<string const *>& table)
+{
+  BDBReader::reset();
+  pos = data;
+  end = data + len;
+  sharedStrings = &table;
+}
+
+
+unsigned BDBReader::getByte()
+{
+  BDBReader::check(1);
+  return static_cast<unsigned char>(* pos++);
+}
+
+
+unsigned BDBReader::getUnsigned()
+{
+  unsigned u = 0;
+  for (unsigned shift = 0; shift < 35; shift += 7)
+  {
+    const unsigned b = BDBReader::getByte();
+    u |= (b & 0x7f) << shift;
+    if ((b & 0x80) == 0)
+      return u;
+  }
+  THROW("BDB number too long");
+}
+
+
+int BDBReader::getInt()
+{
+  const unsigned u = BDBReader::getUnsigned();
+  return static_cast<int>((u >> 1) ^ (~(u & 1) + 1));
+}
+
+
+float BDBReader::getFloat()
+{
+  BDBReader::check(sizeof(float));
+  float f;
+  memcpy(&f, pos, sizeof(float));
+  pos += sizeof(float);
+  return f;
+}
+
+
+bool BDBReader::getBool()
+{
+  return (BDBReader::getByte() != 0);
+}
+
+
+unsigned BDBReader::getHolding()
+{
+  const unsigned lo = BDBReader::getByte();
+  const unsigned hi = BDBReader::getByte();
+  return lo | (hi << 8);
+}
+
+
+const string& BDBReader::getString()
+{
+  const unsigned no = BDBReader::getUnsigned();
+  if (sharedStrings != nullptr)
+  {
+    if (no >= sharedStrings->size())
+      THROW("BDB string number out of range: " + STR(no));
+    return * (* sharedStrings)[no];
+  }
+
+  if (no >= strings.size())
+    THROW("BDB string number out of range: " + STR(no));
+  return strings[no];
+}
+
+
+bool BDBReader::done() const
+{
+  return (pos == end);
+}
+
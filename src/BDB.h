@@ -0,0 +1,103 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// BDBWriter and BDBReader carry the compact binary BDB format.
+// Numbers are variable-length (7 bits per byte), deals are suit
+// bitmasks and calls and cards are single byte codes.  Strings,
+// mostly player names, go into a table that precedes the body,
+// so each distinct string is stored once and read once.
+//
+// A Corpus instead keeps many separate bodies that share the string
+// table of one writer, and reads each body against that table.
+
+
+#ifndef BRIDGE_BDB_H
+#define BRIDGE_BDB_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+
+class BDBWriter
+{
+  private:
+
+    string body;
+    vector<string const *> strings;
+    unordered_map<string, unsigned> stringIndex;
+
+
+  public:
+
+    BDBWriter();
+
+    ~BDBWriter();
+
+    void reset();
+
+    void putByte(const unsigned u);
+    void putUnsigned(const unsigned u);
+    void putInt(const int i);
+    void putFloat(const float f);
+    void putBool(const bool b);
+    void putHolding(const unsigned h);
+    void putString(const string& st);
+
+    void finish(string& text) const;
+
+    void takeBody(string& text);
+
+    const vector<string const *>& table() const;
+};
+
+
+class BDBReader
+{
+  private:
+
+    const char * pos;
+    const char * end;
+    vector<string> strings;
+    vector<string const *> const * sharedStrings;
+
+    void check(const size_t n) const;
+
+
+  public:
+
+    BDBReader();
+
+    ~BDBReader();
+
+    void reset();
+
+    void set(
+      const char * data,
+      const size_t len);
+
+    void setBody(
+      const char * data,
+      const size_t len,
+      const vector<string const *>& table);
+
+    unsigned getByte();
+    unsigned getUnsigned();
+    int getInt();
+    float getFloat();
+    bool getBool();
+    unsigned getHolding();
+    const string& getString();
+
+    bool done() const;
+};
+
+#endif
+
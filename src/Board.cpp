@@ -8,14 +8,15 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 #include <regex>
 
 #include "bconst.h"
 #include "Board.h"
+#include "append.h"
 #include "Valuation.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -220,6 +221,12 @@ Player Board::holdsCard(const string& text) const
 }
 
 
+void Board::getDealDDS(unsigned cards[][BRIDGE_SUITS]) const
+{
+  deal.getDDS(cards);
+}
+
+
 void Board::setScoreIMP(
   const string& text,
   const Format format)
@@ -308,6 +315,20 @@ bool Board::overlappingPlayers() const
 }
 
 
+bool Board::samePlayers(const Board& board2) const
+{
+  if (len != board2.len)
+    return false;
+
+  for (unsigned i = 0; i < len; i++)
+  {
+    if (! instances[i].samePlayers(board2.instances[i]))
+      return false;
+  }
+  return true;
+}
+
+
 void Board::performValuation(const bool fullFlag)
 {
   unsigned cards[BRIDGE_PLAYERS][BRIDGE_SUITS];
@@ -321,6 +342,57 @@ void Board::performValuation(const bool fullFlag)
 }
 
 
+void Board::writeBDB(BDBWriter& bw) const
+{
+  // Valuations are derived on demand and are not stored.
+  deal.writeBDB(bw);
+  tableau.writeBDB(bw);
+  givenScore.writeBDB(bw);
+
+  bw.putUnsigned(len);
+  for (unsigned i = 0; i < len; i++)
+  {
+    bw.putBool(skip[i]);
+    instances[i].writeBDB(bw);
+  }
+}
+
+
+void Board::readBDB(
+  BDBReader& br,
+  LINData const * lin)
+{
+  Board::reset();
+
+  deal.readBDB(br);
+  tableau.readBDB(br);
+  givenScore.readBDB(br);
+
+  len = br.getUnsigned();
+  instances.resize(len);
+  skip.resize(len);
+
+  for (unsigned i = 0; i < len; i++)
+  {
+    skip[i] = br.getBool();
+    instances[i].readBDB(br, 
+      (lin != nullptr && i < 2 ? &lin->data[i] : nullptr));
+  }
+}
+
+
+size_t Board::heapSize() const
+{
+  // The Valuations only point to static tables.
+  size_t n = instances.capacity() * sizeof(Instance) +
+    valuation.capacity() * sizeof(Valuation) +
+    skip.capacity() / 8;
+  for (auto &instance: instances)
+    n += instance.heapSize();
+  return n;
+}
+
+
 bool Board::operator == (const Board& board2) const
 {
   if (len != board2.len)
@@ -398,6 +470,23 @@ bool Board::operator <= (const Board& board2) const
 }
 
 
+void Board::appendDeal(
+  string& st,
+  const Format format) const
+{
+  deal.appendStr(st, instances[0].getDealer(), format);
+}
+
+
+void Board::appendDeal(
+  string& st,
+  const Player start,
+  const Format format) const
+{
+  deal.appendStr(st, start, format);
+}
+
+
 string Board::strDeal(const Format format) const
 {
   return deal.str(instances[0].getDealer(), format);
@@ -527,14 +616,14 @@ int Board::IMPScore(const unsigned instNo) const
 
 string Board::strIMPEntry(const int imps) const
 {
-  stringstream ss;
+  string st;
   if (imps == 0)
-    ss << "    --    --";
+    st = "    --    --";
   else if (imps > 0)
-    ss << setw(6) << right << imps;
+    appendInt(st, imps, 6);
   else
-    ss << setw(12) << right << -imps;
-  return ss.str() + "\n";
+    appendInt(st, -imps, 12);
+  return st + "\n";
 }
 
 
@@ -543,20 +632,21 @@ string Board::strIMPSheetLine(
   unsigned& imps1,
   unsigned& imps2) const
 {
-  stringstream ss;
-  ss << setw(4) << right << bno << "  " <<
-    instances[0].strResultEntry() <<
+  string st;
+  appendRight(st, bno, 4);
+  st += "  " +
+    instances[0].strResultEntry() +
     instances[1].strResultEntry();
 
   const int imps = (len < 2 ? 0 : Board::IMPScore(0));
-  ss << Board::strIMPEntry(imps);
+  st += Board::strIMPEntry(imps);
 
   if (imps >= 0)
     imps1 += static_cast<unsigned>(imps);
   else
     imps2 += static_cast<unsigned>(-imps);
 
-  return ss.str();
+  return st;
 }
 
 
@@ -591,3 +681,9 @@ int Board::hash12() const
   return (h ^ (h >> 5)) & 0xfff;
 }
 
+
+uint64_t Board::fingerprint() const
+{
+  return deal.fingerprint();
+}
+
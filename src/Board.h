@@ -19,19 +19,24 @@
 #include "Valuation.h"
 #include "GivenScore.h"
 #include "Instance.h"
+#include "Arena.h"
 
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Board
 {
   private:
 
     Deal deal;
     Tableau tableau;
-    vector<Valuation> valuation;
-    vector<Instance> instances;
-    vector<bool> skip;
+    ArenaVector<Valuation> valuation;
+    ArenaVector<Instance> instances;
+    ArenaVector<bool> skip;
     GivenScore givenScore;
 
     unsigned len;
@@ -43,6 +48,12 @@ class Board
 
     Board();
 
+    Board(const Board& board2) = default;
+    Board(Board&& board2) = default;
+
+    Board& operator = (const Board& board2) = default;
+    Board& operator = (Board&& board2) = default;
+
     ~Board();
 
     void reset();
@@ -75,6 +86,8 @@ class Board
 
     Player holdsCard(const string& text) const;
 
+    void getDealDDS(unsigned cards[][BRIDGE_SUITS]) const;
+
     void setScoreIMP(
       const string& text,
       const Format format);
@@ -114,12 +127,29 @@ class Board
 
     bool overlappingPlayers() const;
 
+    bool samePlayers(const Board& board2) const;
+
     void performValuation(const bool fullFlag = false);
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(
+      BDBReader& br,
+      LINData const * lin);
+
+    size_t heapSize() const;
+
     bool operator == (const Board& b2) const;
     bool operator != (const Board& b2) const;
     bool operator <= (const Board& b2) const;
 
+    void appendDeal(
+      string& st,
+      const Format format) const;
+    void appendDeal(
+      string& st,
+      const Player player,
+      const Format format) const;
+
     string strDeal(const Format format) const;
     string strDeal(
       const Player player,
@@ -166,6 +196,8 @@ class Board
 
     int hash8() const;
     int hash12() const;
+
+    uint64_t fingerprint() const;
 };
 
 #endif
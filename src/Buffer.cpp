@@ -11,14 +11,7 @@
 #include <fstream>
 #include <sstream>
 #include <regex>
-#include <stdio.h>
-#include <io.h>
-#include <fcntl.h>
-#include <cstdint>
-
-#if defined(__CYGWIN__)
-  #include <unistd.h>
-#endif
+#include <cstring>
 
 #include "RefLines.h"
 #include "Buffer.h"
@@ -28,6 +21,14 @@
 
 #define CHUNK_SIZE 1024
 
+// The two characters of a LIN label as a single number.
+#define LIN_CODE(a, b) \
+  ((static_cast<unsigned>(a) << 8) | static_cast<unsigned>(b))
+
+
+static bool isSkippedLIN(const unsigned code);
+
+
 
 Buffer::Buffer()
 {
@@ -43,12 +44,16 @@ Buffer::~Buffer()
 void Buffer::reset()
 {
   fileName = "";
+  mapping.close();
+  overlay.clear();
+  lines.clear();
   len = 0;
   lenOrig = 0;
   current = 0;
   format = BRIDGE_FORMAT_SIZE;
   posLIN = 0;
   posRBX = 0;
+  scanLIN.reset();
   lines.reserve(CHUNK_SIZE);
   embeddedBuf = nullptr;
   embeddedName = "";
@@ -63,201 +68,265 @@ void Buffer::rewind()
 }
 
 
-// http://stackoverflow.com/questions/17925051/
-//   fast-textfile-reading-in-c
-
 void Buffer::readBinaryFile(const string& fname)
 {
-  int fd = open(fname.c_str(), O_RDONLY);
-  if (fd == -1)
-    THROW("Could not open " + fname);
-
-  // Advise the kernel of our access pattern.
-  // FDADVICE_SEQUENTIAL
-  // posix_fadvise(fd, 0, 0, 1);  
-
-  const size_t BUFFER_SIZE = 64*1024;
-  char buf[BUFFER_SIZE + 1];
-  LineData lineData;
-  unsigned no = 0;
-  string leftover = "";
   lines.clear();
+  overlay.clear();
 
-  while (int bytes_read = ::read(fd, buf, BUFFER_SIZE))
+  if (! mapping.open(fname))
   {
-    if (bytes_read == -1)
-      THROW("Read failed");
+    // An empty file cannot be mapped, but it is not an error.
+    ifstream fin(fname.c_str());
+    if (! fin.is_open())
+      THROW("Could not open " + fname);
 
-    if (! bytes_read)
-      break;
-
-    char * prev = buf;
-    char * p = buf;
-    while ((p = static_cast<char *>(memchr(prev, '\n', 
-        static_cast<size_t>
-        (
-          (reinterpret_cast<long int>(buf) + 
-           static_cast<long int>(bytes_read)) -
-           reinterpret_cast<long int>(prev)
-        )
-        ))) != nullptr)
-      // static_cast<size_t>((buf + bytes_read) - prev))) != nullptr)
-    {
-      lineData.len = static_cast<unsigned>(p-prev);
-      lineData.line = leftover + 
-        chars2str(prev, lineData.len);
-      lineData.len += static_cast<unsigned>(leftover.size());
-      lineData.no = ++no;
-
-      lines.push_back(lineData);
-      prev = p+1;
-      leftover = "";
-    }
-    leftover = chars2str(prev, 
-      static_cast<unsigned>((buf + bytes_read) - prev));
+    len = 0;
+    lenOrig = 0;
+    return;
   }
 
-  if (leftover != "")
+  const char * p = mapping.begin();
+  const char * end = p + mapping.size();
+  LineRef lr;
+  lr.type = BRIDGE_BUFFER_GENERAL;
+  lr.labelPos = 0;
+  lr.labelLen = 0;
+  lr.valuePos = 0;
+  lr.valueLen = 0;
+  unsigned no = 0;
+
+  while (p < end)
   {
-    lineData.line = leftover;
-    lineData.len = leftover.size();
-    lineData.no = ++no;
-    lines.push_back(lineData);
+    const char * q = static_cast<const char *>(
+      memchr(p, '\n', static_cast<size_t>(end - p)));
+    if (q == nullptr)
+      q = end;
+
+    // The mapping is binary, so a CRLF line still ends on '\r'.
+    lr.text = p;
+    lr.len = static_cast<unsigned>(q - p);
+    if (q > p && q[-1] == '\r')
+      lr.len--;
+    lr.no = ++no;
+    lines.push_back(lr);
+    p = q+1;
   }
 
   len = static_cast<unsigned>(lines.size());
   lenOrig = len;
-  close(fd);
 }
 
 
-bool Buffer::isLIN(LineData& ld)
+void Buffer::setView(
+  LineRef& lr,
+  const string& text)
+{
+  lr.text = text.data();
+  lr.len = static_cast<unsigned>(text.length());
+  lr.labelPos = 0;
+  lr.labelLen = 0;
+  lr.valuePos = 0;
+  lr.valueLen = 0;
+}
+
+
+void Buffer::setOverlay(
+  LineRef& lr,
+  const string& text)
 {
-  if (ld.len < 3 || ld.line.substr(2, 1) != "|")
+  // A list never moves its elements, so the view stays valid.
+  overlay.push_back(text);
+  Buffer::setView(lr, overlay.back());
+}
+
+
+string Buffer::str(const LineRef& lr) const
+{
+  return string(lr.text, lr.len);
+}
+
+
+void Buffer::fill(
+  const LineRef& lr,
+  LineData& ld) const
+{
+  // assign() reuses the capacity that the caller's strings already have.
+  ld.line.assign(lr.text, lr.len);
+  ld.label.assign(lr.text + lr.labelPos, lr.labelLen);
+  ld.value.assign(lr.text + lr.valuePos, lr.valueLen);
+  ld.len = lr.len;
+  ld.no = lr.no;
+  ld.type = lr.type;
+}
+
+
+size_t Buffer::find(
+  const LineRef& lr,
+  const char c,
+  const size_t pos) const
+{
+  if (pos >= lr.len)
+    return string::npos;
+
+  const void * p = memchr(lr.text + pos, c, lr.len - pos);
+  if (p == nullptr)
+    return string::npos;
+  else
+    return static_cast<size_t>(static_cast<const char *>(p) - lr.text);
+}
+
+
+bool Buffer::matches(
+  const LineRef& lr,
+  const size_t pos,
+  const char lit[]) const
+{
+  const size_t l = strlen(lit);
+  return (pos + l <= lr.len && memcmp(lr.text + pos, lit, l) == 0);
+}
+
+
+bool Buffer::isLIN(LineRef& lr)
+{
+  if (lr.len < 3 || lr.text[2] != '|')
     return false;
 
-  ld.type = BRIDGE_BUFFER_STRUCTURED;
-  ld.label = ld.line.substr(0, 2);
-  ld.value = ld.line.substr(3);
+  lr.type = BRIDGE_BUFFER_STRUCTURED;
+  lr.labelPos = 0;
+  lr.labelLen = 2;
+  lr.valuePos = 3;
+  lr.valueLen = lr.len - 3;
   return true;
 }
 
 
-bool Buffer::isPBN(LineData& ld)
+bool Buffer::isPBN(LineRef& lr)
 {
-  if (ld.len < 4 || 
-      ld.line.at(0) != '[' ||
-      ld.line.at(ld.len-2) != '"' ||
-      ld.line.at(ld.len-1) != ']')
+  if (lr.len < 4 || 
+      lr.text[0] != '[' ||
+      lr.text[lr.len-2] != '"' ||
+      lr.text[lr.len-1] != ']')
     return false;
 
-  size_t pos = ld.line.find(" ", 1);
+  size_t pos = Buffer::find(lr, ' ', 1);
   if (pos == string::npos)
     return false;
 
-  ld.type = BRIDGE_BUFFER_STRUCTURED;
-  ld.label = ld.line.substr(1, pos-1);
+  lr.type = BRIDGE_BUFFER_STRUCTURED;
+  lr.labelPos = 1;
+  lr.labelLen = static_cast<unsigned>(pos)-1;
 
-  pos = ld.line.find("\"", pos);
-  if (pos == ld.len-2)
+  pos = Buffer::find(lr, '"', pos);
+  if (pos == lr.len-2)
     return false;
-  if (pos+3 >= ld.len)
-    ld.value = "";
+  if (pos+3 >= lr.len)
+  {
+    lr.valuePos = 0;
+    lr.valueLen = 0;
+  }
   else
-    ld.value = ld.line.substr(pos+1, ld.len-pos-3);
+  {
+    lr.valuePos = static_cast<unsigned>(pos)+1;
+    lr.valueLen = lr.len - static_cast<unsigned>(pos) - 3;
+  }
   return true;
 }
 
 
-bool Buffer::isRBN(LineData& ld)
+bool Buffer::isRBN(LineRef& lr)
 {
-  if (ld.len == 0)
+  if (lr.len == 0)
     return false;
-  else if (ld.line.at(0) == ' ')
+  else if (lr.text[0] == ' ')
     return false;
-  else if (ld.len >= 2 && ld.line.at(1) != ' ')
+  else if (lr.len >= 2 && lr.text[1] != ' ')
     return false;
 
-  ld.type = BRIDGE_BUFFER_STRUCTURED;
-  ld.label = ld.line.substr(0, 1);
+  if (lr.len == 1)
+    Buffer::setOverlay(lr, Buffer::str(lr) + " ");
 
-  if (ld.len > 2)
-    ld.value = ld.line.substr(2);
+  lr.type = BRIDGE_BUFFER_STRUCTURED;
+  lr.labelPos = 0;
+  lr.labelLen = 1;
+
+  if (lr.len > 2)
+  {
+    lr.valuePos = 2;
+    lr.valueLen = lr.len - 2;
+  }
   else
   {
-    ld.value = "";
-    if (ld.len == 1)
-    {
-      ld.line += " ";
-      ld.len = 2;
-    }
+    lr.valuePos = 0;
+    lr.valueLen = 0;
   }
   return true;
 }
 
 
-bool Buffer::isRBX(LineData& ld)
+bool Buffer::isRBX(LineRef& lr)
 {
-  if (ld.len <= 3 || ld.line.at(1) != '{' || ld.line.at(ld.len-1) != '}')
+  if (lr.len <= 3 || lr.text[1] != '{' || lr.text[lr.len-1] != '}')
     return false;
 
-  ld.type = BRIDGE_BUFFER_STRUCTURED;
-  ld.label = ld.line.substr(1, 1);
-  ld.value = ld.line.substr(1, ld.len-2);
+  lr.type = BRIDGE_BUFFER_STRUCTURED;
+  lr.labelPos = 1;
+  lr.labelLen = 1;
+  lr.valuePos = 1;
+  lr.valueLen = lr.len - 2;
   return true;
 }
 
 
-void Buffer::classify(LineData& ld)
+void Buffer::classify(LineRef& lr)
 {
-  if (ld.len == 0)
+  if (lr.len == 0)
   {
-    ld.type = BRIDGE_BUFFER_EMPTY;
+    lr.type = BRIDGE_BUFFER_EMPTY;
     return;
   }
-  else if (ld.len == 1 &&
+  else if (lr.len == 1 &&
       (format == BRIDGE_FORMAT_PBN || format == BRIDGE_FORMAT_LIN_VG) &&
-      ld.line == " ")
+      lr.text[0] == ' ')
   {
     // Kludge for some versions of Double Dummy Captain.
-    ld.type = BRIDGE_BUFFER_EMPTY;
+    lr.type = BRIDGE_BUFFER_EMPTY;
     return;
   }
   else if ((format == BRIDGE_FORMAT_LIN || format == BRIDGE_FORMAT_LIN_TRN) &&
-      ld.len >= 17 && ld.len <= 23 &&
-      ld.line.substr(0, 3) == "qx|")
+      lr.len >= 17 && lr.len <= 23 &&
+      Buffer::matches(lr, 0, "qx|"))
   {
     // Kludge for some empty hands from actual own BBO play.
     //
-    if (ld.len >= 21 && ld.line.substr(ld.len-15) == "pn|,,,,,,,|pg||")
+    if (lr.len >= 21 && Buffer::matches(lr, lr.len-15, "pn|,,,,,,,|pg||"))
     {
-      ld.type = BRIDGE_BUFFER_EMPTY;
+      lr.type = BRIDGE_BUFFER_EMPTY;
       return;
     }
-    else if (ld.len <= 19 && ld.line.substr(ld.len-11) == "pn|,,,|pg||")
+    else if (lr.len <= 19 && Buffer::matches(lr, lr.len-11, "pn|,,,|pg||"))
     {
-      ld.type = BRIDGE_BUFFER_EMPTY;
+      lr.type = BRIDGE_BUFFER_EMPTY;
       return;
     }
   }
   else if (format == BRIDGE_FORMAT_TXT &&
-      ld.len > 5 &&
-      ld.line.substr(0, 5) == "-----")
+      lr.len > 5 &&
+      Buffer::matches(lr, 0, "-----"))
   {
-    ld.type = BRIDGE_BUFFER_DASHES;
+    lr.type = BRIDGE_BUFFER_DASHES;
     return;
   }
   else if (format ==  BRIDGE_FORMAT_EML &&
-      ld.len > 50 &&
-      (ld.line.substr(30, 5) == "-----" ||
-       ld.line.substr(30, 5) == "====="))
+      lr.len > 50 &&
+      (Buffer::matches(lr, 30, "-----") ||
+       Buffer::matches(lr, 30, "=====")))
   {
-    ld.type = BRIDGE_BUFFER_DASHES;
+    lr.type = BRIDGE_BUFFER_DASHES;
     return;
   }
-  else if (ld.line.at(0) == '%')
+  else if (lr.text[0] == '%')
   {
-    ld.type = BRIDGE_BUFFER_COMMENT;
+    lr.type = BRIDGE_BUFFER_COMMENT;
     return;
   }
 
@@ -267,30 +336,30 @@ void Buffer::classify(LineData& ld)
     case BRIDGE_FORMAT_LIN_RP:
     case BRIDGE_FORMAT_LIN_VG:
     case BRIDGE_FORMAT_LIN_TRN:
-      if (! Buffer::isLIN(ld))
-        ld.type = BRIDGE_BUFFER_GENERAL;
+      if (! Buffer::isLIN(lr))
+        lr.type = BRIDGE_BUFFER_GENERAL;
       break;
 
     case BRIDGE_FORMAT_PBN:
-      if (! Buffer::isPBN(ld))
-        ld.type = BRIDGE_BUFFER_GENERAL;
+      if (! Buffer::isPBN(lr))
+        lr.type = BRIDGE_BUFFER_GENERAL;
       break;
 
     case BRIDGE_FORMAT_RBN:
-      if (! Buffer::isRBN(ld))
-        ld.type = BRIDGE_BUFFER_GENERAL;
+      if (! Buffer::isRBN(lr))
+        lr.type = BRIDGE_BUFFER_GENERAL;
       break;
 
     case BRIDGE_FORMAT_RBX:
-      if (! Buffer::isRBX(ld) &&
-          ! Buffer::isRBN(ld))
-        ld.type = BRIDGE_BUFFER_GENERAL;
+      if (! Buffer::isRBX(lr) &&
+          ! Buffer::isRBN(lr))
+        lr.type = BRIDGE_BUFFER_GENERAL;
       break;
 
     case BRIDGE_FORMAT_TXT:
     case BRIDGE_FORMAT_EML:
     case BRIDGE_FORMAT_REC:
-      ld.type = BRIDGE_BUFFER_GENERAL;
+      lr.type = BRIDGE_BUFFER_GENERAL;
       break;
 
     default:
@@ -315,8 +384,8 @@ bool Buffer::read(
   if (len == 0)
     return false;
 
-  for (auto &ld: lines)
-    Buffer::classify(ld);
+  for (auto &lr: lines)
+    Buffer::classify(lr);
 
   return Buffer::fix(refLines);
 }
@@ -333,8 +402,8 @@ void Buffer::readForce(
   if (len == 0)
     return;
 
-  for (auto &ld: lines)
-    Buffer::classify(ld);
+  for (auto &lr: lines)
+    Buffer::classify(lr);
 }
 
 
@@ -344,23 +413,110 @@ unsigned Buffer::lengthOrig() const
 }
 
 
+void Buffer::view(
+  const Buffer& buffer2,
+  const unsigned start)
+{
+  Buffer::reset();
+  fileName = buffer2.fileName;
+  lines = buffer2.lines;
+  len = buffer2.len;
+  lenOrig = buffer2.lenOrig;
+  format = buffer2.format;
+  current = start;
+}
+
+
+bool Buffer::startsBoard(const unsigned i) const
+{
+  if (i == 0 || i >= len)
+    return false;
+
+  switch(format)
+  {
+    case BRIDGE_FORMAT_PBN:
+    case BRIDGE_FORMAT_RBN:
+      return (lines[i-1].type == BRIDGE_BUFFER_EMPTY &&
+        lines[i].type != BRIDGE_BUFFER_EMPTY);
+
+    case BRIDGE_FORMAT_TXT:
+      return (lines[i-1].type == BRIDGE_BUFFER_DASHES);
+
+    default:
+      return false;
+  }
+}
+
+
+void Buffer::boardStarts(
+  const unsigned num,
+  const unsigned minLines,
+  vector<unsigned>& starts) const
+{
+  // Splits the remaining lines into at most num pieces of roughly
+  // minLines or more.  A piece starts after an empty line in PBN
+  // and RBN and after the dashes that end a hand in TXT, which is
+  // where a board usually starts.  The caller has to check this.
+  starts.clear();
+  starts.push_back(current);
+
+  const unsigned rest = (len > current ? len - current : 0);
+  unsigned pieces = (minLines == 0 ? num : rest / minLines);
+  if (pieces > num)
+    pieces = num;
+
+  for (unsigned k = 1; k < pieces; k++)
+  {
+    unsigned i = current +
+      static_cast<unsigned>((static_cast<size_t>(rest) * k) / pieces);
+    if (i <= starts.back())
+      i = starts.back() + 1;
+
+    while (i < len && ! Buffer::startsBoard(i))
+      i++;
+
+    if (i >= len)
+      break;
+    starts.push_back(i);
+  }
+}
+
+
+unsigned Buffer::position() const
+{
+  return current;
+}
+
+
 bool Buffer::split(
   const string& st,
   const Format formatIn)
 {
   format = formatIn;
-  LineData lineData;
-  size_t l = st.size();
-  size_t p = 0;
+  lines.clear();
   len = 0;
+  scanLIN.reset();
+
+  // Keep a single copy of the string and make views into it.
+  overlay.push_back(st);
+  const string& text = overlay.back();
+  LineRef lr;
+  lr.type = BRIDGE_BUFFER_GENERAL;
+  size_t l = text.size();
+  size_t p = 0;
 
   while (p < l)
   {
-    size_t found = st.find("\n", p);
-    lineData.line = st.substr(p, found-p);
-    lineData.len = static_cast<unsigned>(lineData.line.length());
-    lineData.no = ++len;
-    lines.push_back(lineData);
+    size_t found = text.find("\n", p);
+    const size_t e = (found == string::npos ? l : found);
+    lr.text = text.data() + p;
+    lr.len = static_cast<unsigned>(e - p);
+    lr.labelPos = 0;
+    lr.labelLen = 0;
+    lr.valuePos = 0;
+    lr.valueLen = 0;
+    lr.no = ++len;
+    lines.push_back(lr);
     if (found == string::npos)
       break;
 
@@ -370,8 +526,8 @@ bool Buffer::split(
   if (len == 0)
     return false;
 
-  for (auto &ld: lines)
-    Buffer::classify(ld);
+  for (auto &lr2: lines)
+    Buffer::classify(lr2);
   return true;
 }
 
@@ -411,7 +567,7 @@ void Buffer::cacheEmbedded(const string& embeddedNameIn)
 
 void Buffer::getEmbeddedData(
   const RefLine& rl, 
-  list<LineData>& lnew)
+  list<LineRef>& lnew)
 {
   const unsigned estart = rl.linenoEmbed();
   const unsigned ecount = rl.rangeEmbedCount();
@@ -419,11 +575,12 @@ void Buffer::getEmbeddedData(
 
   for (unsigned j = estart; j < estart+ecount-1; j++)
   {
+    // The embedded buffer goes away, so the line is copied.
     const string st = embeddedBuf->getLine(j);
     tmplines.push_back(st);
-    lnew.emplace_back(LineData());
-    LineData& active = lnew.back();
-    active.len = static_cast<unsigned>(st.length());
+    lnew.emplace_back(LineRef());
+    LineRef& active = lnew.back();
+    Buffer::setOverlay(active, st);
     active.no = rl.lineno(); // All the same
     Buffer::classify(active);
   }
@@ -439,15 +596,15 @@ bool Buffer::fix(const RefLines& refLines)
     const unsigned i = Buffer::getInternalNumber(rl.lineno());
     if (i == BIGNUM)
       THROW("Cannot find ref line number " + STR(rl.lineno()));
-    LineData& ld = lines[i];
 
     const ActionCategory refType = rl.type();
     if (refType == ACTION_INSERT_LINE)
     {
       // Normal insert.
-      LineData lnew;
-      rl.modify(lnew.line);
-      lnew.len = static_cast<unsigned>(lnew.line.length());
+      string st = "";
+      rl.modify(st);
+      LineRef lnew;
+      Buffer::setOverlay(lnew, st);
       lnew.no = rl.lineno();
       Buffer::classify(lnew);
       lines.insert(lines.begin() + static_cast<int>(i), lnew);
@@ -458,7 +615,7 @@ bool Buffer::fix(const RefLines& refLines)
       // Insert from embedded reference.
       Buffer::cacheEmbedded(rl.embeddedRef());
 
-      list<LineData> lnew;
+      list<LineRef> lnew;
       Buffer::getEmbeddedData(rl, lnew);
       
       lines.insert(lines.begin() + static_cast<int>(i),
@@ -470,7 +627,7 @@ bool Buffer::fix(const RefLines& refLines)
       // Insert from embedded reference.
       Buffer::cacheEmbedded(rl.embeddedRef());
 
-      list<LineData> lnew;
+      list<LineRef> lnew;
       Buffer::getEmbeddedData(rl, lnew);
       
       // We could reuse the space -- this is the simple way.
@@ -495,7 +652,7 @@ bool Buffer::fix(const RefLines& refLines)
       // For completeness, even though deleted
       vector<string> tmplines;
       for (unsigned j = i; j < i+deletion; j++)
-        tmplines.push_back(lines[j].line);
+        tmplines.push_back(Buffer::str(lines[j]));
 
       rl.modify(tmplines);
 
@@ -505,8 +662,7 @@ bool Buffer::fix(const RefLines& refLines)
 
         for (unsigned j = i, k = 0; j < i+deletion; j++, k++)
         {
-          lines[j].line = tmplines[k];
-          lines[j].len = static_cast<unsigned>(tmplines[k].length());
+          Buffer::setOverlay(lines[j], tmplines[k]);
           Buffer::classify(lines[j]);
         }
       }
@@ -519,9 +675,11 @@ bool Buffer::fix(const RefLines& refLines)
     }
     else if (refType == ACTION_GENERAL)
     {
-      rl.modify(ld.line);
-      ld.len = static_cast<unsigned>(ld.line.length());
-      Buffer::classify(ld);
+      LineRef& lr = lines[i];
+      string st = Buffer::str(lr);
+      rl.modify(st);
+      Buffer::setOverlay(lr, st);
+      Buffer::classify(lr);
     }
     else 
       THROW("Bad reference line type");
@@ -557,20 +715,33 @@ void Buffer::advanceLINPast(const size_t pos)
 }
 
 
+size_t Buffer::findLIN(
+  const LineRef& lr,
+  const size_t pos)
+{
+  // The pipes of a line are found in one go the first time we
+  // look in it.
+  if (! scanLIN.covers(lr.text, lr.len))
+    scanLIN.set(lr.text, lr.len);
+  return scanLIN.find(pos);
+}
+
+
 bool Buffer::extendLINValue(LineData& vside)
 {
   bool endFlag = false;
   while (current < len-1)
   {
     current++;
-    size_t e = lines[current].line.find('|');
+    const LineRef& lr = lines[current];
+    size_t e = Buffer::findLIN(lr, 0);
     if (e == string::npos)
-      vside.value += lines[current].line;
+      vside.value.append(lr.text, lr.len);
     else
     {
       endFlag = true;
       if (e > 0)
-        vside.value += lines[current].line.substr(0, e);
+        vside.value.append(lr.text, e);
       Buffer::advanceLINPast(e);
       break;
     }
@@ -591,7 +762,7 @@ bool Buffer::nextLIN(
   if (current > len-1)
     return false;
 
-  size_t e = lines[current].line.find('|', posLIN);
+  size_t e = Buffer::findLIN(lines[current], posLIN);
   if (e == string::npos &&
       current == len-1 && 
       (vside.label == "pg" ||
@@ -602,13 +773,14 @@ bool Buffer::nextLIN(
 
   if (e != posLIN+2 || e == string::npos)
   {
-    THROW("Bad LIN line: " + lines[current].line + 
-      ", remainder: " + lines[current].line.substr(posLIN) + 
+    const string st = Buffer::str(lines[current]);
+    THROW("Bad LIN line: " + st + 
+      ", remainder: " + st.substr(posLIN) + 
       ", line " + STR(current+1) + ", posLIN " + 
       STR(posLIN) + ", e " + STR(e));
   }
 
-  vside.label = lines[current].line.substr(posLIN, 2);
+  vside.label.assign(lines[current].text + posLIN, 2);
   vside.no = lines[current].no;
 
   posLIN += 3;
@@ -616,7 +788,7 @@ bool Buffer::nextLIN(
   {
     if (current == len-1)
     {
-      THROW("Bad LIN line: " + lines[current].line + 
+      THROW("Bad LIN line: " + Buffer::str(lines[current]) + 
         ", " + STR(current));
     }
     else
@@ -627,29 +799,29 @@ bool Buffer::nextLIN(
     }
   }
 
-  e = lines[current].line.find('|', posLIN);
+  const LineRef& lr = lines[current];
+  e = Buffer::findLIN(lr, posLIN);
   if (e == posLIN)
   {
-    vside.value = "";
+    vside.value.clear();
     Buffer::advanceLINPast(e);
   }
   else if (e == string::npos)
   {
     // Could be an unterminated tag.
-    vside.value = lines[current].line.substr(posLIN);
+    vside.value.assign(lr.text + posLIN, lr.len - posLIN);
     if (! Buffer::extendLINValue(vside))
-      THROW("Bad LIN line: " + lines[current].line + 
+      THROW("Bad LIN line: " + Buffer::str(lines[current]) + 
         ", " + STR(current));
   }
   else
   {
     if (vside.label == "nt")
     {
-      while (e+3 < lines[current].len &&
-          lines[current].line.at(e+3) != '|')
+      while (e+3 < lr.len && lr.text[e+3] != '|')
       {
         // Attempt to complete the comment.
-        e = lines[current].line.find('|', e+1);
+        e = Buffer::findLIN(lr, e+1);
         if (e == string::npos)
           break;
       }
@@ -657,82 +829,111 @@ bool Buffer::nextLIN(
 
     if (e == string::npos)
     {
-      vside.value = lines[current].line.substr(posLIN);
+      vside.value.assign(lr.text + posLIN, lr.len - posLIN);
       if (! Buffer::extendLINValue(vside))
-        THROW("Bad LIN line: " + lines[current].line + 
+        THROW("Bad LIN line: " + Buffer::str(lines[current]) + 
           ", " + STR(current));
     }
     else
     {
-      vside.value = lines[current].line.substr(posLIN, e-posLIN);
+      vside.value.assign(lr.text + posLIN, e - posLIN);
       Buffer::advanceLINPast(e);
     }
   }
 
   vside.type = BRIDGE_BUFFER_STRUCTURED;
-  vside.line = vside.label + "|" + vside.value + "|";
+  vside.line.assign(vside.label);
+  vside.line += '|';
+  vside.line += vside.value;
+  vside.line += '|';
   vside.len = 4 + static_cast<unsigned>(vside.value.length());
 
   // Skip over various labels. 
-  if ((skipChat && vside.label == "nt") || // Chat
-      vside.label == "pg" || // "Page"
-      vside.label == "ob" || // Bidding in other room
-      vside.label == "sa" || // ?
-      vside.label == "mn" || // An older header term
-      vside.label == "em" || // ?
-      vside.label == "at" || // ?
-      vside.label == "bt" || // ?
-      vside.label == "ht" || // ?
-      vside.label == "it" || // ?
-      vside.label == "pa" || // ?
-      vside.label == "tu" || // ?
-      vside.label == "pf" || // ?
-      (vside.label == "mb" && vside.value == "-"))
+  const unsigned code = LIN_CODE(vside.label[0], vside.label[1]);
+  if ((skipChat && code == LIN_CODE('n', 't')) || // Chat
+      isSkippedLIN(code) ||
+      (code == LIN_CODE('m', 'b') && vside.value == "-"))
     return Buffer::nextLIN(vside, skipChat);
   else
     return true;
 }
 
 
+static bool isSkippedLIN(const unsigned code)
+{
+  switch (code)
+  {
+    case LIN_CODE('p', 'g'): // "Page"
+    case LIN_CODE('o', 'b'): // Bidding in other room
+    case LIN_CODE('s', 'a'): // ?
+    case LIN_CODE('m', 'n'): // An older header term
+    case LIN_CODE('e', 'm'): // ?
+    case LIN_CODE('a', 't'): // ?
+    case LIN_CODE('b', 't'): // ?
+    case LIN_CODE('h', 't'): // ?
+    case LIN_CODE('i', 't'): // ?
+    case LIN_CODE('p', 'a'): // ?
+    case LIN_CODE('t', 'u'): // ?
+    case LIN_CODE('p', 'f'): // ?
+      return true;
+    default:
+      return false;
+  }
+}
+
+
 void Buffer::nextRBX(LineData& vside)
 {
   // Turn RBX into RBN.
 
-  if (posRBX >= lines[current].len)
+  const LineRef& lr = lines[current];
+  if (posRBX >= lr.len)
   {
     // Make an empty line.
-    vside.line = "";
+    vside.line.clear();
     vside.len = 0;
     vside.type = BRIDGE_BUFFER_EMPTY;
-    vside.label = "";
-    vside.value = "";
-    vside.no = lines[current].no;
+    vside.label.clear();
+    vside.value.clear();
+    vside.no = lr.no;
     current++;
     posRBX = 0;
     return;
   }
 
-  size_t e = lines[current].line.find('}', posRBX);
+  size_t e = Buffer::find(lr, '}', posRBX);
   if (e <= posRBX+1 || e == string::npos)
     THROW("Bad RBX line");
 
-  vside.label = lines[current].line.substr(posRBX, 1);
-  vside.no = lines[current].no;
+  vside.label.assign(lr.text + posRBX, 1);
+  vside.no = lr.no;
 
   if (e == posRBX+2)
   {
     vside.len = 2;
-    vside.line = vside.label + " ";
-    vside.value = "";
+    vside.value.clear();
   }
   else
   {
     vside.len = static_cast<unsigned>(e)-posRBX;
-    vside.value = lines[current].line.substr(posRBX+2, vside.len-2);
-    vside.line = vside.label + " " + vside.value;
+    vside.value.assign(lr.text + posRBX + 2, vside.len-2);
+  }
+
+  vside.line.assign(vside.label);
+  vside.line += ' ';
+  vside.line += vside.value;
+
+  LineRef tmp;
+  Buffer::setView(tmp, vside.line);
+  tmp.no = vside.no;
+  Buffer::classify(tmp);
+  vside.type = tmp.type;
+  if (tmp.type == BRIDGE_BUFFER_STRUCTURED)
+  {
+    vside.label = string(tmp.text + tmp.labelPos, tmp.labelLen);
+    vside.value = string(tmp.text + tmp.valuePos, tmp.valueLen);
   }
 
-  Buffer::classify(vside);
   posRBX = static_cast<unsigned>(e)+1;
 }
 
@@ -758,7 +959,7 @@ bool Buffer::next(
   }
   else
   {
-    vside = lines[current];
+    Buffer::fill(lines[current], vside);
     current++;
     return true;
   }
@@ -770,7 +971,7 @@ bool Buffer::previous(LineData& vside)
   if (current <= 1)
     return false;
 
-  vside = lines[current-2];
+  Buffer::fill(lines[current-2], vside);
   return true;
 }
 
@@ -792,9 +993,11 @@ unsigned Buffer::firstRS() const
 
   for (unsigned i = 0; i < len; i++)
   {
-    if (lines[i].type == BRIDGE_BUFFER_STRUCTURED &&
-        lines[i].label == "rs")
-      return lines[i].no;
+    const LineRef& lr = lines[i];
+    if (lr.type == BRIDGE_BUFFER_STRUCTURED &&
+        lr.labelLen == 2 &&
+        Buffer::matches(lr, lr.labelPos, "rs"))
+      return lr.no;
   }
 
   return BIGNUM;
@@ -845,7 +1048,7 @@ string Buffer::getLine(const unsigned no) const
   if (intNo == BIGNUM)
     return "";
   else
-    return lines[intNo].line;
+    return Buffer::str(lines[intNo]);
 }
 
 
@@ -878,7 +1081,7 @@ int Buffer::peek()
   else if (lines[current].len == 0)
     return 0x01; // Whatever
   else 
-    return static_cast<int>(lines[current].line.at(0));
+    return static_cast<int>(lines[current].text[0]);
 }
 
 
@@ -888,21 +1091,22 @@ void Buffer::print() const
     setw(6) << "Type" << setw(4) << "Len" << left << " " <<
     setw(12) << "Label" << "Value" << endl;
 
-  for (auto &ld: lines)
+  for (auto &lr: lines)
   {
-    if (ld.type == BRIDGE_BUFFER_STRUCTURED)
+    if (lr.type == BRIDGE_BUFFER_STRUCTURED)
     {
-      cout << setw(4) << right << ld.no <<
-        setw(6) << static_cast<unsigned>(ld.type) << 
-        setw(4) << ld.len << left << " " <<
-        setw(12) << ld.label << ld.value << endl;
+      cout << setw(4) << right << lr.no <<
+        setw(6) << static_cast<unsigned>(lr.type) << 
+        setw(4) << lr.len << left << " " <<
+        setw(12) << string(lr.text + lr.labelPos, lr.labelLen) << 
+        string(lr.text + lr.valuePos, lr.valueLen) << endl;
     }
     else
     {
-      cout << setw(4) << right << ld.no <<
-        setw(6) << static_cast<unsigned>(ld.type) << 
-        setw(4) << ld.len << left << " " <<
-        setw(12) << "" << ld.line << endl;
+      cout << setw(4) << right << lr.no <<
+        setw(6) << static_cast<unsigned>(lr.type) << 
+        setw(4) << lr.len << left << " " <<
+        setw(12) << "" << Buffer::str(lr) << endl;
     }
   }
 }
@@ -14,6 +14,8 @@
 #include <vector>
 #include <list>
 
+#include "MappedFile.h"
+#include "LINScan.h"
 #include "bconst.h"
 
 class RefLines;
@@ -26,14 +28,34 @@ class Buffer
 {
   private:
 
+    // The lines are views into the mapped file.  Lines that are 
+    // edited or inserted by a ref file, or that come from a string,
+    // are views into the overlay instead.  The label and value are
+    // positions within the line.
+
+    struct LineRef
+    {
+      const char * text;
+      unsigned len;
+      unsigned no;
+      LineType type;
+      unsigned labelPos;
+      unsigned labelLen;
+      unsigned valuePos;
+      unsigned valueLen;
+    };
+
     string fileName;
-    vector<LineData> lines;
+    MappedFile mapping;
+    list<string> overlay;
+    vector<LineRef> lines;
     unsigned len;
     unsigned lenOrig;
     unsigned current;
     Format format;
     unsigned posLIN;
     unsigned posRBX;
+    LINScanner scanLIN;
 
     Buffer * embeddedBuf;
     string embeddedName;
@@ -41,23 +63,53 @@ class Buffer
 
     void readBinaryFile(const string& fname);
 
-    bool isLIN(LineData& ld);
-    bool isPBN(LineData& ld);
-    bool isRBN(LineData& ld);
-    bool isRBX(LineData& ld);
+    void setView(
+      LineRef& lr,
+      const string& text);
+
+    void setOverlay(
+      LineRef& lr,
+      const string& text);
+
+    string str(const LineRef& lr) const;
+
+    void fill(
+      const LineRef& lr,
+      LineData& ld) const;
+
+    size_t find(
+      const LineRef& lr,
+      const char c,
+      const size_t pos) const;
+
+    bool matches(
+      const LineRef& lr,
+      const size_t pos,
+      const char lit[]) const;
+
+    bool isLIN(LineRef& lr);
+    bool isPBN(LineRef& lr);
+    bool isRBN(LineRef& lr);
+    bool isRBX(LineRef& lr);
 
     void cacheEmbedded(const string& embeddedNameIn);
 
     void getEmbeddedData(
       const RefLine& rl,
-      list<LineData>& lnew);
+      list<LineRef>& lnew);
 
     bool fix(const RefLines& refLines);
 
-    void classify(LineData& ld);
+    void classify(LineRef& lr);
 
     unsigned getInternalNumber(const unsigned no) const;
 
+    bool startsBoard(const unsigned i) const;
+
+    size_t findLIN(
+      const LineRef& lr,
+      const size_t pos);
+
     bool extendLINValue(LineData& vside);
     void advanceLINPast(size_t pos);
     bool nextLIN(
@@ -72,6 +124,9 @@ class Buffer
 
     ~Buffer();
 
+    Buffer(const Buffer&) = delete;
+    Buffer& operator = (const Buffer&) = delete;
+
     void reset();
 
     void rewind();
@@ -95,6 +150,19 @@ class Buffer
       const string& fname,
       RefLines& refLines);
 
+    // A view shares the text of buffer2, which must outlive it, and
+    // reads from line index start onwards.
+    void view(
+      const Buffer& buffer2,
+      const unsigned start);
+
+    void boardStarts(
+      const unsigned num,
+      const unsigned minLines,
+      vector<unsigned>& starts) const;
+
+    unsigned position() const;
+
     bool advance();
 
     bool next(
@@ -87,6 +87,7 @@ void Chunk::reset()
     chunk[i].reserve(128);
     chunk[i] = "";
     lineno[i] = BIGNUM;
+    events[i].clear();
   }
 }
 
@@ -107,27 +108,28 @@ void Chunk::reset(const ChunkRange range)
   {
     chunk[i] = "";
     lineno[i] = BIGNUM;
+    events[i].clear();
   }
 }  
 
 
 bool Chunk::isSet(const Label label) const
 {
-  return (chunk[label] != "");
+  return (chunk[label] != "" || ! events[label].empty());
 }
 
 
 bool Chunk::isEmpty(const Label label) const
 {
-  return (chunk[label] == "");
+  return (chunk[label] == "" && events[label].empty());
 }
 
 
 bool Chunk::seemsEmpty() const
 {
-  return (chunk[BRIDGE_FORMAT_BOARD_NO] == "" &&
-      chunk[BRIDGE_FORMAT_RESULT] == "" &&
-      chunk[BRIDGE_FORMAT_AUCTION] == "");
+  return (Chunk::isEmpty(BRIDGE_FORMAT_BOARD_NO) &&
+      Chunk::isEmpty(BRIDGE_FORMAT_RESULT) &&
+      Chunk::isEmpty(BRIDGE_FORMAT_AUCTION));
 }
 
 
@@ -149,6 +151,32 @@ void Chunk::append(
 }
 
 
+void Chunk::addEvent(
+  const Label label,
+  const ChunkEventType type,
+  const string& text)
+{
+  events[label].push_back({type, text, ""});
+}
+
+
+void Chunk::addAlert(
+  const Label label,
+  const string& alert)
+{
+  // The alert belongs to the latest call.
+  for (auto it = events[label].rbegin(); it != events[label].rend(); it++)
+  {
+    if (it->type == CHUNK_EVENT_CALL)
+    {
+      it->alert = alert;
+      return;
+    }
+  }
+  THROW("Alerting before any bid");
+}
+
+
 string Chunk::get(const Label label) const
 {
   return chunk[label];
@@ -163,6 +191,12 @@ string Chunk::get(const unsigned label) const
 }
 
 
+const vector<ChunkEvent>& Chunk::getEvents(const Label label) const
+{
+  return events[label];
+}
+
+
 void Chunk::getCounts(
   const Format format,
   Counts& counts) const
@@ -269,6 +303,7 @@ void Chunk::copyFrom(
 {
   chunk[label] = chunk2.chunk[label];
   lineno[label] = chunk2.lineno[label];
+  events[label] = chunk2.events[label];
 }
 
 
@@ -349,11 +384,32 @@ bool Chunk::differsFrom(
 }
 
 
+string Chunk::strEvents(const Label label) const
+{
+  string st;
+  for (auto &event: events[label])
+  {
+    if (st != "")
+      st += " ";
+
+    if (event.type == CHUNK_EVENT_PASSES)
+      st += "AP";
+    else
+      st += event.text;
+
+    if (event.alert != "")
+      st += "(" + event.alert + ")";
+  }
+  return st;
+}
+
+
 string Chunk::str(const Label label) const
 {
   stringstream ss;
   ss << "label " << LABEL_NAMES[label] << " (" << label << "), '" <<
-    chunk[label] << "'" << endl << endl;
+    (chunk[label] != "" ? chunk[label] : Chunk::strEvents(label)) <<
+    "'" << endl << endl;
   return ss.str();
 }
 
@@ -364,11 +420,14 @@ string Chunk::str() const
   ss << endl;
   for (unsigned i = 0; i < BRIDGE_FORMAT_LABELS_SIZE; i++)
   {
-    if (chunk[i] != "")
+    const Label label = static_cast<Label>(i);
+    const string st = (chunk[i] != "" ? chunk[i] :
+      Chunk::strEvents(label));
+    if (st != "")
     {
       ss << setw(15) << LABEL_NAMES[i] <<
           " (" << setw(2) << i << "), '" <<
-          chunk[i] << "'" << endl;
+          st << "'" << endl;
     }
   }
   return ss.str();
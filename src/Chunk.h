@@ -11,6 +11,7 @@
 #define BRIDGE_CHUNK_H
 
 #include <string>
+#include <vector>
 
 #include "bconst.h"
 
@@ -27,6 +28,25 @@ enum ChunkRange
   CHUNK_PBN_SOFTLY = 6
 };
 
+// Some readers (LIN) do not turn the auction and the play back into
+// text, but store the calls and cards as they find them.  These are
+// then passed on to the Instance one by one.
+
+enum ChunkEventType
+{
+  CHUNK_EVENT_CALL = 0, // A call, with an optional alert
+  CHUNK_EVENT_PASSES = 1, // All remaining passes
+  CHUNK_EVENT_CARD = 2, // A single card such as "SA"
+  CHUNK_EVENT_TRICK = 3 // Several cards of a trick in one string
+};
+
+struct ChunkEvent
+{
+  ChunkEventType type;
+  string text;
+  string alert;
+};
+
 
 class Chunk
 {
@@ -34,6 +54,9 @@ class Chunk
 
     string chunk[BRIDGE_FORMAT_LABELS_SIZE];
     unsigned lineno[BRIDGE_FORMAT_LABELS_SIZE];
+    vector<ChunkEvent> events[BRIDGE_FORMAT_LABELS_SIZE];
+
+    string strEvents(const Label label) const;
 
 
   public:
@@ -59,9 +82,20 @@ class Chunk
       const Label label,
       const string& value);
 
+    void addEvent(
+      const Label label,
+      const ChunkEventType type,
+      const string& text = "");
+
+    void addAlert(
+      const Label label,
+      const string& alert);
+
     string get(const Label label) const;
     string get(const unsigned label) const;
 
+    const vector<ChunkEvent>& getEvents(const Label label) const;
+
     void getCounts(
       const Format format,
       Counts& counts) const;
@@ -57,6 +57,30 @@ void CompStats::operator += (const CompStats& statsIn)
 }
 
 
+void CompStats::serialize(ostream& fout) const
+{
+  for (unsigned f = 0; f < BRIDGE_FORMAT_SIZE; f++)
+  {
+    writeField(fout, stats[f].count);
+    writeField(fout, stats[f].errors);
+  }
+}
+
+
+void CompStats::deserialize(istream& fin)
+{
+  // Adds to the stats, like +=.
+  unsigned c, e;
+  for (unsigned f = 0; f < BRIDGE_FORMAT_SIZE; f++)
+  {
+    readField(fin, c);
+    readField(fin, e);
+    stats[f].count += c;
+    stats[f].errors += e;
+  }
+}
+
+
 void CompStats::print(ostream& fstr) const
 {
   fstr << setw(8) << left << "format" << 
@@ -43,6 +43,10 @@ class CompStats
       const Format format);
 
     void operator += (const CompStats& statsIn);
+
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
       
     void print(ostream& fstr) const;
 };
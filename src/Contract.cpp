@@ -8,24 +8,16 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 #include <map>
 
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.thread.h"
-  #include "mingw.mutex.h"
-#else
-  #include <thread>
-  #include <mutex>
-#endif
-
 #include "Contract.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
-
-static mutex mtx;
+#include "ctable.h"
 
 
 static const bool VUL_LOOKUP[BRIDGE_VUL_SIZE][BRIDGE_PLAYER_SIZE] =
@@ -64,11 +56,6 @@ static const string DENOM_DDS_TO_PBN_TAG[BRIDGE_DENOMS] =
   "C", "D", "H", "S", "NT"
 };
 
-static const string DENOM_SUPERSET_TAG[6] =
-{
-  "C", "D", "H", "S", "N", "NT"
-};
-
 static const Denom DENOM_SUPERSET_NUM[6] =
 {
   BRIDGE_CLUBS, BRIDGE_DIAMONDS, BRIDGE_HEARTS, BRIDGE_SPADES,
@@ -141,7 +128,7 @@ static const int DENOM_TO_OVERTRICKS_UNDOUBLED[BRIDGE_DENOMS] =
   30, 30, 20, 20, 30 
 };
 
-static const unsigned IMPscale[26] =
+static constexpr unsigned IMPscale[26] =
 {
      0,   10,   40,   80,  120,  160,  210,  260,
    310,  360,  420,  490,  590,  740,  890, 1090,
@@ -149,9 +136,32 @@ static const unsigned IMPscale[26] =
   3990, 9990
 };
 
-static unsigned IMPlookup[501];
+// IMPlookup  1,  2,  3,  4,  5,  6,  7, ...
+// value      0,  0,  1,  1,  1,  2,  2, ...
+// score      0, 10, 20, 30, 40, 50, 60, ...
 
-static bool setContractTables = false;
+static constexpr unsigned IMPhit(
+  const unsigned score,
+  const unsigned hit)
+{
+  return (score > IMPscale[hit] ? IMPhit(score, hit+1) : hit);
+}
+
+static constexpr unsigned IMPvalue(const unsigned i)
+{
+  return (i == 0 ? 0 : IMPhit(10 * (i-1), 1) - 1); // 0 is unused
+}
+
+static constexpr unsigned IMPlookup[501] =
+{
+  CTABLE_256(IMPvalue, 0),
+  CTABLE_128(IMPvalue, 256),
+  CTABLE_64(IMPvalue, 384),
+  CTABLE_32(IMPvalue, 448),
+  CTABLE_16(IMPvalue, 480),
+  CTABLE_4(IMPvalue, 496),
+  CTABLE_1(IMPvalue, 500)
+};
 
 struct Entry
 {
@@ -159,20 +169,34 @@ struct Entry
   int tricksRelative;
 };
 
-static map<string, Entry> CONTRACT_STRING_TO_PARTS;
+// Contract strings are decoded directly from their characters.
+// "NT" is handled separately.  Both tables are fixed at compile time.
+
+static constexpr unsigned charToDenomSuperset(const unsigned c)
+{
+  return (c == 'C' ? 0 : c == 'D' ? 1 : c == 'H' ? 2 : c == 'S' ? 3 :
+    c == 'N' ? 4 : 6);
+}
+
+static constexpr unsigned charToDeclarer(const unsigned c)
+{
+  return (c == 'N' ? BRIDGE_NORTH : c == 'E' ? BRIDGE_EAST :
+    c == 'S' ? BRIDGE_SOUTH : c == 'W' ? BRIDGE_WEST : BRIDGE_PLAYERS);
+}
+
+static constexpr unsigned CHAR_TO_DENOM_SUPERSET[256] =
+  { CTABLE_256(charToDenomSuperset, 0) };
+static constexpr unsigned CHAR_TO_DECLARER[256] =
+  { CTABLE_256(charToDeclarer, 0) };
+
+static bool stringToEntry(
+  const string& text,
+  Entry& e);
 
 
 Contract::Contract()
 {
   Contract::reset();
-  if (! setContractTables)
-  {
-    mtx.lock();
-    if (! setContractTables)
-      Contract::setTables();
-    setContractTables = true;
-    mtx.unlock();
-  }
 }
 
 
@@ -186,82 +210,15 @@ void Contract::reset()
   setContractFlag = false;
   setVulFlag = false;
   setResultFlag = false;
+  tricksRelative = 0;
+  score = 0;
 }
 
 
 void Contract::setTables()
 {
-  Entry e;
-  for (e.contract.level = 1; e.contract.level <= 7; e.contract.level++)
-  {
-    stringstream s1;
-    s1 << e.contract.level;
-
-    for (unsigned dno = 0; dno < 6; dno++)
-    {
-      e.contract.denom = DENOM_SUPERSET_NUM[dno];
-      stringstream s2;
-      s2 << s1.str() << DENOM_SUPERSET_TAG[dno];
-
-      for (unsigned mno = 0; mno < 6; mno++)
-      {
-        e.contract.mult = MULT_SUPERSET_NUM[mno];
-	stringstream s3;
-	s3 << s2.str() << MULT_SUPERSET_TAG[mno];
-
-        for (unsigned decl = 0; decl < BRIDGE_PLAYERS; decl++)
-	{
-	  e.contract.declarer = static_cast<Player>(decl);
-	  stringstream s4;
-	  s4 << s3.str() << PLAYER_NAMES_SHORT[decl];
-
-          stringstream s4b;
-	  s4b << s2.str() << PLAYER_NAMES_SHORT[decl] << 
-            MULT_SUPERSET_TAG[mno];
-
-	  // No trick number given, e.g "4HE".
-	  e.tricksRelative = 7;
-	  CONTRACT_STRING_TO_PARTS[s4.str()] = e;
-	  CONTRACT_STRING_TO_PARTS[s4b.str()] = e;
-
-          // RBN string with ":" and without result.
-          stringstream s4a;
-          s4a << s3.str() << ":" << PLAYER_NAMES_SHORT[decl];
-          CONTRACT_STRING_TO_PARTS[s4a.str()] = e;
-
-	  int lo = 7 - static_cast<int>(e.contract.level);
-	  for (int i = lo; i <= lo+13; i++)
-	  {
-	    stringstream s5, s5b;
-	    e.tricksRelative = i-13;
-	    s5 << s4.str() << LEVEL_SHIFT_TO_TAG[i];
-	    CONTRACT_STRING_TO_PARTS[s5.str()] = e;
-
-	    s5b << s4b.str() << LEVEL_SHIFT_TO_TAG[i];
-	    CONTRACT_STRING_TO_PARTS[s5b.str()] = e;
-	  }
-	}
-      }
-    }
-  }
-
   for (int i = 0; i < 20; i++)
     LEVEL_TAG_TO_RELATIVE[LEVEL_SHIFT_TO_TAG[i]] = i-13;
-  
-  // IMPlookup  1,  2,  3,  4,  5,  6,  7, ...
-  // value      0,  0,  1,  1,  1,  2,  2, ...
-  // score      0, 10, 20, 30, 40, 50, 60, ...
-  
-  IMPlookup[0] = 0; // Unused
-  for (unsigned i = 1; i < 501; i++)
-  {
-    unsigned j = 10 * (i-1);
-    unsigned hit = 1;
-    while (j > IMPscale[hit])
-      hit++;
-
-    IMPlookup[i] = hit-1;
-  }
 }
 
 
@@ -286,12 +243,12 @@ void Contract::passOut()
       if (tricksRelative < -13 || tricksRelative > 6)
       {
         THROW("Contract already set to " + 
-            Contract::strRBNCore());
+            Contract::str(BRIDGE_FORMAT_EML));
       }
       else
       {
         THROW("Contract already set to " + 
-            Contract::strRBNCore() +
+            Contract::str(BRIDGE_FORMAT_EML) +
             LEVEL_SHIFT_TO_TAG[tricksRelative + 13]);
       }
     }
@@ -306,6 +263,140 @@ void Contract::passOut()
 }
 
 
+static size_t matchMultiplier(
+  const string& text,
+  const size_t pos,
+  Multiplier& mult)
+{
+  // Returns the number of characters used, possibly 0.  The longest
+  // tag wins, so "XX" is redoubled rather than doubled.
+  unsigned best = 0;
+  size_t bestLen = 0;
+  for (unsigned mno = 1; mno < 6; mno++)
+  {
+    const string& tag = MULT_SUPERSET_TAG[mno];
+    if (tag.length() > bestLen &&
+        text.compare(pos, tag.length(), tag) == 0)
+    {
+      best = mno;
+      bestLen = tag.length();
+    }
+  }
+  mult = MULT_SUPERSET_NUM[best];
+  return bestLen;
+}
+
+
+static bool matchResult(
+  const string& text,
+  const size_t pos,
+  const unsigned level,
+  int& tricksRelative)
+{
+  // Must consume the rest of the string: "=", "+1" to "+6" or
+  // "-1" to "-13", within what is possible for the level.
+  const size_t l = text.length() - pos;
+  if (l == 1 && text[pos] == '=')
+  {
+    tricksRelative = 0;
+    return true;
+  }
+
+  int value;
+  if (l == 2 && text[pos+1] >= '1' && text[pos+1] <= '9')
+    value = text[pos+1] - '0';
+  else if (l == 3 && text[pos+1] == '1' &&
+      text[pos+2] >= '0' && text[pos+2] <= '3')
+    value = 10 + text[pos+2] - '0';
+  else
+    return false;
+
+  if (text[pos] == '+')
+    tricksRelative = value;
+  else if (text[pos] == '-')
+    tricksRelative = -value;
+  else
+    return false;
+
+  const int lev = static_cast<int>(level);
+  return (tricksRelative >= -6 - lev && tricksRelative <= 7 - lev);
+}
+
+
+static bool stringToEntry(
+  const string& text,
+  Entry& e)
+{
+  // Decodes the contract strings of all formats, such as "4HE",
+  // "4HxE", "4HEx-1", "3NTXXS=" and the RBN "4HX:E".
+  // tricksRelative is 7 if no result is given.
+  const size_t l = text.length();
+  if (l < 3 || text[0] < '1' || text[0] > '7')
+    return false;
+
+  e.contract.level = static_cast<unsigned>(text[0] - '0');
+
+  const unsigned dno =
+    CHAR_TO_DENOM_SUPERSET[static_cast<unsigned char>(text[1])];
+  if (dno == 6)
+    return false;
+  e.contract.denom = DENOM_SUPERSET_NUM[dno];
+
+  size_t pos = 2;
+  if (dno == 4 && text[pos] == 'T')
+    pos++;
+
+  if (pos == l)
+    return false;
+
+  unsigned decl = CHAR_TO_DECLARER[static_cast<unsigned char>(text[pos])];
+  if (decl == BRIDGE_PLAYERS)
+  {
+    // Multiplier first, then perhaps the RBN colon, then declarer.
+    pos += matchMultiplier(text, pos, e.contract.mult);
+    if (pos == l)
+      return false;
+
+    bool colonFlag = false;
+    if (text[pos] == ':')
+    {
+      colonFlag = true;
+      pos++;
+      if (pos == l)
+        return false;
+    }
+
+    decl = CHAR_TO_DECLARER[static_cast<unsigned char>(text[pos])];
+    if (decl == BRIDGE_PLAYERS)
+      return false;
+    pos++;
+
+    if (colonFlag)
+    {
+      e.contract.declarer = static_cast<Player>(decl);
+      e.tricksRelative = 7;
+      return (pos == l);
+    }
+  }
+  else
+  {
+    // Declarer first, then the multiplier.
+    pos++;
+    pos += matchMultiplier(text, pos, e.contract.mult);
+  }
+
+  e.contract.declarer = static_cast<Player>(decl);
+
+  if (pos == l)
+  {
+    e.tricksRelative = 7;
+    return true;
+  }
+  else
+    return matchResult(text, pos, e.contract.level, e.tricksRelative);
+}
+
+
 void Contract::setContractByString(const string& text)
 {
   if (text == "P" || text == "p" || text == "Pass" || text == "PASS")
@@ -314,12 +405,11 @@ void Contract::setContractByString(const string& text)
     return;
   }
 
-  auto it = CONTRACT_STRING_TO_PARTS.find(text);
-  if (it == CONTRACT_STRING_TO_PARTS.end())
+  Entry entry;
+  if (! stringToEntry(text, entry))
     THROW("Invalid string: '" + text + "'");
 
   setContractFlag = true;
-  Entry entry = it->second;
   contract = entry.contract;
   if (entry.tricksRelative != 7)
   {
@@ -739,6 +829,52 @@ int Contract::diffToIMPs(const int d) const
 }
 
 
+void Contract::writeBDB(BDBWriter& bw) const
+{
+  bw.putBool(setContractFlag);
+  if (setContractFlag)
+  {
+    // A passed-out contract only has its level of 0 set.
+    const bool passFlag = (contract.level == 0);
+    bw.putByte(passFlag ? 0u : static_cast<unsigned>(contract.declarer));
+    bw.putByte(contract.level);
+    bw.putByte(passFlag ? 0u : static_cast<unsigned>(contract.denom));
+    bw.putByte(passFlag ? 0u : static_cast<unsigned>(contract.mult));
+  }
+
+  bw.putBool(setVulFlag);
+  if (setVulFlag)
+    bw.putByte(vul);
+
+  bw.putBool(setResultFlag);
+  bw.putInt(tricksRelative);
+  bw.putInt(score);
+}
+
+
+void Contract::readBDB(BDBReader& br)
+{
+  Contract::reset();
+
+  setContractFlag = br.getBool();
+  if (setContractFlag)
+  {
+    contract.declarer = static_cast<Player>(br.getByte());
+    contract.level = br.getByte();
+    contract.denom = static_cast<Denom>(br.getByte());
+    contract.mult = static_cast<Multiplier>(br.getByte());
+  }
+
+  setVulFlag = br.getBool();
+  if (setVulFlag)
+    vul = static_cast<Vul>(br.getByte());
+
+  setResultFlag = br.getBool();
+  tricksRelative = br.getInt();
+  score = br.getInt();
+}
+
+
 bool Contract::operator == (const Contract& c2) const
 {
   if (setVulFlag != c2.setVulFlag)
@@ -788,82 +924,61 @@ bool Contract::operator != (const Contract& c2) const
 }
 
 
-string Contract::strLIN(const Format format) const
+void Contract::appendLIN(
+  string& st,
+  const Format format) const
 {
   if (! setContractFlag)
-    return "";
+    return;
   
   if (contract.level == 0)
-    return (format == BRIDGE_FORMAT_LIN_VG ? "PASS" : "P");
+  {
+    st += (format == BRIDGE_FORMAT_LIN_VG ? "PASS" : "P");
+    return;
+  }
 
-  stringstream ss;
-  ss << 
-    contract.level <<
-    DENOM_NAMES_SHORT[contract.denom] <<
-    PLAYER_NAMES_SHORT[contract.declarer] << 
-    MULT_NUM_TO_LIN_TAG[contract.mult];
+  appendUnsigned(st, contract.level);
+  st += DENOM_NAMES_SHORT[contract.denom];
+  st += PLAYER_NAMES_SHORT[contract.declarer];
+  st += MULT_NUM_TO_LIN_TAG[contract.mult];
 
   if (setResultFlag)
-    ss << LEVEL_SHIFT_TO_TAG[tricksRelative + 13];
-
-  return ss.str();
-}
-
-
-string Contract::strPBN() const
-{
-  if (! setContractFlag)
-    return "";
-  
-  if (contract.level == 0)
-    return "[Contract \"Pass\"]\n";
-
-  stringstream ss;
-  ss << "[Contract \"" <<
-    contract.level <<
-    DENOM_NAMES_SHORT_PBN[contract.denom] <<
-    MULT_NUM_TO_PBN_TAG[contract.mult] <<
-    "\"]\n";
-
-  return ss.str();
+    st += LEVEL_SHIFT_TO_TAG[tricksRelative + 13];
 }
 
 
-string Contract::strRBNCore() const
+void Contract::appendPBN(string& st) const
 {
   if (! setContractFlag)
-    return "";
+    return;
   
   if (contract.level == 0)
-    return "";
-
-  stringstream s;
-  s << 
-    contract.level <<
-    DENOM_NAMES_SHORT[contract.denom] <<
-    MULT_NUM_TO_RBN_TAG[contract.mult] << 
-    ":" <<
-    PLAYER_NAMES_SHORT[contract.declarer];
+  {
+    st += "[Contract \"Pass\"]\n";
+    return;
+  }
 
-  return s.str();
+  st += "[Contract \"";
+  appendUnsigned(st, contract.level);
+  st += DENOM_NAMES_SHORT_PBN[contract.denom];
+  st += MULT_NUM_TO_PBN_TAG[contract.mult];
+  st += "\"]\n";
 }
 
 
-string Contract::strRBN() const
+bool Contract::hasRBNCore() const
 {
-  const string st = Contract::strRBNCore();
-  if (st == "")
-    return "";
-  return "C " + st + "\n";
+  return (setContractFlag && contract.level > 0);
 }
 
 
-string Contract::strRBX() const
+void Contract::appendRBNCore(string& st) const
 {
-  const string st = Contract::strRBNCore();
-  if (st == "")
-    return "";
-  return "C{" + st + "}";
+  appendUnsigned(st, contract.level);
+  st += DENOM_NAMES_SHORT[contract.denom];
+  st += MULT_NUM_TO_RBN_TAG[contract.mult];
+  st += ":";
+  st += PLAYER_NAMES_SHORT[contract.declarer];
 }
 
 
@@ -875,19 +990,12 @@ string Contract::strTXT() const
   if (contract.level == 0)
     return "";
 
-  stringstream ss;
-  ss << contract.level << 
-    DENOM_NAMES_SHORT_PBN[contract.denom] << 
-    MULT_NUM_TO_LIN_TAG[contract.mult] << " " <<
-    PLAYER_NAMES_LONG[contract.declarer] << "\n";
-
-  return ss.str();
-}
-
-
-string Contract::strEML() const
-{
-  return Contract::strRBNCore();
+  string st;
+  appendUnsigned(st, contract.level);
+  st += DENOM_NAMES_SHORT_PBN[contract.denom];
+  st += MULT_NUM_TO_LIN_TAG[contract.mult];
+  st += " ";
+  return st + PLAYER_NAMES_LONG[contract.declarer] + "\n";
 }
 
 
@@ -899,20 +1007,19 @@ string Contract::strPar() const
   if (contract.level == 0)
     return "pass";
 
-  stringstream ss;
-  ss << 
-    contract.level <<
-    DENOM_NAMES_SHORT[contract.denom] <<
-    MULT_NUM_TO_PAR_TAG[contract.mult] << 
-    "-" <<
-    PLAYER_NAMES_SHORT[contract.declarer] << 
-    LEVEL_SHIFT_TO_TAG[tricksRelative + 13];
-
-  return ss.str();
+  string st;
+  appendUnsigned(st, contract.level);
+  st += DENOM_NAMES_SHORT[contract.denom];
+  st += MULT_NUM_TO_PAR_TAG[contract.mult];
+  st += "-";
+  st += PLAYER_NAMES_SHORT[contract.declarer];
+  return st + LEVEL_SHIFT_TO_TAG[tricksRelative + 13];
 }
 
 
-string Contract::str(const Format format) const
+void Contract::appendStr(
+  string& st,
+  const Format format) const
 {
   switch(format)
   {
@@ -920,25 +1027,43 @@ string Contract::str(const Format format) const
     case BRIDGE_FORMAT_LIN_RP:
     case BRIDGE_FORMAT_LIN_VG:
     case BRIDGE_FORMAT_LIN_TRN:
-      return Contract::strLIN(format);
+      Contract::appendLIN(st, format);
+      break;
 
     case BRIDGE_FORMAT_PBN:
-      return Contract::strPBN();
+      Contract::appendPBN(st);
+      break;
 
     case BRIDGE_FORMAT_RBN:
-      return Contract::strRBN();
+      if (Contract::hasRBNCore())
+      {
+        st += "C ";
+        Contract::appendRBNCore(st);
+        st += "\n";
+      }
+      break;
 
     case BRIDGE_FORMAT_RBX:
-      return Contract::strRBX();
+      if (Contract::hasRBNCore())
+      {
+        st += "C{";
+        Contract::appendRBNCore(st);
+        st += "}";
+      }
+      break;
 
     case BRIDGE_FORMAT_TXT:
-      return Contract::strTXT();
+      st += Contract::strTXT();
+      break;
 
     case BRIDGE_FORMAT_EML:
-      return Contract::strEML();
+      if (Contract::hasRBNCore())
+        Contract::appendRBNCore(st);
+      break;
 
     case BRIDGE_FORMAT_PAR:
-      return Contract::strPar();
+      st += Contract::strPar();
+      break;
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -946,6 +1071,14 @@ string Contract::str(const Format format) const
 }
 
 
+string Contract::str(const Format format) const
+{
+  string st;
+  Contract::appendStr(st, format);
+  return st;
+}
+
+
 string Contract::strDeclarer(const Format format) const
 {
   switch(format)
@@ -1015,8 +1148,11 @@ string Contract::strTricks(const Format format) const
     case BRIDGE_FORMAT_PBN:
       if (! setResultFlag || contract.level == 0)
         return "";
-      else
-        return "[Result \"" + STR(Contract::getTricks()) + "\"]\n";
+      {
+        string st = "[Result \"";
+        appendUnsigned(st, Contract::getTricks());
+        return st + "\"]\n";
+      }
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -1029,10 +1165,18 @@ string Contract::strScorePBN() const
   if (! setResultFlag || score == 0)
     return "";
 
+  string st;
   if (score > 0)
-    return "[Score \"NS " + STR(score) + "\"]\n";
+  {
+    st = "[Score \"NS ";
+    appendInt(st, score);
+  }
   else
-    return "[Score \"EW " + STR(-score) + "\"]\n";
+  {
+    st = "[Score \"EW ";
+    appendInt(st, -score);
+  }
+  return st + "\"]\n";
 }
 
 
@@ -1041,18 +1185,25 @@ string Contract::strScorePBN(const int refScore) const
   if (! setResultFlag)
     return "";
 
-  stringstream ss;
-  ss << Contract::strScorePBN();
+  string st = Contract::strScorePBN();
 
   int IMPs = Contract::diffToIMPs(score - refScore);
   if (IMPs > 0)
-    ss << "[ScoreIMP \"NS " << IMPs << "\"]\n";
+  {
+    st += "[ScoreIMP \"NS ";
+    appendInt(st, IMPs);
+    st += "\"]\n";
+  }
   else if (IMPs == 0)
-    ss << "[ScoreIMP \"0\"]\n";
+    st += "[ScoreIMP \"0\"]\n";
   else
-    ss << "[ScoreIMP \"EW " << -IMPs << "\"]\n";
+  {
+    st += "[ScoreIMP \"EW ";
+    appendInt(st, -IMPs);
+    st += "\"]\n";
+  }
   
-  return ss.str();
+  return st;
 }
 
 
@@ -1061,40 +1212,41 @@ string Contract::strScoreTXT() const
   if (! setContractFlag || ! setResultFlag)
     return "";
 
-  return "Score   : " + STR(score) + "\n";
+  string st = "Score   : ";
+  appendInt(st, score);
+  return st + "\n";
 }
 
 
 string Contract::strScoreEML() const
 {
-  if (setResultFlag)
-    return "Score: " + STR(score) + ",  IMPs:";
-  else
+  if (! setResultFlag)
     return "Score: 0,  IMPs:";
+
+  string st = "Score: ";
+  appendInt(st, score);
+  return st + ",  IMPs:";
 }
 
 
 string Contract::strScoreEML(const int refScore) const
 {
-  stringstream ss;
-  ss << Contract::strScoreEML();
+  string st = Contract::strScoreEML();
 
   int IMPs = Contract::diffToIMPs(score - refScore);
-  ss << setw(7) << setprecision(2) << fixed << static_cast<double>(IMPs);
-  return ss.str();
+  appendFixed(st, static_cast<double>(IMPs), 2, 7);
+  return st;
 }
 
 
 string Contract::strScoreREC() const
 {
-  stringstream ss;
-  if (Contract::isPassedOut())
-    ss << "Score: " << setw(13) << "";
-  else if (! setResultFlag)
-    ss << "Score: " << setw(13) << left << showpos << 0;
-  else
-    ss << "Score: " << setw(13) << left << showpos << score;
-  return ss.str();
+  string st = "Score: ";
+  const size_t start = st.length();
+  if (! Contract::isPassedOut())
+    appendInt(st, setResultFlag ? score : 0, 0, true);
+  padTo(st, start, 13);
+  return st;
 }
 
 
@@ -1142,20 +1294,20 @@ string Contract::strScoreIMP(
   const Format format,
   const int refScore) const
 {
-  stringstream ss;
+  string st;
   int IMPs;
   switch(format)
   {
     case BRIDGE_FORMAT_REC:
-      ss << "Points:";
+      st = "Points:";
       IMPs = Contract::diffToIMPs(score - refScore);
       if (Contract::isPassedOut())
-        ss << setw(7) << "";
+        appendSpaces(st, 7);
       else if (IMPs == 0)
-        ss << setw(7) << right << "=";
+        appendRight(st, "=", 7);
       else
-        ss << setw(7) << right << showpos << IMPs;
-      return ss.str(); 
+        appendInt(st, IMPs, 7, true);
+      return st; 
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -1165,42 +1317,36 @@ string Contract::strScoreIMP(
 
 string Contract::strResultPBN() const
 {
-  stringstream ss;
   if (Contract::isPassedOut())
-    ss << "[Result \"\"]\n";
-  else
-    ss << "[Result \"" << Contract::getTricks() << "\"]\n";
+    return "[Result \"\"]\n";
 
-  return ss.str();
+  string st = "[Result \"";
+  appendUnsigned(st, Contract::getTricks());
+  return st + "\"]\n";
 }
 
 
 string Contract::strResultRBNCore() const
 {
-  stringstream ss;
   if (Contract::isPassedOut())
     return "P";
 
-  ss << Contract::getTricks();
-  if (score > 0)
-    ss << "+";
-  ss << score;
-  return ss.str();
+  string st;
+  appendUnsigned(st, Contract::getTricks());
+  appendInt(st, score, 0, score > 0);
+  return st;
 }
 
 
 string Contract::strResultRBNCore(const int refScore) const
 {
-  stringstream ss;
-  ss << Contract::strResultRBNCore() << ":";
+  string st = Contract::strResultRBNCore() + ":";
   int IMPs = Contract::diffToIMPs(score - refScore);
-  if (IMPs > 0)
-    ss << "+" << IMPs;
-  else if (IMPs == 0)
-    ss << "=";
+  if (IMPs == 0)
+    st += "=";
   else
-    ss << IMPs;
-  return ss.str();
+    appendInt(st, IMPs, 0, true);
+  return st;
 }
 
 
@@ -1233,18 +1379,30 @@ string Contract::strResultTXT() const
   if (contract.level == 0)
     return "Passed out";
 
-  stringstream ss;
+  string st;
   if (tricksRelative < 0)
-    ss << "Down " << -tricksRelative << " -- ";
+  {
+    st = "Down ";
+    appendInt(st, -tricksRelative);
+  }
   else
-    ss << "Made " << 
-      static_cast<int>(contract.level) + tricksRelative << " -- ";
+  {
+    st = "Made ";
+    appendInt(st, static_cast<int>(contract.level) + tricksRelative);
+  }
+  st += " -- ";
 
   if (score > 0)
-    ss << "NS +" << score;
+  {
+    st += "NS +";
+    appendInt(st, score);
+  }
   else
-    ss << "EW +" << -score;
-  return ss.str();
+  {
+    st += "EW +";
+    appendInt(st, -score);
+  }
+  return st;
 }
 
 
@@ -1252,46 +1410,54 @@ string Contract::strResultTXT(
   const int refScore,
   const string& team) const
 {
-  stringstream ss;
-  ss << Contract::strResultTXT();
+  string st = Contract::strResultTXT();
 
   int IMPs = Contract::diffToIMPs(score - refScore);
   if (IMPs == 0)
-    ss << " -- Tie";
-  else if (IMPs > 0)
-    ss << " -- " << team << " +" << IMPs << " IMP";
+    st += " -- Tie";
   else
-    ss << " -- " << team << " +" << -IMPs << " IMP";
+  {
+    st += " -- " + team + " +";
+    appendInt(st, IMPs > 0 ? IMPs : -IMPs);
+    st += " IMP";
+  }
 
   if (IMPs != 0 && IMPs != 1 && IMPs != -1)
-    ss << "s";
-  return ss.str() + "\n";
+    st += "s";
+  return st + "\n";
 }
 
 
 string Contract::strResultEML() const
 {
-  stringstream ss;
+  string st = "Result: ";
   // Pavlicek bug?
   if (tricksRelative < 0)
-    ss << "Result: " << tricksRelative;
+    appendInt(st, tricksRelative);
   else
-    ss << "Result: +" << static_cast<int>(contract.level) + tricksRelative;
-  return ss.str();
+    appendInt(st, static_cast<int>(contract.level) + tricksRelative,
+      0, true);
+  return st;
 }
 
 
 string Contract::strResultREC() const
 {
-  stringstream ss;
   if (Contract::isPassedOut())
-    ss << "Result: Won 32"; // Pavlicek bug
-  else if (tricksRelative < 0)
-    ss << "Result: Down " << -tricksRelative;
+    return "Result: Won 32"; // Pavlicek bug
+
+  string st;
+  if (tricksRelative < 0)
+  {
+    st = "Result: Down ";
+    appendInt(st, -tricksRelative);
+  }
   else
-    ss << "Result: Made " << 
-      static_cast<int>(contract.level) + tricksRelative;
-  return ss.str();
+  {
+    st = "Result: Made ";
+    appendInt(st, static_cast<int>(contract.level) + tricksRelative);
+  }
+  return st;
 }
 
 
@@ -1321,7 +1487,7 @@ string Contract::strResult(const Format format) const
       return Contract::strResultREC();
 
     case BRIDGE_FORMAT_PAR:
-      return STR(Contract::getTricks());
+      return to_string(Contract::getTricks());
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -17,6 +17,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 struct ContractInternal
 {
   Player declarer;
@@ -39,8 +43,6 @@ class Contract
     int tricksRelative;
     int score;
 
-    void setTables();
-
     void setContractByString(const string& text);
 
     void setContractTXT(const string& text);
@@ -52,13 +54,13 @@ class Contract
     void setResultTXT(const string& text);
     void setResultEML(const string& text);
 
-    string strLIN(const Format format) const;
-    string strPBN() const;
-    string strRBNCore() const;
-    string strRBN() const;
-    string strRBX() const;
+    void appendLIN(
+      string& st,
+      const Format format) const;
+    void appendPBN(string& st) const;
+    bool hasRBNCore() const;
+    void appendRBNCore(string& st) const;
     string strTXT() const;
-    string strEML() const;
     string strPar() const;
 
     string strScorePBN() const;
@@ -89,6 +91,8 @@ class Contract
 
     ~Contract();
 
+    static void setTables();
+
     void reset();
 
     bool isSet() const;
@@ -141,10 +145,18 @@ class Contract
 
     Denom getDenom() const;
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Contract& c2) const;
 
     bool operator != (const Contract& c2) const;
 
+    // The file writers append straight onto their output text.
+    void appendStr(
+      string& st,
+      const Format format) const;
+
     string str(const Format format) const;
     string strDeclarer(const Format format) const;
     string strVul(const Format format) const;
@@ -0,0 +1,139 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "Corpus.h"
+#include "Group.h"
+#include "parse.h"
+#include "Bexcept.h"
+
+
+Corpus::Corpus()
+{
+  Corpus::reset();
+}
+
+
+Corpus::~Corpus()
+{
+}
+
+
+void Corpus::reset()
+{
+  writer.reset();
+  data.clear();
+  starts.clear();
+  numInstances = 0;
+  boardBytes = 0;
+}
+
+
+unsigned Corpus::addLocked(const Board& board)
+{
+  const unsigned no = static_cast<unsigned>(starts.size());
+  starts.push_back(data.size());
+  board.writeBDB(writer);
+  writer.takeBody(data);
+
+  numInstances += board.countAll();
+  boardBytes += sizeof(Board) + board.heapSize();
+  return no;
+}
+
+
+unsigned Corpus::addGroup(const Group& group)
+{
+  // Held for the whole group, so that the numbers are consecutive.
+  lock_guard<mutex> lck(mtx);
+
+  const unsigned first = static_cast<unsigned>(starts.size());
+  for (auto &segment: group)
+  {
+    for (auto &bpair: segment)
+      Corpus::addLocked(bpair.board);
+  }
+  return first;
+}
+
+
+unsigned Corpus::size() const
+{
+  lock_guard<mutex> lck(mtx);
+  return static_cast<unsigned>(starts.size());
+}
+
+
+void Corpus::get(
+  const unsigned no,
+  Board& board) const
+{
+  // The lock is also needed here, as addGroup() may grow the string table.
+  lock_guard<mutex> lck(mtx);
+
+  if (no >= starts.size())
+    THROW("Corpus board number out of range: " + STR(no));
+
+  const size_t start = starts[no];
+  const size_t end = (no+1 < starts.size() ? starts[no+1] : data.size());
+
+  BDBReader br;
+  br.setBody(data.data() + start, end - start, writer.table());
+  board.readBDB(br, nullptr);
+}
+
+
+void Corpus::strLine(
+  stringstream& ss,
+  const string& label,
+  const size_t bytes,
+  const size_t n) const
+{
+  ss << left << setw(12) << label << right <<
+    setw(12) << bytes / 1e6 <<
+    setw(14) << static_cast<double>(bytes) / n << "\n";
+}
+
+
+string Corpus::str() const
+{
+  lock_guard<mutex> lck(mtx);
+
+  const size_t n = starts.size();
+  if (n == 0)
+    return "";
+
+  // Each table string also has a hash node and a pointer.
+  const vector<string const *>& table = writer.table();
+  size_t tableBytes = 0;
+  for (auto sp: table)
+    tableBytes += sizeof(string) + heapSize(* sp) +
+      sizeof(unsigned) + 3 * sizeof(void *);
+
+  const size_t frozenBytes = data.size() + n * sizeof(size_t) +
+    tableBytes;
+
+  stringstream ss;
+  ss << "Corpus: " << n << " boards, " << numInstances <<
+      " instances, " << table.size() << " distinct strings\n";
+  ss << fixed << setprecision(1);
+  ss << setw(12) << "" << setw(12) << "MB" <<
+    setw(14) << "bytes/board" << "\n";
+  Corpus::strLine(ss, "as Boards", boardBytes, n);
+  Corpus::strLine(ss, "frozen", frozenBytes, n);
+  Corpus::strLine(ss, "  boards", data.size(), n);
+  Corpus::strLine(ss, "  strings", tableBytes, n);
+  ss << "Ratio " << static_cast<double>(boardBytes) / frozenBytes <<
+    " : 1\n\n";
+  return ss.str();
+}
+
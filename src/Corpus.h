@@ -0,0 +1,85 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// A Corpus keeps boards from all the input files in memory in a
+// frozen, compact form, so that they can be analyzed together.  Each
+// board is stored once, in the BDB encoding (deals as suit bitmasks,
+// calls and cards as single bytes), and all boards share one string
+// table, so each player name is only held once.  A frozen board is
+// never changed, but it can be thawed into an ordinary Board.
+
+
+#ifndef BRIDGE_CORPUS_H
+#define BRIDGE_CORPUS_H
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+#else
+  #include <thread>
+  #include <mutex>
+#endif
+
+#include "BDB.h"
+
+class Board;
+class Group;
+
+using namespace std;
+
+
+class Corpus
+{
+  private:
+
+    BDBWriter writer;
+    string data;
+    vector<size_t> starts;
+
+    unsigned numInstances;
+    size_t boardBytes; // The same boards as Board objects
+
+    mutable mutex mtx;
+
+
+    unsigned addLocked(const Board& board);
+
+    void strLine(
+      stringstream& ss,
+      const string& label,
+      const size_t bytes,
+      const size_t n) const;
+
+
+  public:
+
+    Corpus();
+
+    ~Corpus();
+
+    void reset();
+
+    // The boards of a group get consecutive numbers from the one
+    // that is returned.
+    unsigned addGroup(const Group& group);
+
+    unsigned size() const;
+
+    void get(
+      const unsigned no,
+      Board& board) const;
+
+    string str() const;
+};
+
+#endif
+
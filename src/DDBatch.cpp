@@ -0,0 +1,308 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <iostream>
+#include <sstream>
+#include <cstring>
+
+#include "DDBatch.h"
+#include "Board.h"
+#include "Files.h"
+#include "ddsIF.h"
+#include "Bexcept.h"
+
+
+DDBatch::DDBatch()
+{
+  DDBatch::reset();
+}
+
+
+DDBatch::~DDBatch()
+{
+}
+
+
+void DDBatch::reset()
+{
+  files = nullptr;
+  maxWait = chrono::milliseconds(0);
+  numWorkers = 0;
+  numWaiting = 0;
+
+  for (unsigned i = 0; i < BRIDGE_DD_INFO_SIZE; i++)
+    pending[i] = nullptr;
+}
+
+
+void DDBatch::set(
+  Files& filesIn,
+  const unsigned waitMs,
+  const unsigned numThreads)
+{
+  files = &filesIn;
+  maxWait = chrono::milliseconds(waitMs);
+  numWorkers = numThreads;
+  numWaiting = 0;
+
+  for (unsigned i = 0; i < BRIDGE_DD_INFO_SIZE; i++)
+    pending[i] = DDBatch::newBatch(static_cast<DDInfoType>(i));
+}
+
+
+bool DDBatch::active() const
+{
+  return (files != nullptr && maxWait.count() > 0);
+}
+
+
+DDBatch::BatchPtr DDBatch::newBatch(const DDInfoType infoNo) const
+{
+  BatchPtr bp = make_shared<Batch>();
+  bp->infoNo = infoNo;
+  bp->entries.reserve(DDBatch::capacity(infoNo));
+  bp->deadline = chrono::steady_clock::now() + maxWait;
+  bp->doneFlag = false;
+  return bp;
+}
+
+
+unsigned DDBatch::capacity(const DDInfoType infoNo) const
+{
+  return (infoNo == BRIDGE_DD_INFO_SOLVE ? MAXNOOFTABLES : MAXNOOFBOARDS);
+}
+
+
+DDBatch::BatchPtr DDBatch::add(
+  const DDInfoType infoNo,
+  Entry& entry,
+  bool& fullFlag)
+{
+  lock_guard<mutex> lck(mtx);
+
+  BatchPtr bp = pending[infoNo];
+  if (bp->entries.empty())
+    bp->deadline = chrono::steady_clock::now() + maxWait;
+  bp->entries.push_back(entry);
+
+  // The adding thread takes over a full batch.
+  fullFlag = (bp->entries.size() == DDBatch::capacity(infoNo));
+  if (fullFlag)
+    pending[infoNo] = DDBatch::newBatch(infoNo);
+
+  return bp;
+}
+
+
+void DDBatch::addTableau(
+  const string& fname,
+  const string& caseName,
+  Board * bd,
+  const string& cards,
+  Tickets& tickets)
+{
+  Entry entry;
+  entry.fname = fname;
+  entry.caseName = caseName;
+  entry.bd = bd;
+  entry.inst = nullptr;
+  strcpy(entry.dl.remainCards, cards.c_str());
+
+  bool fullFlag;
+  BatchPtr bp = DDBatch::add(BRIDGE_DD_INFO_SOLVE, entry, fullFlag);
+  if (fullFlag)
+    DDBatch::solveTaken(bp);
+
+  if (tickets.empty() || tickets.back() != bp)
+    tickets.push_back(bp);
+}
+
+
+void DDBatch::addTrace(
+  const string& fname,
+  const string& caseName,
+  Instance * inst,
+  const dealPBN& dl,
+  const playTracePBN& play,
+  Tickets& tickets)
+{
+  Entry entry;
+  entry.fname = fname;
+  entry.caseName = caseName;
+  entry.bd = nullptr;
+  entry.inst = inst;
+  entry.dl = dl;
+  entry.play = play;
+
+  bool fullFlag;
+  BatchPtr bp = DDBatch::add(BRIDGE_DD_INFO_TRACE, entry, fullFlag);
+  if (fullFlag)
+    DDBatch::solveTaken(bp);
+
+  if (tickets.empty() || tickets.back() != bp)
+    tickets.push_back(bp);
+}
+
+
+void DDBatch::solveTableaux(Batch& batch) const
+{
+  ddTableDealsPBN tablePBN;
+  ddTablesRes resDDS;
+
+  tablePBN.noOfTables = static_cast<int>(batch.entries.size());
+  for (unsigned i = 0; i < batch.entries.size(); i++)
+    strcpy(tablePBN.deals[i].cards, batch.entries[i].dl.remainCards);
+
+  tableauDD(&tablePBN, &resDDS);
+
+  for (unsigned i = 0; i < batch.entries.size(); i++)
+    batch.entries[i].bd->setTableauDDS(resDDS.results[i].resTable);
+}
+
+
+void DDBatch::solveTraces(Batch& batch) const
+{
+  boardsPBN bPBN;
+  playTracesPBN pPBN;
+  solvedPlays resDDS;
+
+  bPBN.noOfBoards = static_cast<int>(batch.entries.size());
+  pPBN.noOfBoards = bPBN.noOfBoards;
+  for (unsigned i = 0; i < batch.entries.size(); i++)
+  {
+    bPBN.deals[i] = batch.entries[i].dl;
+    pPBN.plays[i] = batch.entries[i].play;
+  }
+
+  traceDD(&bPBN, &pPBN, &resDDS);
+
+  for (unsigned i = 0; i < batch.entries.size(); i++)
+    batch.entries[i].inst->setTrace(resDDS.solved[i].number,
+      resDDS.solved[i].tricks);
+}
+
+
+void DDBatch::store(const Batch& batch) const
+{
+  // Entries from the same file arrive together, so store runs.
+  vector<string> casesMissing, infoMissing;
+  unsigned holding[BRIDGE_PLAYERS][BRIDGE_SUITS];
+  for (unsigned i = 0; i < batch.entries.size(); i++)
+  {
+    const Entry& entry = batch.entries[i];
+    casesMissing.push_back(entry.caseName);
+
+    if (batch.infoNo == BRIDGE_DD_INFO_SOLVE)
+    {
+      const string s = entry.bd->strTableau(BRIDGE_FORMAT_RBN);
+      infoMissing.push_back(s.substr(4, s.length()-6));
+
+      entry.bd->getDealDDS(holding);
+      files->addTableau(holding, infoMissing.back());
+    }
+    else
+      infoMissing.push_back(entry.inst->strTraceCompact());
+
+    if (i+1 == batch.entries.size() || 
+        batch.entries[i+1].fname != entry.fname)
+    {
+      files->addDDInfo(batch.infoNo, entry.fname, 
+        casesMissing, infoMissing);
+      casesMissing.clear();
+      infoMissing.clear();
+    }
+  }
+}
+
+
+void DDBatch::solve(Batch& batch) const
+{
+  try
+  {
+    if (batch.infoNo == BRIDGE_DD_INFO_SOLVE)
+      DDBatch::solveTableaux(batch);
+    else
+      DDBatch::solveTraces(batch);
+
+    DDBatch::store(batch);
+  }
+  catch (Bexcept& bex)
+  {
+    batch.error = bex.getMessage();
+  }
+}
+
+
+void DDBatch::solveTaken(BatchPtr& bp)
+{
+  // The batch is no longer pending, so only this thread sees it.
+  DDBatch::solve(* bp);
+
+  lock_guard<mutex> lck(mtx);
+  bp->doneFlag = true;
+  cv.notify_all();
+}
+
+
+void DDBatch::wait(Tickets& tickets)
+{
+  unique_lock<mutex> lck(mtx);
+  numWaiting++;
+  cv.notify_all();
+
+  for (auto &bp: tickets)
+  {
+    while (! bp->doneFlag)
+    {
+      BatchPtr& pend = pending[bp->infoNo];
+      const bool pendingFlag = (pend == bp);
+      if (pendingFlag && (numWaiting >= numWorkers ||
+          chrono::steady_clock::now() >= bp->deadline))
+      {
+        // Nobody can add more, or we have waited long enough.
+        pend = DDBatch::newBatch(bp->infoNo);
+        lck.unlock();
+        DDBatch::solve(* bp);
+        lck.lock();
+        bp->doneFlag = true;
+        cv.notify_all();
+      }
+      else if (pendingFlag)
+        cv.wait_until(lck, bp->deadline);
+      else
+        cv.wait(lck);
+    }
+  }
+
+  numWaiting--;
+
+  string error;
+  for (auto &bp: tickets)
+  {
+    if (! bp->error.empty())
+    {
+      error = bp->error;
+      break;
+    }
+  }
+  tickets.clear();
+
+  if (! error.empty())
+    THROW("DD batch failed: " + error);
+}
+
+
+void DDBatch::stopWorker()
+{
+  lock_guard<mutex> lck(mtx);
+  if (numWorkers > 0)
+    numWorkers--;
+  cv.notify_all();
+}
+
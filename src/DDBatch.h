@@ -0,0 +1,137 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// DDBatch collects deals that are missing DD results from the files
+// that the worker threads are processing, and submits them to DDS in
+// full batches.  A worker that fills a batch solves it.  A worker 
+// that waits for a partial batch solves it itself once the maximum
+// wait has passed, or once all workers are waiting.
+
+
+#ifndef BRIDGE_DDBATCH_H
+#define BRIDGE_DDBATCH_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+  #include "mingw.condition_variable.h"
+#else
+  #include <thread>
+  #include <mutex>
+  #include <condition_variable>
+#endif
+
+#include "dll.h"
+#include "bconst.h"
+
+class Board;
+class Instance;
+class Files;
+
+using namespace std;
+
+
+class DDBatch
+{
+  private:
+
+    struct Entry
+    {
+      string fname;
+      string caseName;
+      Board * bd;
+      Instance * inst;
+      dealPBN dl;
+      playTracePBN play;
+    };
+
+    struct Batch
+    {
+      DDInfoType infoNo;
+      vector<Entry> entries;
+      chrono::time_point<chrono::steady_clock> deadline;
+      bool doneFlag;
+      string error;
+    };
+
+    typedef shared_ptr<Batch> BatchPtr;
+
+    Files * files;
+    chrono::milliseconds maxWait;
+    unsigned numWorkers;
+    unsigned numWaiting;
+
+    BatchPtr pending[BRIDGE_DD_INFO_SIZE];
+
+    mutex mtx;
+    condition_variable cv;
+
+
+    BatchPtr newBatch(const DDInfoType infoNo) const;
+
+    unsigned capacity(const DDInfoType infoNo) const;
+
+    BatchPtr add(
+      const DDInfoType infoNo,
+      Entry& entry,
+      bool& fullFlag);
+
+    void solveTableaux(Batch& batch) const;
+
+    void solveTraces(Batch& batch) const;
+
+    void solve(Batch& batch) const;
+
+    void store(const Batch& batch) const;
+
+    void solveTaken(BatchPtr& bp);
+
+
+  public:
+
+    typedef vector<BatchPtr> Tickets;
+
+    DDBatch();
+
+    ~DDBatch();
+
+    void reset();
+
+    void set(
+      Files& filesIn,
+      const unsigned waitMs,
+      const unsigned numThreads);
+
+    bool active() const;
+
+    void addTableau(
+      const string& fname,
+      const string& caseName,
+      Board * bd,
+      const string& cards,
+      Tickets& tickets);
+
+    void addTrace(
+      const string& fname,
+      const string& caseName,
+      Instance * inst,
+      const dealPBN& dl,
+      const playTracePBN& play,
+      Tickets& tickets);
+
+    void wait(Tickets& tickets);
+
+    void stopWorker();
+};
+
+#endif
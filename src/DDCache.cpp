@@ -0,0 +1,112 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "DDCache.h"
+
+
+DDCache::DDCache()
+{
+  DDCache::reset();
+}
+
+
+DDCache::~DDCache()
+{
+}
+
+
+void DDCache::reset()
+{
+  tableaux.clear();
+  hits = 0;
+  misses = 0;
+}
+
+
+string DDCache::fingerprint(const unsigned holding[][BRIDGE_SUITS]) const
+{
+  // The holdings are in DDS format, so the ranks are in bits 2 .. 14.
+  // Card number 13*suit + (rank-2) has its owner in bits 2*no, 2*no+1.
+
+  unsigned char fp[13] = {0};
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+  {
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+    {
+      const unsigned h = holding[p][s] >> 2;
+      for (unsigned r = 0; r < BRIDGE_TRICKS; r++)
+      {
+        if ((h & (1u << r)) == 0)
+          continue;
+
+        const unsigned no = BRIDGE_TRICKS * s + r;
+        fp[no >> 2] = static_cast<unsigned char>(
+          fp[no >> 2] | (p << (2 * (no & 3))));
+      }
+    }
+  }
+  return string(reinterpret_cast<char *>(fp), 13);
+}
+
+
+bool DDCache::lookup(
+  const unsigned holding[][BRIDGE_SUITS],
+  string& info)
+{
+  const string fp = DDCache::fingerprint(holding);
+
+  mtx.lock();
+  auto it = tableaux.find(fp);
+  const bool found = (it != tableaux.end());
+  if (found)
+    info = it->second;
+  mtx.unlock();
+
+  if (found)
+    hits++;
+  else
+    misses++;
+  return found;
+}
+
+
+void DDCache::add(
+  const unsigned holding[][BRIDGE_SUITS],
+  const string& info)
+{
+  const string fp = DDCache::fingerprint(holding);
+
+  mtx.lock();
+  tableaux.emplace(fp, info);
+  mtx.unlock();
+}
+
+
+string DDCache::str() const
+{
+  const unsigned h = hits;
+  const unsigned m = misses;
+  if (h + m == 0)
+    return "";
+
+  mtx.lock();
+  const size_t n = tableaux.size();
+  mtx.unlock();
+
+  stringstream ss;
+  ss << "DD cache: " << h << " hits, " << m << " misses (" <<
+    fixed << setprecision(1) << 100. * h / (h + m) << "% hits), " <<
+    n << " unique deals\n";
+  return ss.str();
+}
+
@@ -0,0 +1,69 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// DDCache holds DD tableaux keyed by the deal itself rather than by
+// file and board number, so the many copies of a deal across the
+// corpus are only solved once.  The key packs the owner of each of
+// the 52 cards into two bits.
+
+
+#ifndef BRIDGE_DDCACHE_H
+#define BRIDGE_DDCACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <atomic>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+#else
+  #include <thread>
+  #include <mutex>
+#endif
+
+#include "bconst.h"
+
+using namespace std;
+
+
+class DDCache
+{
+  private:
+
+    unordered_map<string, string> tableaux;
+
+    atomic<unsigned> hits;
+    atomic<unsigned> misses;
+
+    mutable mutex mtx;
+
+
+    string fingerprint(const unsigned holding[][BRIDGE_SUITS]) const;
+
+
+  public:
+
+    DDCache();
+
+    ~DDCache();
+
+    void reset();
+
+    bool lookup(
+      const unsigned holding[][BRIDGE_SUITS],
+      string& info);
+
+    void add(
+      const unsigned holding[][BRIDGE_SUITS],
+      const string& info);
+
+    string str() const;
+};
+
+#endif
@@ -41,65 +41,61 @@ DDInfo::~DDInfo()
 void DDInfo::reset()
 {
   dirResults.clear();
-  fileResults.clear();
-  caseResults.clear();
+  stores.clear();
+  logName = "tableaux.log";
 }
 
 
-void DDInfo::read(const string& resName)
+void DDInfo::setName(const string& logNameIn)
 {
-  ifstream resstr(resName.c_str());
-  if (! resstr.is_open())
-    return; // File not found
+  logName = logNameIn;
+}
 
-  const string path = filepath(resName);
-  auto itDir = dirResults.find(path);
-  if (itDir != dirResults.end())
-    THROW("Already looked in directory " + path);
 
-  fileResults.emplace_back(FileResults());
-  FileResults& fres = fileResults.back();
+string DDInfo::storeBase(const string& logFull) const
+{
+  const size_t l = logFull.size();
+  if (l > 4 && logFull.substr(l-4) == ".log")
+    return logFull.substr(0, l-4);
+  else
+    return logFull;
+}
 
-  dirResults[path].fileRes = &fres;
-  dirResults[path].fnameDD = basefile(resName);
-  dirResults[path].dirtyFlag = false;
 
-  string line;
-  CaseResults * bres = nullptr;
+DDStore * DDInfo::openStore(const string& path)
+{
+  const string logFull = path + logName;
+  const string base = DDInfo::storeBase(logFull);
+  const bool importFlag = ! DDStore::exists(base);
 
-  while (getline(resstr, line))
-  {
-    if (line.empty() || line.front() == '%')
-      continue;
-    
-    if (line.back()  == ':')
-    {
-      const string fname = line.substr(0, line.size()-1);
-      auto itFile = fres.find(fname);
-      if (itFile != fres.end())
-        THROW("In directory " + path + ", file " + fname + " already seen");
-      
-      caseResults.emplace_back(CaseResults());
-      bres = &caseResults.back();
-      fres[fname] = bres;
-      continue;
-    }
+  stores.emplace_back();
+  DDStore * store = &stores.back();
+  store->open(base);
+
+  if (importFlag)
+    store->importText(logFull);
+
+  return store;
+}
 
-    if (bres == nullptr)
-      THROW("In directory " + path + ", no file is entered in " + resName);
-    
-    const size_t c = countDelimiters(line, " ");
-    if (c != 1)
-      THROW("Need exactly one space in line " + line);
 
-    vector<string> tokens(2);
-    tokens.clear();
-    tokenize(line, tokens, " ");
+void DDInfo::read(const string& resName)
+{
+  const string path = filepath(resName);
+  auto itDir = dirResults.find(path);
+  if (itDir != dirResults.end())
+    THROW("Already looked in directory " + path);
 
-    (*bres)[tokens[0]] = tokens[1];
+  // Only set up a store where there are results already.
+  if (! DDStore::exists(DDInfo::storeBase(resName)))
+  {
+    ifstream resstr(resName.c_str());
+    if (! resstr.is_open())
+      return;
   }
 
-  resstr.close();
+  logName = basefile(resName);
+  dirResults[path] = {DDInfo::openStore(path), false};
 }
 
 
@@ -112,32 +108,33 @@ bool DDInfo::haveResults(
   const string path = filepath(fname);
   const string base = basefile(fname);
 
-  auto itDir = dirResults.find(path);
-  if (itDir == dirResults.end())
+  infoSeen.clear();
+
+  // Another thread may be adding a directory at the same time.
+  DDStore const * storePtr = nullptr;
   {
-    infoSeen.clear();
-    casesMissing = casesIn;
-    return false;
+    lock_guard<mutex> lck(mtx);
+    auto itDir = dirResults.find(path);
+    if (itDir != dirResults.end())
+      storePtr = itDir->second.store;
   }
 
-  const FileResults& fres = *(itDir->second.fileRes);
-  auto itFile = fres.find(base);
-  if (itFile == fres.end())
+  if (storePtr == nullptr)
   {
-    infoSeen.clear();
     casesMissing = casesIn;
     return false;
   }
 
-  const CaseResults& bres = *(itFile->second);
+  // The store does its own locking.
+  const DDStore& store = * storePtr;
+  string info;
   casesMissing.clear();
   for (auto &it: casesIn)
   {
-    auto itCase = bres.find(it);
-    if (itCase == bres.end())
-      casesMissing.push_back(it);
+    if (store.lookup(base, it, info))
+      infoSeen[it] = info;
     else
-      infoSeen[itCase->first] = itCase->second;
+      casesMissing.push_back(it);
   }
 
   return (casesMissing.size() == 0);
@@ -149,78 +146,43 @@ void DDInfo::add(
   const vector<string>& casesMissing,
   const vector<string>& infoMissing)
 {
-  mtx.lock();
-
-  FileResults * fresp;
+  DDStore * store;
   const string path = filepath(fname);
-  auto itDir = dirResults.find(path);
-  if (itDir == dirResults.end())
-  {
-    fileResults.emplace_back(FileResults());
-    fresp = &fileResults.back();
-    dirResults[path] = {fresp, "", true};
-  }
-  else
-  {
-    fresp = itDir->second.fileRes;
-    dirResults[path].dirtyFlag = true;
-  }
 
-  FileResults& fres = * fresp;
-  const string base = basefile(fname);
-
-  CaseResults * bresp;
-  auto itFile = fres.find(base);
-  if (itFile == fres.end())
   {
-    caseResults.emplace_back(CaseResults());
-    bresp = &caseResults.back();
-    fres[base] = bresp;
+    lock_guard<mutex> lck(mtx);
+    auto itDir = dirResults.find(path);
+    if (itDir == dirResults.end())
+    {
+      store = DDInfo::openStore(path);
+      dirResults[path] = {store, true};
+    }
+    else
+    {
+      store = itDir->second.store;
+      itDir->second.dirtyFlag = true;
+    }
   }
-  else
-    bresp = itFile->second;
-  
-  mtx.unlock();
 
-  CaseResults& bres = * bresp;
+  // The store syncs its records to disk as they accumulate.
+  const string base = basefile(fname);
   for (unsigned i = 0; i < casesMissing.size(); i++)
-  {
-    auto itCase = bres.find(casesMissing[i]);
-    if (itCase == bres.end())
-      bres[casesMissing[i]] = infoMissing[i];
-    else
-      THROW("Attempting to reset an existing DD value: " + fname +
-        ", " + STR(i) + ", " + STR(casesMissing[i]));
-  }
+    store->add(base, casesMissing[i], infoMissing[i]);
 }
 
 
-void DDInfo::write(const string& resName) const
+void DDInfo::write(const string& resName)
 {
-  for (auto const &itDir: dirResults)
+  for (auto &itDir: dirResults)
   {
-    const DirEntry& dirEntry = itDir.second;
+    DirEntry& dirEntry = itDir.second;
     if (! dirEntry.dirtyFlag)
       continue;
 
-    const string fullName = itDir.first + 
-      (resName == "" ? dirEntry.fnameDD : resName);
-
-    ofstream dd;
-    dd.open(fullName);
-
-    FileResults& fres = *(dirEntry.fileRes);
-    for (auto const &itFile: fres)
-    {
-      const string inFile = itFile.first;
-      CaseResults& bres = *(itFile.second);
-
-      dd << inFile << ":\n";
-      for (auto const &itCase: bres)
-        dd << itCase.first << " " << itCase.second << "\n";
-      dd << "\n";
-    }
-    dd.close();
+    dirEntry.store->flush();
+    dirEntry.store->exportText(itDir.first + 
+      (resName == "" ? logName : resName));
+    dirEntry.dirtyFlag = false;
   }
 }
 
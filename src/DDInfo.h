@@ -15,6 +15,7 @@
 #include <list>
 #include <map>
 
+#include "DDStore.h"
 #include "bconst.h"
 
 using namespace std;
@@ -25,18 +26,24 @@ class DDInfo
 {
   private:
 
-    typedef map<string, CaseResults*> FileResults;
+    // There is one binary store per directory.  The text log with
+    // the same base name is imported when there is no store yet,
+    // and it is written out again when the store has changed.
 
     struct DirEntry
     {
-      FileResults * fileRes;
-      string fnameDD;
+      DDStore * store;
       bool dirtyFlag;
     };
 
-    list<CaseResults> caseResults;
-    list<FileResults> fileResults;
+    list<DDStore> stores;
     map<string, DirEntry> dirResults;
+    string logName;
+
+
+    string storeBase(const string& logFull) const;
+
+    DDStore * openStore(const string& path);
 
 
   public:
@@ -47,6 +54,8 @@ class DDInfo
 
     void reset();
 
+    void setName(const string& logNameIn);
+
     void read(const string& resName);
 
     bool haveResults(
@@ -60,8 +69,7 @@ class DDInfo
       const vector<string>& casesMissing,
       const vector<string>& infoMissing);
 
-    void write(const string& fnameDD = "tableaux.log") const;
+    void write(const string& fnameDD = "tableaux.log");
 };
 
 #endif
-
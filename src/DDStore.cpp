@@ -0,0 +1,497 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+#else
+  #include <unistd.h>
+  #include <sys/types.h>
+#endif
+
+#include "DDStore.h"
+#include "bconst.h"
+#include "parse.h"
+#include "Bexcept.h"
+
+#define DDSTORE_HEADER 8
+#define DDSTORE_MAGIC_DATA "BDDDAT01"
+#define DDSTORE_MAGIC_INDEX "BDDIDX01"
+
+// The data file is synced every so many records, and the index is
+// rewritten when this many records are beyond it.
+#define DDSTORE_FLUSH_RECORDS 64
+#define DDSTORE_INDEX_RECORDS 4096
+
+#define DDSTORE_INDEX_START (DDSTORE_HEADER + 2 * sizeof(uint64_t))
+
+
+static void syncFile(FILE * fp)
+{
+  fflush(fp);
+#if defined(_WIN32)
+  _commit(_fileno(fp));
+#else
+  fsync(fileno(fp));
+#endif
+}
+
+
+static void truncateFile(
+  const string& fname,
+  const uint64_t len)
+{
+#if defined(_WIN32)
+  const int fd = _open(fname.c_str(), _O_RDWR | _O_BINARY);
+  if (fd == -1 || _chsize_s(fd, static_cast<__int64>(len)) != 0)
+    THROW("Could not truncate " + fname);
+  _close(fd);
+#else
+  if (truncate(fname.c_str(), static_cast<off_t>(len)) != 0)
+    THROW("Could not truncate " + fname);
+#endif
+}
+
+
+DDStore::DDStore()
+{
+  DDStore::reset();
+}
+
+
+DDStore::~DDStore()
+{
+  try
+  {
+    DDStore::appendPending();
+  }
+  catch (Bexcept& bex)
+  {
+    UNUSED(bex);
+  }
+}
+
+
+void DDStore::reset()
+{
+  nameData = "";
+  nameIndex = "";
+  mapData.close();
+  mapIndex.close();
+  lenData = 0;
+  lenIndexed = 0;
+  tail.clear();
+  tailIndex.clear();
+  pending = "";
+  numPending = 0;
+}
+
+
+string DDStore::makeKey(
+  const string& fname,
+  const string& caseName)
+{
+  return fname + "\n" + caseName;
+}
+
+
+uint64_t DDStore::hashKey(const string& key)
+{
+  // FNV-1a.
+  uint64_t h = 14695981039346656037ull;
+  for (auto c: key)
+  {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+
+bool DDStore::exists(const string& base)
+{
+  ifstream fin(base + ".ddb");
+  return fin.is_open();
+}
+
+
+void DDStore::open(const string& base)
+{
+  DDStore::reset();
+  nameData = base + ".ddb";
+  nameIndex = base + ".ddx";
+
+  if (! DDStore::exists(base))
+  {
+    FILE * fp = fopen(nameData.c_str(), "wb");
+    if (fp == nullptr)
+      THROW("Could not create " + nameData);
+    fwrite(DDSTORE_MAGIC_DATA, 1, DDSTORE_HEADER, fp);
+    syncFile(fp);
+    fclose(fp);
+  }
+
+  DDStore::remap();
+
+  if (mapIndex.isOpen())
+  {
+    uint64_t l;
+    memcpy(&l, mapIndex.begin() + DDSTORE_HEADER, sizeof(uint64_t));
+    lenIndexed = l;
+  }
+  else
+    lenIndexed = DDSTORE_HEADER;
+
+  DDStore::scanTail();
+}
+
+
+void DDStore::remap()
+{
+  if (! mapData.open(nameData) ||
+      mapData.size() < DDSTORE_HEADER ||
+      memcmp(mapData.begin(), DDSTORE_MAGIC_DATA, DDSTORE_HEADER) != 0)
+    THROW("Not a DD store: " + nameData);
+
+  lenData = mapData.size();
+
+  if (mapIndex.isOpen())
+    return;
+
+  // An index that is damaged or ahead of the data is ignored, and
+  // the records are then found by scanning.
+  if (! mapIndex.open(nameIndex))
+    return;
+
+  const char * p = mapIndex.begin();
+  uint64_t l, count;
+  if (mapIndex.size() < DDSTORE_INDEX_START ||
+      memcmp(p, DDSTORE_MAGIC_INDEX, DDSTORE_HEADER) != 0)
+  {
+    mapIndex.close();
+    return;
+  }
+
+  memcpy(&l, p + DDSTORE_HEADER, sizeof(uint64_t));
+  memcpy(&count, p + DDSTORE_HEADER + sizeof(uint64_t), sizeof(uint64_t));
+  if (l > lenData || 
+      mapIndex.size() != DDSTORE_INDEX_START + count * sizeof(IndexEntry))
+    mapIndex.close();
+}
+
+
+bool DDStore::readRecord(
+  const uint64_t offset,
+  string& key,
+  string& info,
+  uint64_t& next) const
+{
+  const size_t size = mapData.size();
+  if (offset + 2 * sizeof(uint32_t) > size)
+    return false;
+
+  const char * p = mapData.begin() + offset;
+  uint32_t lkey, linfo;
+  memcpy(&lkey, p, sizeof(uint32_t));
+  memcpy(&linfo, p + sizeof(uint32_t), sizeof(uint32_t));
+
+  next = offset + 2 * sizeof(uint32_t) + lkey + linfo;
+  if (next > size)
+    return false;
+
+  p += 2 * sizeof(uint32_t);
+  key.assign(p, lkey);
+  info.assign(p + lkey, linfo);
+  return true;
+}
+
+
+void DDStore::scanTail()
+{
+  uint64_t offset = lenIndexed;
+  uint64_t next;
+  string key, info;
+
+  while (offset < lenData && 
+      DDStore::readRecord(offset, key, info, next))
+  {
+    tail[key] = info;
+    tailIndex.push_back({DDStore::hashKey(key), offset});
+    offset = next;
+  }
+
+  if (offset < lenData)
+  {
+    // A record was only partly written before a crash.
+    mapData.close();
+    truncateFile(nameData, offset);
+    DDStore::remap();
+  }
+}
+
+
+bool DDStore::findIndexed(
+  const string& key,
+  string& info) const
+{
+  if (! mapIndex.isOpen())
+    return false;
+
+  const char * entries = mapIndex.begin() + DDSTORE_INDEX_START;
+  const size_t count = 
+    (mapIndex.size() - DDSTORE_INDEX_START) / sizeof(IndexEntry);
+  const uint64_t h = DDStore::hashKey(key);
+
+  // Find the first entry with this hash.
+  size_t lo = 0, hi = count;
+  IndexEntry ie;
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    memcpy(&ie, entries + mid * sizeof(IndexEntry), sizeof(IndexEntry));
+    if (ie.hash < h)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  string keyRec;
+  uint64_t next;
+  for (size_t i = lo; i < count; i++)
+  {
+    memcpy(&ie, entries + i * sizeof(IndexEntry), sizeof(IndexEntry));
+    if (ie.hash != h)
+      break;
+
+    if (DDStore::readRecord(ie.offset, keyRec, info, next) && 
+        keyRec == key)
+      return true;
+  }
+  return false;
+}
+
+
+bool DDStore::findLocked(
+  const string& key,
+  string& info) const
+{
+  auto it = tail.find(key);
+  if (it != tail.end())
+  {
+    info = it->second;
+    return true;
+  }
+  return DDStore::findIndexed(key, info);
+}
+
+
+bool DDStore::lookup(
+  const string& fname,
+  const string& caseName,
+  string& info) const
+{
+  const string key = DDStore::makeKey(fname, caseName);
+
+  mtx.lock();
+  const bool b = DDStore::findLocked(key, info);
+  mtx.unlock();
+  return b;
+}
+
+
+void DDStore::add(
+  const string& fname,
+  const string& caseName,
+  const string& info)
+{
+  const string key = DDStore::makeKey(fname, caseName);
+  string infoOld;
+
+  lock_guard<mutex> lck(mtx);
+  if (DDStore::findLocked(key, infoOld))
+    THROW("Attempting to reset an existing DD value: " + fname +
+      ", " + caseName);
+
+  const uint64_t offset = lenData + pending.size();
+  const uint32_t lkey = static_cast<uint32_t>(key.size());
+  const uint32_t linfo = static_cast<uint32_t>(info.size());
+
+  pending.append(reinterpret_cast<const char *>(&lkey), sizeof(uint32_t));
+  pending.append(reinterpret_cast<const char *>(&linfo), sizeof(uint32_t));
+  pending += key;
+  pending += info;
+  numPending++;
+
+  tail[key] = info;
+  tailIndex.push_back({DDStore::hashKey(key), offset});
+
+  if (numPending >= DDSTORE_FLUSH_RECORDS)
+    DDStore::flushLocked(tailIndex.size() >= DDSTORE_INDEX_RECORDS);
+}
+
+
+void DDStore::appendPending()
+{
+  if (pending.empty())
+    return;
+
+  FILE * fp = fopen(nameData.c_str(), "ab");
+  if (fp == nullptr)
+    THROW("Could not append to " + nameData);
+
+  const size_t n = fwrite(pending.data(), 1, pending.size(), fp);
+  syncFile(fp);
+  fclose(fp);
+
+  if (n != pending.size())
+    THROW("Could not write " + nameData);
+
+  pending.clear();
+  numPending = 0;
+
+  DDStore::remap();
+}
+
+
+void DDStore::writeIndex()
+{
+  vector<IndexEntry> entries;
+  if (mapIndex.isOpen())
+  {
+    const size_t count = 
+      (mapIndex.size() - DDSTORE_INDEX_START) / sizeof(IndexEntry);
+    entries.resize(count);
+    if (count > 0)
+      memcpy(entries.data(), mapIndex.begin() + DDSTORE_INDEX_START,
+        count * sizeof(IndexEntry));
+  }
+
+  entries.insert(entries.end(), tailIndex.begin(), tailIndex.end());
+  sort(entries.begin(), entries.end());
+
+  // Write a new index next to the old one and then swap them.
+  const string nameTmp = nameIndex + ".tmp";
+  FILE * fp = fopen(nameTmp.c_str(), "wb");
+  if (fp == nullptr)
+    THROW("Could not create " + nameTmp);
+
+  const uint64_t count = entries.size();
+  fwrite(DDSTORE_MAGIC_INDEX, 1, DDSTORE_HEADER, fp);
+  fwrite(&lenData, sizeof(uint64_t), 1, fp);
+  fwrite(&count, sizeof(uint64_t), 1, fp);
+  fwrite(entries.data(), sizeof(IndexEntry), entries.size(), fp);
+  syncFile(fp);
+  fclose(fp);
+
+  mapIndex.close();
+  // POSIX rename() replaces the old index atomically, so a crash
+  // leaves either the old or the new one.  On Windows it does not
+  // replace files, so the old one has to go first.
+#if defined(_WIN32)
+  remove(nameIndex.c_str());
+#endif
+  if (rename(nameTmp.c_str(), nameIndex.c_str()) != 0)
+    THROW("Could not rename " + nameTmp);
+
+  lenIndexed = lenData;
+  tail.clear();
+  tailIndex.clear();
+  DDStore::remap();
+}
+
+
+void DDStore::flushLocked(const bool indexFlag)
+{
+  DDStore::appendPending();
+  if (indexFlag && ! tailIndex.empty())
+    DDStore::writeIndex();
+}
+
+
+void DDStore::flush(const bool indexFlag)
+{
+  lock_guard<mutex> lck(mtx);
+  DDStore::flushLocked(indexFlag);
+}
+
+
+void DDStore::importText(const string& logName)
+{
+  ifstream resstr(logName.c_str());
+  if (! resstr.is_open())
+    return;
+
+  string line, fname;
+  vector<string> tokens(2);
+
+  while (getline(resstr, line))
+  {
+    if (line.empty() || line.front() == '%')
+      continue;
+    
+    if (line.back()  == ':')
+    {
+      fname = line.substr(0, line.size()-1);
+      continue;
+    }
+
+    if (fname == "")
+      THROW("No file is entered in " + logName);
+    
+    if (countDelimiters(line, " ") != 1)
+      THROW("Need exactly one space in line " + line);
+
+    tokens.clear();
+    tokenize(line, tokens, " ");
+    DDStore::add(fname, tokens[0], tokens[1]);
+  }
+
+  resstr.close();
+  DDStore::flush();
+}
+
+
+void DDStore::exportText(const string& logName)
+{
+  map<string, map<string, string>> results;
+
+  {
+    lock_guard<mutex> lck(mtx);
+    DDStore::appendPending();
+
+    uint64_t offset = DDSTORE_HEADER;
+    uint64_t next;
+    string key, info;
+    while (DDStore::readRecord(offset, key, info, next))
+    {
+      const size_t p = key.find('\n');
+      results[key.substr(0, p)][key.substr(p+1)] = info;
+      offset = next;
+    }
+  }
+
+  ofstream dd(logName);
+  for (auto const &itFile: results)
+  {
+    dd << itFile.first << ":\n";
+    for (auto const &itCase: itFile.second)
+      dd << itCase.first << " " << itCase.second << "\n";
+    dd << "\n";
+  }
+  dd.close();
+}
+
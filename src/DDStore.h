@@ -0,0 +1,134 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// DDStore is the on-disk store of DD results for one directory.
+// The data file (.ddb) is append-only, and each record holds an
+// input file name, a case (board or room+board) and the result.
+// The index file (.ddx) is a sorted array of key hashes and record
+// offsets that covers the data file up to a recorded length.  Both
+// are memory-mapped for lookups.  Records beyond the indexed length,
+// whether appended in this run or left by a run that crashed, are 
+// kept in memory until the index is rewritten.
+
+
+#ifndef BRIDGE_DDSTORE_H
+#define BRIDGE_DDSTORE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+#else
+  #include <thread>
+  #include <mutex>
+#endif
+
+#include "MappedFile.h"
+
+using namespace std;
+
+
+class DDStore
+{
+  private:
+
+    struct IndexEntry
+    {
+      uint64_t hash;
+      uint64_t offset;
+
+      bool operator < (const IndexEntry& ie2) const
+      {
+        return (hash < ie2.hash || 
+          (hash == ie2.hash && offset < ie2.offset));
+      }
+    };
+
+    string nameData;
+    string nameIndex;
+
+    MappedFile mapData;
+    MappedFile mapIndex;
+
+    uint64_t lenData; // Durably in the data file
+    uint64_t lenIndexed; // Covered by the index file
+
+    unordered_map<string, string> tail;
+    vector<IndexEntry> tailIndex;
+
+    string pending;
+    unsigned numPending;
+
+    mutable mutex mtx;
+
+
+    static string makeKey(
+      const string& fname,
+      const string& caseName);
+
+    static uint64_t hashKey(const string& key);
+
+    bool readRecord(
+      const uint64_t offset,
+      string& key,
+      string& info,
+      uint64_t& next) const;
+
+    bool findIndexed(
+      const string& key,
+      string& info) const;
+
+    bool findLocked(
+      const string& key,
+      string& info) const;
+
+    void remap();
+
+    void scanTail();
+
+    void appendPending();
+
+    void writeIndex();
+
+    void flushLocked(const bool indexFlag);
+
+
+  public:
+
+    DDStore();
+
+    ~DDStore();
+
+    void reset();
+
+    static bool exists(const string& base);
+
+    void open(const string& base);
+
+    bool lookup(
+      const string& fname,
+      const string& caseName,
+      string& info) const;
+
+    void add(
+      const string& fname,
+      const string& caseName,
+      const string& info);
+
+    void flush(const bool indexFlag = true);
+
+    void importText(const string& logName);
+
+    void exportText(const string& logName);
+};
+
+#endif
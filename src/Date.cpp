@@ -7,12 +7,13 @@
 */
 
 
-#include <iomanip>
 #include <sstream>
 #include <regex>
 
 #include "Date.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -220,6 +221,22 @@ void Date::set(
 }
 
 
+void Date::writeBDB(BDBWriter& bw) const
+{
+  bw.putUnsigned(year);
+  bw.putByte(month);
+  bw.putByte(day);
+}
+
+
+void Date::readBDB(BDBReader& br)
+{
+  year = br.getUnsigned();
+  month = br.getByte();
+  day = br.getByte();
+}
+
+
 bool Date::operator == (const Date& date2) const
 {
   if (year != date2.year)
@@ -246,12 +263,13 @@ string Date::strLIN() const
   if (day == 0 || month == 0 || year == 0)
     return "";
 
-  stringstream s;
-  s <<  
-    setfill('0') << setw(2) << month << "-" <<
-    setfill('0') << setw(2) << day << "-" <<
-    setfill('0') << setw(2) << (year % 100);
-  return s.str();
+  string st;
+  appendUnsigned(st, month, 2, '0');
+  st += "-";
+  appendUnsigned(st, day, 2, '0');
+  st += "-";
+  appendUnsigned(st, year % 100, 2, '0');
+  return st;
 }
 
 
@@ -260,24 +278,32 @@ string Date::strPBN() const
   if (day == 0 && month == 0 && year == 0)
     return "";
 
-  stringstream s;
-  s << "[Date \"";
+  string st = "[Date \"";
   if (year == 0)
-    s << "????.";
+    st += "????.";
   else
-    s << setfill('0') << setw(4) << year << ".";
+  {
+    appendUnsigned(st, year, 4, '0');
+    st += ".";
+  }
 
   if (month == 0)
-    s << "??.";
+    st += "??.";
   else
-    s << setfill('0') << setw(2) << month << ".";
+  {
+    appendUnsigned(st, month, 2, '0');
+    st += ".";
+  }
 
   if (day == 0)
-    s << "??\"]\n";
+    st += "??\"]\n";
   else
-    s << setfill('0') << setw(2) << day << "\"]\n";
+  {
+    appendUnsigned(st, day, 2, '0');
+    st += "\"]\n";
+  }
 
-  return s.str();
+  return st;
 }
 
 
@@ -286,11 +312,12 @@ string Date::strRBNCore() const
   if (month == 0 || year == 0)
     return "";
 
-  stringstream s;
-  s << year << setfill('0') << setw(2) << month;
+  string st;
+  appendUnsigned(st, year);
+  appendUnsigned(st, month, 2, '0');
   if (day > 0)
-    s << day;
-  return s.str();
+    appendUnsigned(st, day);
+  return st;
 }
 
 string Date::strRBN() const
@@ -310,11 +337,16 @@ string Date::strTXT() const
   if (month == 0 || year == 0)
     return "\n";
 
-  stringstream s;
+  string st;
   if (day > 0)
-    s << day << " ";
-  s << DATE_MONTHS[month] << " " << year << "\n";
-  return s.str();
+  {
+    appendUnsigned(st, day);
+    st += " ";
+  }
+  st += DATE_MONTHS[month];
+  st += " ";
+  appendUnsigned(st, year);
+  return st + "\n";
 }
 
 
@@ -17,6 +17,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Date
 {
   private:
@@ -56,6 +60,9 @@ class Date
       const string& text,
       const Format f);
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Date& date2) const;
 
     bool operator != (const Date& date2) const;
@@ -8,38 +8,25 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <cstring>
 #include <algorithm>
 #include <sstream>
 #include <vector>
 #include <map>
 
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.thread.h"
-  #include "mingw.mutex.h"
-#else
-  #include <thread>
-  #include <mutex>
-#endif
-
 #include "Deal.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
-
-static mutex mtx;
+#include "ctable.h"
 
 
 // DDS encoding, but without the two bottom 00 bits: ((2 << 13) - 1)
 
 #define MAX_HOLDING 0x1fff
 
-static const string CARDS[BRIDGE_TRICKS] =
-{
-  "2", "3", "4", "5", "6", "7", "8", "9", "T", "J", "Q", "K", "A"
-};
-
 static const string CARDS_TXT[BRIDGE_TRICKS] =
 {
   "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K", "A"
@@ -47,24 +34,41 @@ static const string CARDS_TXT[BRIDGE_TRICKS] =
 
 
 // Global translation tables that are set once and for all.
-static bool setDealTables = false;
-static string HOLDING_TO_SUIT[MAX_HOLDING+1];
-static string HOLDING_TO_SUIT_TXT[MAX_HOLDING+1];
-static map<string, unsigned> SUIT_TO_HOLDING;
 static map<string, Player> PLAYER_TO_DDS;
 
+// HOLDING_TO_SUIT[h].text is the holding as a string such as "AKT".
+// It is too large to spell out at compile time, so setTables() fills
+// it in once at startup.
+
+static const char CARD_CHARS[BRIDGE_TRICKS+1] = "23456789TJQKA";
+
+struct SuitText
+{
+  char text[BRIDGE_TRICKS+1];
+};
+
+static SuitText HOLDING_TO_SUIT[MAX_HOLDING+1];
+
+// Upper and lower case, so "AKT" and "akt" both work.  This one is
+// fixed at compile time.
+
+static constexpr unsigned charToCard(const unsigned c)
+{
+  return (c >= '2' && c <= '9' ? c - '2' :
+    c == 'T' || c == 't' ? 8 : c == 'J' || c == 'j' ? 9 :
+    c == 'Q' || c == 'q' ? 10 : c == 'K' || c == 'k' ? 11 :
+    c == 'A' || c == 'a' ? 12 : BRIDGE_TRICKS);
+}
+
+static constexpr unsigned CHAR_TO_CARD[256] =
+  { CTABLE_256(charToCard, 0) };
+
+static string holdingToTXT(const unsigned h);
+
 
 Deal::Deal()
 {
   Deal::reset();
-  if (! setDealTables)
-  {
-    mtx.lock();
-    if (! setDealTables)
-      Deal::setTables();
-    setDealTables = true;
-    mtx.unlock();
-  }
 }
 
 
@@ -83,21 +87,13 @@ void Deal::setTables()
 {
   for (unsigned h = 0; h <= MAX_HOLDING; h++)
   {
-    string suit("");
-    string suitTXT("");
+    unsigned k = 0;
     for (int bit = 12; bit >= 0; bit--)
     {
       if (h & static_cast<unsigned>(1 << bit))
-      {
-        suit += CARDS[bit];
-        suitTXT += CARDS_TXT[bit] + " ";
-      }
+        HOLDING_TO_SUIT[h].text[k++] = CARD_CHARS[bit];
     }
-    HOLDING_TO_SUIT[h] = suit;
-    HOLDING_TO_SUIT_TXT[h] = suitTXT;
-    SUIT_TO_HOLDING[suit] = h;
-    reverse(suit.begin(), suit.end());
-    SUIT_TO_HOLDING[suit] = h;
+    HOLDING_TO_SUIT[h].text[k] = '\0';
   }
 
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
@@ -105,6 +101,19 @@ void Deal::setTables()
 }
 
 
+static string holdingToTXT(const unsigned h)
+{
+  // Only used for text output, so it is not worth a table.
+  string suitTXT("");
+  for (int bit = 12; bit >= 0; bit--)
+  {
+    if (h & static_cast<unsigned>(1 << bit))
+      suitTXT += CARDS_TXT[bit] + " ";
+  }
+  return suitTXT;
+}
+
+
 bool Deal::isSet() const
 {
   return setFlag;
@@ -121,40 +130,57 @@ Player Deal::strToPlayer(const string& text) const
 }
 
 
-unsigned Deal::suitToHolding(const string suit) const
+static bool suitToHoldingDirect(
+  const StrView& suit,
+  unsigned& holding)
 {
-  auto it = SUIT_TO_HOLDING.find(suit);
-  if (it == SUIT_TO_HOLDING.end())
+  // The cards must be either in descending or in ascending order.
+  const unsigned l = suit.len;
+  holding = 0;
+  unsigned prev = 0;
+  bool upFlag = false;
+  for (unsigned i = 0; i < l; i++)
   {
-    string suitUpper = suit;
-    toUpper(suitUpper);
-    it = SUIT_TO_HOLDING.find(suitUpper);
-    if (it == SUIT_TO_HOLDING.end())
-      THROW("No such suit: '" + suit + "'");
+    const unsigned bit =
+      CHAR_TO_CARD[static_cast<unsigned char>(suit.text[i])];
+    if (bit == BRIDGE_TRICKS)
+      return false;
+
+    if (i == 1)
+      upFlag = (bit > prev);
+
+    if (i > 0 && (upFlag ? bit <= prev : bit >= prev))
+      return false;
+
+    holding |= (1u << bit);
+    prev = bit;
   }
+  return true;
+}
 
-  return it->second;
+
+unsigned Deal::suitToHolding(const StrView& suit) const
+{
+  unsigned h;
+  if (! suitToHoldingDirect(suit, h))
+    THROW("No such suit: '" + view2str(suit) + "'");
+
+  return h;
 }
 
 
 void Deal::setHand(
-  const string& hand,
+  const StrView& hand,
   const string& delimiters,
   const unsigned offset,
   unsigned pholding[])
 {
-  int seen = 0;
-  for (unsigned i = 0; i < delimiters.length(); i++)
-    seen += static_cast<int>
-      (count(hand.begin(), hand.end(), delimiters.at(i)));
-
-  if (seen != 3 + static_cast<int>(offset))
+  StrView suits[BRIDGE_SUITS+1];
+  unsigned seen;
+  if (! tokenize(hand, suits, BRIDGE_SUITS+offset, seen, delimiters) ||
+      seen != BRIDGE_SUITS + offset)
     THROW("Not the right number of delimiters");
 
-  vector<string> suits(BRIDGE_SUITS+1);
-  suits.clear();
-  tokenize(hand, suits, delimiters);
-
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
     pholding[s] = suitToHolding(suits[s+offset]);
 }
@@ -172,7 +198,7 @@ void Deal::setHandAltVoidSyntax(
     const size_t p0 = hand.find(delimiters.at(s));
     if (p0 == string::npos || p0+1 == hand.length())
     {
-      pholding[s] = suitToHolding("");
+      pholding[s] = suitToHolding(str2view(""));
       continue;
     }
 
@@ -187,10 +213,13 @@ void Deal::setHandAltVoidSyntax(
       }
     }
 
+    StrView suit = str2view(hand);
+    suit.text += p0+1;
     if (p1 == string::npos)
-      pholding[s] = suitToHolding(hand.substr(p0+1));
+      suit.len -= static_cast<unsigned>(p0+1);
     else
-      pholding[s] = suitToHolding(hand.substr(p0+1, p1-p0-1));
+      suit.len = static_cast<unsigned>(p1-p0-1);
+    pholding[s] = suitToHolding(suit);
   }
 }
 
@@ -202,7 +231,7 @@ void Deal::setHands()
     unsigned sum = 0, xsum = 0;
     for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
     {
-      strcpy(cards[p][s], HOLDING_TO_SUIT[holding[p][s]].c_str());
+      strcpy(cards[p][s], HOLDING_TO_SUIT[holding[p][s]].text);
       sum += holding[p][s];
       xsum ^= holding[p][s];
     }
@@ -218,9 +247,9 @@ void Deal::setLIN(const string& text)
   if (c != 2 && c != 3)
     THROW("Not 2 or 3 commas");
 
-  vector<string> tokens(BRIDGE_PLAYERS);
-  tokens.clear();
-  tokenize(text, tokens, ",");
+  StrView tokens[BRIDGE_PLAYERS];
+  unsigned numTokens;
+  tokenize(str2view(text), tokens, BRIDGE_PLAYERS, numTokens, ",");
 
   // Last is derived, not given (it is re-derived even if given).
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
@@ -236,7 +265,8 @@ void Deal::setLIN(const string& text)
     else if (numDelim == 4)
       Deal::setHand(tokens[plin], "SHDC", 1, holding[p]);
     else
-      Deal::setHandAltVoidSyntax(tokens[plin], "SHDC", holding[p]);
+      Deal::setHandAltVoidSyntax(view2str(tokens[plin]), "SHDC",
+        holding[p]);
 
     for (unsigned s = 0; s < BRIDGE_SUITS; s++)
       holding[PLAYER_LIN_TO_DDS[3]][s] ^= holding[p][s];
@@ -251,11 +281,11 @@ void Deal::setPBN(const string& text)
   if (countDelimiters(text, ": ") != 4)
     THROW("Not 4 space delimiters in '" + text + "'");
 
-  vector<string> tokens(BRIDGE_PLAYERS+1);
-  tokens.clear();
-  tokenize(text, tokens, ": ");
+  StrView tokens[BRIDGE_PLAYERS+1];
+  unsigned numTokens;
+  tokenize(str2view(text), tokens, BRIDGE_PLAYERS+1, numTokens, ": ");
 
-  const Player first = strToPlayer(tokens[0]);
+  const Player first = strToPlayer(view2str(tokens[0]));
 
   for (unsigned pno = 0; pno < BRIDGE_PLAYERS; pno++)
   {
@@ -276,11 +306,11 @@ void Deal::setRBN(const string& text)
   if (c != 3 && c != 4)
     THROW("Not 3 or 4 colons");
 
-  vector<string> tokens(BRIDGE_PLAYERS+1);
-  tokens.clear();
-  tokenize(text, tokens, ":");
+  StrView tokens[BRIDGE_PLAYERS+1];
+  unsigned numTokens;
+  tokenize(str2view(text), tokens, BRIDGE_PLAYERS+1, numTokens, ":");
 
-  const Player first = strToPlayer(tokens[0]);
+  const Player first = strToPlayer(view2str(tokens[0]));
   const unsigned firstU = static_cast<unsigned>(first);
 
   // Last is derived, not given (it is re-derived even if given).
@@ -376,10 +406,12 @@ Player Deal::holdsCard(const string& text) const
   if (! found)
     return BRIDGE_PLAYER_SIZE;
 
-  auto it = SUIT_TO_HOLDING.find(text.substr(1));
-  if (it == SUIT_TO_HOLDING.end())
+  // Only upper case here.
+  const char cc = text.at(1);
+  const unsigned bit = CHAR_TO_CARD[static_cast<unsigned char>(cc)];
+  if (bit == BRIDGE_TRICKS || (cc >= 'a' && cc <= 'z'))
     return BRIDGE_PLAYER_SIZE;
-  h = it->second;
+  h = (1u << bit);
 
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
   {
@@ -401,6 +433,71 @@ void Deal::getDDS(unsigned holdingArg[][BRIDGE_SUITS]) const
 }
 
 
+static uint64_t mixFingerprint(uint64_t h)
+{
+  // The finalizer of MurmurHash3.
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+
+uint64_t Deal::fingerprint() const
+{
+  // Each hand fits losslessly in 52 bits, and the four hands are
+  // mixed in turn.  Two deals differ in some card exactly when their
+  // words differ, so only a true 64-bit collision can confuse them.
+  if (! setFlag)
+    return 0;
+
+  uint64_t h = 0x9e3779b97f4a7c15ull;
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+  {
+    uint64_t w = 0;
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+      w = (w << BRIDGE_TRICKS) | holding[p][s];
+    h = mixFingerprint(h ^ w);
+  }
+  return h;
+}
+
+
+void Deal::writeBDB(BDBWriter& bw) const
+{
+  bw.putBool(setFlag);
+  if (! setFlag)
+    return;
+
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+      bw.putHolding(holding[p][s]);
+}
+
+
+void Deal::readBDB(BDBReader& br)
+{
+  Deal::reset();
+  if (! br.getBool())
+    return;
+
+  setFlag = true;
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+  {
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+    {
+      holding[p][s] = br.getHolding();
+      if (holding[p][s] >= (1u << BRIDGE_TRICKS))
+        THROW("Bad holding: " + STR(holding[p][s]));
+    }
+  }
+
+  Deal::setHands();
+}
+
+
 bool Deal::operator == (const Deal& deal2) const
 {
   if (setFlag != deal2.setFlag)
@@ -424,222 +521,249 @@ bool Deal::operator != (const Deal& deal2) const
 }
 
 
-string Deal::strLINReverse(const Player start) const
+void Deal::appendHandDots(
+  string& st,
+  const unsigned player) const
+{
+  st += cards[player][BRIDGE_SPADES];
+  st += ".";
+  st += cards[player][BRIDGE_HEARTS];
+  st += ".";
+  st += cards[player][BRIDGE_DIAMONDS];
+  st += ".";
+  st += cards[player][BRIDGE_CLUBS];
+}
+
+
+void Deal::appendSuit(
+  string& st,
+  const unsigned player,
+  const unsigned suit,
+  const unsigned width) const
+{
+  // The suit letter and a space, then the cards left-aligned in width.
+  st += DENOM_NAMES_SHORT[suit];
+  st += " ";
+  const size_t start = st.length();
+  st += cards[player][suit];
+  padTo(st, start, width);
+}
+
+
+void Deal::appendSuitLine(
+  string& st,
+  const unsigned indent,
+  const unsigned player,
+  const unsigned suit) const
+{
+  appendSpaces(st, indent);
+  st += DENOM_NAMES_SHORT[suit];
+  st += " ";
+  st += cards[player][suit];
+  st += "\n";
+}
+
+
+void Deal::appendLINReverse(
+  string& st,
+  const Player start) const
 {
   // This is an evil hack to get the cards printed in reverse order
   // while leaving everything else in the correct order.
   // Players are always in same order.
 
-  stringstream ss;
-  ss << ",";
+  const size_t begin = st.length();
+  st += ",";
   for (unsigned p = 0; p <= 2; p++)
   {
     unsigned pdds = (4-p) % 4;
-    ss << cards[pdds][BRIDGE_CLUBS] << "C" <<
-         cards[pdds][BRIDGE_DIAMONDS] << "D" <<
-         cards[pdds][BRIDGE_HEARTS] << "H" <<
-         cards[pdds][BRIDGE_SPADES] << "S";
+    st += cards[pdds][BRIDGE_CLUBS];
+    st += "C";
+    st += cards[pdds][BRIDGE_DIAMONDS];
+    st += "D";
+    st += cards[pdds][BRIDGE_HEARTS];
+    st += "H";
+    st += cards[pdds][BRIDGE_SPADES];
+    st += "S";
     if (p < 2)
-      ss << ",";
+      st += ",";
   }
-  ss << PLAYER_DDS_TO_LIN_DEALER[start] << "|dm";
+  appendUnsigned(st, PLAYER_DDS_TO_LIN_DEALER[start]);
+  st += "|dm";
 
-  string st = ss.str();
-  return string(st.rbegin(), st.rend()) + "|";
+  reverse(st.begin() + static_cast<ptrdiff_t>(begin), st.end());
+  st += "|";
 }
 
 
-string Deal::strLINRegular(
+void Deal::appendLINRegular(
+  string& st,
   const Player start,
   const unsigned limit) const
 {
-  stringstream ss;
-  ss << "md|" << PLAYER_DDS_TO_LIN_DEALER[start];
+  st += "md|";
+  appendUnsigned(st, PLAYER_DDS_TO_LIN_DEALER[start]);
   
   // Players are always in same order.
   for (unsigned p = 0; p < limit; p++)
   {
     unsigned pdds = PLAYER_LIN_TO_DDS[p];
     for (unsigned d = 0; d < BRIDGE_SUITS; d++)
-      ss << DENOM_NAMES_SHORT[d] << cards[pdds][d];
+    {
+      st += DENOM_NAMES_SHORT[d];
+      st += cards[pdds][d];
+    }
     if (p != limit-1)
-      ss << ",";
+      st += ",";
   }
     
-  return ss.str() + "|";
+  st += "|";
 }
 
 
-string Deal::strPBN(const Player start) const
+void Deal::appendPBN(
+  string& st,
+  const Player start) const
 {
-  stringstream ss;
-  ss << "[Deal \"" << PLAYER_NAMES_SHORT[start] << ":";
+  st += "[Deal \"";
+  st += PLAYER_NAMES_SHORT[start];
+  st += ":";
 
   // Players start from dealer.
   for (unsigned pno = 0; pno < BRIDGE_PLAYERS; pno++)
   {
     unsigned p = (static_cast<unsigned>(start) + pno) % 4;
-    ss << cards[p][BRIDGE_SPADES] << "." <<
-         cards[p][BRIDGE_HEARTS] << "." <<
-         cards[p][BRIDGE_DIAMONDS] << "." <<
-         cards[p][BRIDGE_CLUBS];
+    Deal::appendHandDots(st, p);
     if (pno < 3)
-      ss << " ";
+      st += " ";
   }
-  return ss.str() + "\"]\n";
+  st += "\"]\n";
 }
 
 
-string Deal::strRBNCore(const Player start) const
+void Deal::appendRBNCore(
+  string& st,
+  const Player start) const
 {
-  stringstream ss;
-  ss << PLAYER_NAMES_SHORT[start] << ":";
+  st += PLAYER_NAMES_SHORT[start];
+  st += ":";
 
   // Players start from here.
   for (unsigned pno = 0; pno <= 2; pno++)
   {
     unsigned p = (static_cast<unsigned>(start) + pno) % 4;
-    ss << cards[p][BRIDGE_SPADES] << "." <<
-         cards[p][BRIDGE_HEARTS] << "." <<
-         cards[p][BRIDGE_DIAMONDS] << "." <<
-         cards[p][BRIDGE_CLUBS] << ":";
+    Deal::appendHandDots(st, p);
+    st += ":";
   }
-  return ss.str();
-}
-
-
-string Deal::strRBN(const Player start) const
-{
-  return "H " + Deal::strRBNCore(start) + "\n";
-}
-
-
-string Deal::strRBX(const Player start) const
-{
-  return "H{" + Deal::strRBNCore(start) + "}";
 }
 
 
 string Deal::strTXT() const
 {
-  stringstream sstop;
-  stringstream ssbot;
+  string st, stbot;
 
-  sstop << setw(14) << "" << "North\n";
-  ssbot << setw(14) << "" << "South\n";
+  appendSpaces(st, 14);
+  st += "North\n";
+  appendSpaces(stbot, 14);
+  stbot += "South\n";
 
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
   {
     const string cn = (holding[BRIDGE_NORTH][s] == 0 ? 
-      "--" : HOLDING_TO_SUIT_TXT[holding[BRIDGE_NORTH][s]]);
+      "--" : holdingToTXT(holding[BRIDGE_NORTH][s]));
     const string cs = (holding[BRIDGE_SOUTH][s] == 0 ? 
-      "--" : HOLDING_TO_SUIT_TXT[holding[BRIDGE_SOUTH][s]]);
-    sstop << setw(12) << "" <<
-      DENOM_NAMES_SHORT_PBN[s] << " " << left << cn << "\n";
-    ssbot << setw(12) << "" <<
-      DENOM_NAMES_SHORT_PBN[s] << " " << left << cs << "\n";
+      "--" : holdingToTXT(holding[BRIDGE_SOUTH][s]));
+    appendSpaces(st, 12);
+    st += DENOM_NAMES_SHORT_PBN[s] + " " + cn + "\n";
+    appendSpaces(stbot, 12);
+    stbot += DENOM_NAMES_SHORT_PBN[s] + " " + cs + "\n";
   }
 
-  sstop << "  West" << setw(20) << "" << "East\n";
+  st += "  West";
+  appendSpaces(st, 20);
+  st += "East\n";
 
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
   {
     const string cw = (holding[BRIDGE_WEST][s] == 0 ? 
-      "--" : HOLDING_TO_SUIT_TXT[holding[BRIDGE_WEST][s]]);
+      "--" : holdingToTXT(holding[BRIDGE_WEST][s]));
     const string ce = (holding[BRIDGE_EAST][s] == 0 ? 
-      "--" : HOLDING_TO_SUIT_TXT[holding[BRIDGE_EAST][s]]);
+      "--" : holdingToTXT(holding[BRIDGE_EAST][s]));
 
-    sstop << left << DENOM_NAMES_SHORT_PBN[s] << " " << 
-        setw(22) << left << cw <<
-        DENOM_NAMES_SHORT_PBN[s] << " " <<
-        left << ce << "\n";
+    st += DENOM_NAMES_SHORT_PBN[s] + " ";
+    appendLeft(st, cw, 22);
+    st += DENOM_NAMES_SHORT_PBN[s] + " " + ce + "\n";
   }
 
-  return sstop.str() + ssbot.str();
+  return st + stbot;
 }
 
 
 string Deal::strEML() const
 {
-  stringstream ss;
-  ss << setw(12) << "" << "north\n\n";
+  string st;
+  appendSpaces(st, 12);
+  st += "north\n\n";
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
-  {
-    ss << setw(12) << "" << DENOM_NAMES_SHORT[s] << " " <<
-      cards[BRIDGE_NORTH][s] << "\n";
-  }
+    Deal::appendSuitLine(st, 12, BRIDGE_NORTH, s);
 
-  ss << setw(23) << left << "west" << "east\n\n";
+  appendLeft(st, "west", 23);
+  st += "east\n\n";
 
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
   {
-    ss << DENOM_NAMES_SHORT[s] << " " << setw(21) << left << 
-      cards[BRIDGE_WEST][s] <<
-      DENOM_NAMES_SHORT[s] << " " << setw(13) << left <<
-      cards[BRIDGE_EAST][s] << "\n";
+    Deal::appendSuit(st, BRIDGE_WEST, s, 21);
+    Deal::appendSuit(st, BRIDGE_EAST, s, 13);
+    st += "\n";
   }
 
-  ss << setw(12) << "" << "south\n\n";
+  appendSpaces(st, 12);
+  st += "south\n\n";
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
-  {
-    ss << setw(12) << "" << DENOM_NAMES_SHORT[s] << " " <<
-      cards[BRIDGE_SOUTH][s] << "\n";
-  }
-  return ss.str();
+    Deal::appendSuitLine(st, 12, BRIDGE_SOUTH, s);
+  return st;
 }
 
 
-string Deal::strRECDetail(
+void Deal::appendRECDetail(
+  string& st,
   const Player midPlayer,
   const unsigned LRsuit,
   const unsigned mSuit) const
 {
-  stringstream ss;
-
-  ss << DENOM_NAMES_SHORT[LRsuit] << " " << setw(10) << left <<
-      cards[BRIDGE_WEST][LRsuit];
-
-  ss << DENOM_NAMES_SHORT[mSuit] << " " << setw(10) << left <<
-      cards[midPlayer][mSuit];
-
-  ss << DENOM_NAMES_SHORT[LRsuit] << " " << setw(10) << left <<
-      cards[BRIDGE_EAST][LRsuit];
-  
-  return ss.str();
+  Deal::appendSuit(st, BRIDGE_WEST, LRsuit, 10);
+  Deal::appendSuit(st, midPlayer, mSuit, 10);
+  Deal::appendSuit(st, BRIDGE_EAST, LRsuit, 10);
 }
 
 string Deal::strREC() const
 {
-  stringstream ss;
-  ss <<  "\n";
+  string st = "\n";
   for (unsigned s = 0; s < BRIDGE_SUITS-1; s++)
-    ss << setw(12) << "" << DENOM_NAMES_SHORT[s] << " " <<
-      cards[BRIDGE_NORTH][s] << "\n";
+    Deal::appendSuitLine(st, 12, BRIDGE_NORTH, s);
 
-  ss << Deal::strRECDetail(BRIDGE_NORTH, BRIDGE_SPADES, BRIDGE_CLUBS) << 
-    "\n";
+  Deal::appendRECDetail(st, BRIDGE_NORTH, BRIDGE_SPADES, BRIDGE_CLUBS);
+  st += "\n";
 
   for (unsigned s = 1; s < BRIDGE_SUITS-1; s++)
   {
-    ss << DENOM_NAMES_SHORT[s] << " " << setw(22) << left <<
-        cards[BRIDGE_WEST][s];
-
-    ss << DENOM_NAMES_SHORT[s] << " " << setw(10) << left <<
-        cards[BRIDGE_EAST][s] << "\n";
+    Deal::appendSuit(st, BRIDGE_WEST, s, 22);
+    Deal::appendSuit(st, BRIDGE_EAST, s, 10);
+    st += "\n";
   }
 
-  ss << Deal::strRECDetail(BRIDGE_SOUTH, BRIDGE_CLUBS, BRIDGE_SPADES) << 
-    "\n";
+  Deal::appendRECDetail(st, BRIDGE_SOUTH, BRIDGE_CLUBS, BRIDGE_SPADES);
+  st += "\n";
 
   for (unsigned s = 1; s < BRIDGE_SUITS; s++)
-    ss << setw(12) << "" << DENOM_NAMES_SHORT[s] << " " <<
-      cards[BRIDGE_SOUTH][s] << "\n";
+    Deal::appendSuitLine(st, 12, BRIDGE_SOUTH, s);
 
-  return ss.str();
+  return st;
 }
 
 
-string Deal::str(
+void Deal::appendStr(
+  string& st,
   const Player start,
   const Format format) const
 {
@@ -650,34 +774,60 @@ string Deal::str(
   {
     case BRIDGE_FORMAT_LIN:
     case BRIDGE_FORMAT_LIN_TRN:
-      return "st||" + Deal::strLINReverse(start) + "rh||";
+      st += "st||";
+      Deal::appendLINReverse(st, start);
+      st += "rh||";
+      break;
 
     case BRIDGE_FORMAT_LIN_VG:
-      return "st||" + Deal::strLINRegular(start, BRIDGE_PLAYERS);
+      st += "st||";
+      Deal::appendLINRegular(st, start, BRIDGE_PLAYERS);
+      break;
 
     case BRIDGE_FORMAT_LIN_RP:
-      return Deal::strLINRegular(start, BRIDGE_PLAYERS-1);
+      Deal::appendLINRegular(st, start, BRIDGE_PLAYERS-1);
+      break;
 
     case BRIDGE_FORMAT_PBN:
-      return Deal::strPBN(start);
+      Deal::appendPBN(st, start);
+      break;
 
     case BRIDGE_FORMAT_RBN:
-      return Deal::strRBN(start);
+      st += "H ";
+      Deal::appendRBNCore(st, start);
+      st += "\n";
+      break;
 
     case BRIDGE_FORMAT_RBX:
-      return Deal::strRBX(start);
+      st += "H{";
+      Deal::appendRBNCore(st, start);
+      st += "}";
+      break;
 
     case BRIDGE_FORMAT_TXT:
-      return Deal::strTXT();
+      st += Deal::strTXT();
+      break;
 
     case BRIDGE_FORMAT_EML:
-      return Deal::strEML();
+      st += Deal::strEML();
+      break;
 
     case BRIDGE_FORMAT_REC:
-      return Deal::strREC();
+      st += Deal::strREC();
+      break;
 
     default:
       THROW("Deal format not implemented: " + STR(format));
   }
 }
 
+
+string Deal::str(
+  const Player start,
+  const Format format) const
+{
+  string st;
+  Deal::appendStr(st, start, format);
+  return st;
+}
+
@@ -11,12 +11,18 @@
 #define BRIDGE_DEAL_H
 
 #include <string>
+#include <cstdint>
 
 #include "bconst.h"
 
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+struct StrView;
+
+
 class Deal
 {
   private:
@@ -26,14 +32,12 @@ class Deal
     char cards[BRIDGE_PLAYERS][BRIDGE_SUITS][BRIDGE_TRICKS];
 
 
-    void setTables();
-
     Player strToPlayer(const string& s) const;
 
-    unsigned suitToHolding(const string suit) const;
+    unsigned suitToHolding(const StrView& suit) const;
 
     void setHand(
-      const string& hand,
+      const StrView& hand,
       const string& delimiters,
       const unsigned offset,
       unsigned pholding[]);
@@ -49,17 +53,37 @@ class Deal
     void setPBN(const string& text);
     void setRBN(const string& text);
 
-    string strLINReverse(const Player start) const;
-    string strLINRegular(
+    void appendHandDots(
+      string& st,
+      const unsigned player) const;
+    void appendSuit(
+      string& st,
+      const unsigned player,
+      const unsigned suit,
+      const unsigned width) const;
+    void appendSuitLine(
+      string& st,
+      const unsigned indent,
+      const unsigned player,
+      const unsigned suit) const;
+
+    void appendLINReverse(
+      string& st,
+      const Player start) const;
+    void appendLINRegular(
+      string& st,
       const Player start,
       const unsigned limit) const;
-    string strPBN(const Player start) const;
-    string strRBNCore(const Player start) const;
-    string strRBN(const Player start) const;
-    string strRBX(const Player start) const;
+    void appendPBN(
+      string& st,
+      const Player start) const;
+    void appendRBNCore(
+      string& st,
+      const Player start) const;
     string strTXT() const;
     string strEML() const;
-    string strRECDetail(
+    void appendRECDetail(
+      string& st,
       const Player midPlayer,
       const unsigned LRsuit,
       const unsigned mSuit) const;
@@ -72,6 +96,8 @@ class Deal
 
     ~Deal();
 
+    static void setTables();
+
     void reset();
 
     bool isSet() const;
@@ -86,9 +112,20 @@ class Deal
 
     void getDDS(unsigned cards[][BRIDGE_SUITS]) const;
 
+    uint64_t fingerprint() const;
+
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Deal& deal2) const;
     bool operator != (const Deal& deal2) const;
 
+    // The file writers append straight onto their output text.
+    void appendStr(
+      string& st,
+      const Player start,
+      const Format format) const;
+
     string str(
       const Player start,
       const Format format) const;
@@ -9,10 +9,12 @@
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 #include "DuplStat.h"
 #include "Group.h"
 #include "RefLines.h"
+#include "PlayerNames.h"
 #include "parse.h"
 #include "Bexcept.h"
 
@@ -50,22 +52,27 @@ void DuplStat::reset()
 void DuplStat::extractPlayers()
 {
   playersFlag = true;
-  tokenize(players, pnames, ",");
+  vector<string> tokens;
+  tokenize(players, tokens, ",");
 
-  if (pnames.size() & 0x3)
-    return;
-
-  for (unsigned i = 0; i < pnames.size(); i += 4)
+  if ((tokens.size() & 0x3) == 0)
   {
-    if (pnames[i] == "north")
-      pnames[i] = "";
-    if (pnames[i+1] == "east")
-      pnames[i+1] = "";
-    if (pnames[i+2] == "south")
-      pnames[i+2] = "";
-    if (pnames[i+3] == "west")
-      pnames[i+3] = "";
+    for (unsigned i = 0; i < tokens.size(); i += 4)
+    {
+      if (tokens[i] == "north")
+        tokens[i] = "";
+      if (tokens[i+1] == "east")
+        tokens[i+1] = "";
+      if (tokens[i+2] == "south")
+        tokens[i+2] = "";
+      if (tokens[i+3] == "west")
+        tokens[i+3] = "";
+    }
   }
+
+  pnames.resize(tokens.size());
+  for (unsigned i = 0; i < tokens.size(); i++)
+    pnames[i] = PlayerNames::intern(tokens[i]);
 }
 
 
@@ -123,19 +130,75 @@ void DuplStat::set(
 }
 
 
-void DuplStat::append(const int hashVal)
+void DuplStat::append(const uint64_t fingerprint)
 {
-  values.push_back(static_cast<unsigned>(hashVal));
+  values.push_back(fingerprint);
 }
 
 
 void DuplStat::sort()
 {
-  values.sort();
+  std::sort(values.begin(), values.end());
+}
+
+
+void DuplStat::serialize(ostream& fout) const
+{
+  writeField(fout, fname);
+  writeField(fout, basename);
+  writeField(fout, static_cast<unsigned>(format));
+  writeField(fout, segTitle);
+  writeField(fout, segDate);
+  writeField(fout, segLocation);
+  writeField(fout, segEvent);
+  writeField(fout, segSession);
+  writeField(fout, teams);
+  writeField(fout, players);
+  writeField(fout, segNoVal);
+  writeField(fout, segSize);
+  writeField(fout, numLines);
+  writeField(fout, numHands);
+  writeField(fout, numBoards);
+
+  writeField(fout, static_cast<unsigned>(values.size()));
+  for (auto v: values)
+    writeField(fout, v);
+}
+
+
+void DuplStat::deserialize(istream& fin)
+{
+  DuplStat::reset();
+
+  unsigned u;
+  readField(fin, fname);
+  readField(fin, basename);
+  readField(fin, u);
+  format = static_cast<Format>(u);
+  readField(fin, segTitle);
+  readField(fin, segDate);
+  readField(fin, segLocation);
+  readField(fin, segEvent);
+  readField(fin, segSession);
+  readField(fin, teams);
+  readField(fin, players);
+  readField(fin, segNoVal);
+  readField(fin, segSize);
+  readField(fin, numLines);
+  readField(fin, numHands);
+  readField(fin, numBoards);
+
+  DuplStat::extractPlayers();
+
+  unsigned n;
+  readField(fin, n);
+  values.resize(n);
+  for (unsigned i = 0; i < n; i++)
+    readField(fin, values[i]);
 }
 
 
-unsigned DuplStat::first() const
+uint64_t DuplStat::first() const
 {
   if (values.size() == 0)
     THROW("List is empty");
@@ -143,6 +206,12 @@ unsigned DuplStat::first() const
 }
 
 
+const vector<uint64_t>& DuplStat::fingerprints() const
+{
+  return values;
+}
+
+
 bool DuplStat::sameOrigin(const DuplStat& ds2) const
 {
   if (basename == "")
@@ -151,6 +220,14 @@ bool DuplStat::sameOrigin(const DuplStat& ds2) const
 }
 
 
+bool DuplStat::sameDeals(const DuplStat& ds2) const
+{
+  return (numHands == ds2.numHands &&
+    numBoards == ds2.numBoards &&
+    values == ds2.values);
+}
+
+
 bool DuplStat::similarPlayerGroup(
   const DuplStat& ds2,
   const unsigned number,
@@ -161,22 +238,15 @@ bool DuplStat::similarPlayerGroup(
 
   for (unsigned i = 0; i < number; i++)
   {
-    const int l1 = static_cast<int>(pnames[i].length());
-    const int l2 = static_cast<int>(ds2.pnames[ds2offset+i].length());
+    const unsigned id1 = pnames[i];
+    const unsigned id2 = ds2.pnames[ds2offset+i];
 
-    if (l1 == 0 || l2 == 0)
+    if (id1 == 0 || id2 == 0)
       continue;
-    else if (abs(l1-l2) > 2 || 
-        ! levenshtein_test(pnames[i], ds2.pnames[ds2offset+i], 2))
-    {
-      actual++;
-      continue;
-    }
-    else
-    {
-      actual++;
+
+    actual++;
+    if (PlayerNames::similar(id1, id2))
       similar++;
-    }
   }
 
   // 4: Need 3.
@@ -223,15 +293,12 @@ bool DuplStat::similarPlayers(const DuplStat& ds2) const
 bool DuplStat::lexLessThan(const DuplStat& ds2) const
 {
   // First by list, then by length, then by basename, then by format.
+  // Equal lists are next to each other.
 
-  for (auto it1 = values.cbegin(), it2 = ds2.values.cbegin();
-      it1 != values.cend() && it2 != ds2.values.cend(); it1++, it2++)
-  {
-    if (*it1 < *it2)
-      return true;
-    if (*it1 > *it2)
-      return false;
-  }
+  if (values < ds2.values)
+    return true;
+  if (ds2.values < values)
+    return false;
 
   if (numHands < ds2.numHands)
     return true;
@@ -254,20 +321,13 @@ bool DuplStat::lexLessThan(const DuplStat& ds2) const
 
 bool DuplStat::operator == (const DuplStat& ds2) const
 {
-  if (numHands != ds2.numHands || numBoards != ds2.numBoards)
+  if (! DuplStat::sameDeals(ds2))
     return false;
 
   // Could also just compare (teams != ds2.teams)
   if (levenshtein(teams, ds2.teams) > 2)
     return false;
 
-  for (auto it1 = values.cbegin(), it2 = ds2.values.cbegin();
-      it1 != values.cend() && it2 != ds2.values.cend(); it1++, it2++)
-  {
-    if (*it1 != *it2)
-      return false;
-  }
-
   if (! DuplStat::similarPlayers(ds2))
     return false;
 
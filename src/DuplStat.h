@@ -11,7 +11,8 @@
 #define BRIDGE_DUPLSTAT_H
 
 #include <iostream>
-#include <list>
+#include <vector>
+#include <cstdint>
 
 #include "bconst.h"
 
@@ -44,13 +45,14 @@ class DuplStat
     unsigned segSize;
 
     bool playersFlag;
-    vector<string> pnames;
+    vector<unsigned> pnames; // Interned in PlayerNames
 
     unsigned numLines;
     unsigned numHands;
     unsigned numBoards;
     
-    list<unsigned> values;
+    // The fingerprints of the deals, sorted.
+    vector<uint64_t> values;
 
     void extractPlayers();
 
@@ -80,13 +82,20 @@ class DuplStat
       const unsigned segNo,
       const RefLines * reflines);
 
-    void append(const int hashVal);
+    void append(const uint64_t fingerprint);
 
     void sort();
 
-    unsigned first() const;
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
+
+    uint64_t first() const;
+
+    const vector<uint64_t>& fingerprints() const;
 
     bool sameOrigin(const DuplStat& ds2) const;
+    bool sameDeals(const DuplStat& ds2) const;
     bool lexLessThan(const DuplStat& ds2) const;
     bool operator ==(const DuplStat& ds2) const;
     bool operator <=(const DuplStat& ds2) const;
@@ -9,13 +9,15 @@
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 #include "DuplStats.h"
 #include "Group.h"
 #include "RefLines.h"
+#include "parse.h"
 #include "Bexcept.h"
 
-#define HASH_SIZE 4096 // Relies on <= 12-bit hash values
+#define MINHASH_SEED 0x9e3779b97f4a7c15ull
 
 
 DuplStats::DuplStats()
@@ -32,10 +34,11 @@ DuplStats::~DuplStats()
 void DuplStats::reset()
 {
   statList.clear();
-  hashedList.clear();
+  sortedList.clear();
   activeList = nullptr;
 
-  hashedList.resize(HASH_SIZE);
+  lshBands = 0;
+  lshRows = 0;
 }
 
 
@@ -52,12 +55,12 @@ void DuplStats::set(
 }
 
 
-void DuplStats::append(const int hashVal)
+void DuplStats::append(const uint64_t fingerprint)
 {
   if (activeList == nullptr)
     THROW("No active list");
 
-  activeList->stat.append(hashVal);
+  activeList->stat.append(fingerprint);
 }
 
 
@@ -67,60 +70,95 @@ void DuplStats::sortActive()
     THROW("No active list");
 
   activeList->stat.sort();
+  sortedList.push_back(activeList);
+}
+
 
-  unsigned f = activeList->stat.first();
-  hashedList[f].push_back(activeList);
+void DuplStats::setLSH(
+  const unsigned bands,
+  const unsigned rows)
+{
+  lshBands = bands;
+  lshRows = rows;
 }
 
 
 void DuplStats::operator += (const DuplStats& dupl2)
 {
-  for (unsigned i = 0; i < HASH_SIZE; i++)
-    for (unsigned j = 0; j < dupl2.hashedList[i].size(); j++)
-      hashedList[i].push_back(dupl2.hashedList[i][j]);
+  sortedList.insert(sortedList.end(),
+    dupl2.sortedList.begin(), dupl2.sortedList.end());
 }
 
 
-void DuplStats::sortOverall()
+void DuplStats::serialize(ostream& fout) const
+{
+  // Only the sorted entries take part in the comparisons.
+  writeField(fout, static_cast<unsigned>(sortedList.size()));
+  for (auto elem: sortedList)
+    elem->stat.serialize(fout);
+}
+
+
+void DuplStats::deserialize(istream& fin)
 {
-  for (unsigned i = 0; i < HASH_SIZE; i++)
+  // Unlike +=, this copies the entries, so the source need not
+  // outlive us.
+  unsigned n;
+  readField(fin, n);
+  for (unsigned i = 0; i < n; i++)
   {
-    sort(hashedList[i].begin(), hashedList[i].end(),
-      [](const DuplElem * a, const DuplElem * b)->bool
-      {
-        return a->stat.lexLessThan(b->stat);
-      });
+    statList.emplace_back(DuplElem());
+    DuplElem& elem = statList.back();
+    elem.activeFlag = false;
+    elem.stat.deserialize(fin);
+    sortedList.push_back(&elem);
   }
 }
 
 
+void DuplStats::sortOverall()
+{
+  sort(sortedList.begin(), sortedList.end(),
+    [](const DuplElem * a, const DuplElem * b)->bool
+    {
+      return a->stat.lexLessThan(b->stat);
+    });
+}
+
+
 string DuplStats::strSame() const
 {
+  // Only segments with the same deals can be duplicates, and these
+  // form runs in the sorted list.
   string st;
-  for (unsigned i = 0; i < HASH_SIZE; i++)
+  const unsigned n = sortedList.size();
+  unsigned start = 0;
+  while (start < n)
   {
-    const unsigned lh = hashedList[i].size();
-    if (lh == 0)
-      continue;
-    for (unsigned j = 0; j < lh-1; j++)
+    unsigned end = start+1;
+    while (end < n &&
+        sortedList[end]->stat.sameDeals(sortedList[start]->stat))
+      end++;
+
+    for (unsigned j = start; j+1 < end; j++)
     {
-      if (! hashedList[i][j]->activeFlag)
+      if (! sortedList[j]->activeFlag)
         continue;
 
-      if (hashedList[i][j]->stat.sameOrigin(hashedList[i][j+1]->stat))
+      if (sortedList[j]->stat.sameOrigin(sortedList[j+1]->stat))
       {
         // Pavlicek files with the same origin: Take the first one.
-        hashedList[i][j]->activeFlag = false;
+        sortedList[j]->activeFlag = false;
         continue;
       }
 
-      for (unsigned k = j+1; k < lh; k++)
+      for (unsigned k = j+1; k < end; k++)
       {
-        if (! hashedList[i][k]->activeFlag)
+        if (! sortedList[k]->activeFlag)
           continue;
         
-        const DuplStat& stat1 = hashedList[i][j]->stat;
-        const DuplStat& stat2 = hashedList[i][k]->stat;
+        const DuplStat& stat1 = sortedList[j]->stat;
+        const DuplStat& stat2 = sortedList[k]->stat;
         if (stat1 == stat2)
         {
           // Take the later one.
@@ -128,10 +166,11 @@ string DuplStats::strSame() const
           st += stat2.str(stat1) + "---------------\n";
           st += stat1.strSuggest(true) + "\n\n";
 
-          hashedList[i][j]->activeFlag = false;
+          sortedList[j]->activeFlag = false;
         }
       }
     }
+    start = end;
   }
   if (st == "")
     return "";
@@ -140,49 +179,150 @@ string DuplStats::strSame() const
 }
 
 
+static uint64_t mixMinHash(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+
+void DuplStats::makeKeys(
+  const DuplStat& stat,
+  vector<uint64_t>& keys) const
+{
+  const vector<uint64_t>& fps = stat.fingerprints();
+  keys.clear();
+
+  if (lshBands == 0)
+  {
+    // The distinct fingerprints themselves.
+    for (unsigned f = 0; f < fps.size(); f++)
+    {
+      if (f == 0 || fps[f] != fps[f-1])
+        keys.push_back(fps[f]);
+    }
+    return;
+  }
+
+  // Row i of the signature is the least value of hash function i over
+  // the fingerprints, and two segments agree on it with a probability
+  // equal to their Jaccard similarity.  A band key hashes r rows
+  // together with the band number.
+  for (unsigned b = 0; b < lshBands; b++)
+  {
+    uint64_t key = mixMinHash(b + 1);
+    for (unsigned r = 0; r < lshRows; r++)
+    {
+      const uint64_t seed = MINHASH_SEED * (b * lshRows + r + 1);
+      uint64_t least = UINT64_MAX;
+      for (auto fp: fps)
+      {
+        // The fingerprints are already well mixed, so a cheap
+        // bijection per row is enough.
+        uint64_t h = (fp ^ seed) * MINHASH_SEED;
+        h ^= h >> 32;
+        if (h < least)
+          least = h;
+      }
+      key = mixMinHash(key ^ least);
+    }
+    keys.push_back(key);
+  }
+}
+
+
 string DuplStats::strSubset() const
 {
+  // A segment can only be a subset of one with which it shares a
+  // deal.  These are found by a join on the keys of makeKeys, which
+  // may leave some out when LSH is used.  The candidates are tried in
+  // sorted order with the full test.
+  const unsigned n = sortedList.size();
+  vector<vector<uint64_t>> keys(n);
+  vector<pair<uint64_t, unsigned>> index;
+  for (unsigned i = 0; i < n; i++)
+  {
+    DuplStats::makeKeys(sortedList[i]->stat, keys[i]);
+    for (auto key: keys[i])
+      index.emplace_back(key, i);
+  }
+  sort(index.begin(), index.end());
+
   string st;
-  for (unsigned i = 0; i < HASH_SIZE; i++)
+  vector<bool> seen(n, false);
+  vector<unsigned> candidates;
+  unsigned long long numCandidates = 0, numTested = 0, numFound = 0;
+
+  for (unsigned j = 0; j < n; j++)
   {
-    const unsigned lh = hashedList[i].size();
-    if (lh == 0)
+    if (! sortedList[j]->activeFlag)
       continue;
 
-    for (unsigned j = 0; j < lh; j++)
-    {
-      if (! hashedList[i][j]->activeFlag)
-        continue;
+    const DuplStat& stat1 = sortedList[j]->stat;
 
-      for (unsigned i2 = 0; i2 <= i; i2++)
+    candidates.clear();
+    for (auto key: keys[j])
+    {
+      auto it = lower_bound(index.begin(), index.end(),
+        make_pair(key, 0u));
+      for ( ; it != index.end() && it->first == key; it++)
       {
-        // i's can only be subsets of ones with lower first.
-        for (unsigned k = 0; k < hashedList[i2].size(); k++)
+        const unsigned k = it->second;
+        if (! seen[k])
         {
-          if (! hashedList[i2][k]->activeFlag)
-            continue;
-          if (i == i2 && j == k)
-            continue;
-        
-          const DuplStat& stat1 = hashedList[i][j]->stat;
-          const DuplStat& stat2 = hashedList[i2][k]->stat;
-          if (stat1 <= stat2)
-          {
-            // Take the later one.
-            st += stat1.str() + "---------------\n";
-            st += stat2.str(stat1) + "---------------\n";
-            st += stat1.strSuggest(false) +  "\n\n";
-
-            hashedList[i][j]->activeFlag = false;
-          }
+          seen[k] = true;
+          candidates.push_back(k);
         }
       }
     }
+    sort(candidates.begin(), candidates.end());
+
+    for (auto k: candidates)
+    {
+      seen[k] = false;
+      if (k == j)
+        continue;
+
+      numCandidates++;
+      if (! sortedList[k]->activeFlag)
+        continue;
+
+      // j's can only be subsets of ones with lower first.
+      const DuplStat& stat2 = sortedList[k]->stat;
+      if (stat2.first() > stat1.first())
+        continue;
+
+      numTested++;
+      if (stat1 <= stat2)
+      {
+        // Take the later one.
+        st += stat1.str() + "---------------\n";
+        st += stat2.str(stat1) + "---------------\n";
+        st += stat1.strSuggest(false) +  "\n\n";
+
+        sortedList[j]->activeFlag = false;
+        numFound++;
+      }
+    }
   }
+
+  stringstream ss;
+  ss << "Subset search over " << n << " segments";
+  if (lshBands == 0)
+    ss << " (shared deals)";
+  else
+    ss << " (LSH " << lshBands << "x" << lshRows << ")";
+  ss << ": " << numCandidates << " candidate pairs, " <<
+    numTested << " tested, " << numFound << " found\n\n";
+
   if (st == "")
-    return "";
+    return ss.str();
   else
-    return "Strict subsets\n\n" + st;
+    return "Strict subsets\n\n" + st + ss.str();
 }
 
 
@@ -11,6 +11,8 @@
 #define BRIDGE_DUPLSTATS_H
 
 #include <list>
+#include <vector>
+#include <cstdint>
 
 #include "DuplStat.h"
 #include "bconst.h"
@@ -36,7 +38,19 @@ class DuplStats
     list<DuplElem> statList;
     DuplElem * activeList;
 
-    vector<vector<DuplElem *>> hashedList;
+    // Sorted by sortOverall, so segments with the same deals are
+    // next to each other.
+    vector<DuplElem *> sortedList;
+
+    // With 0 bands, subsets are looked for among all segments that
+    // share a deal.  Otherwise only among those whose MinHash band
+    // keys agree somewhere.
+    unsigned lshBands;
+    unsigned lshRows;
+
+    void makeKeys(
+      const DuplStat& stat,
+      vector<uint64_t>& keys) const;
 
   public:
 
@@ -52,12 +66,20 @@ class DuplStats
       const unsigned segNo,
       const RefLines * reflines);
 
-    void append(const int hashVal);
+    void append(const uint64_t fingerprint);
 
     void sortActive();
 
+    void setLSH(
+      const unsigned bands,
+      const unsigned rows);
+
     void operator += (const DuplStats& dupl2);
 
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
+
     void sortOverall();
 
     string strSame() const;
@@ -10,16 +10,9 @@
 #include <iostream>
 #include <fstream>
 #include <regex>
+#include <algorithm>
 
 
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.thread.h"
-  #include "mingw.mutex.h"
-#else
-  #include <thread>
-  #include <mutex>
-#endif
-
 #if defined(__CYGWIN__)
   #include "dirent.h"
 #elif defined(_WIN32)
@@ -33,7 +26,8 @@
 #include "Files.h"
 #include "parse.h"
 
-static mutex mtx;
+#define BRIDGE_RANGE_SHIFT 32
+#define BRIDGE_RANGE_MASK 0xffffffffULL
 
 
 Files::Files()
@@ -49,15 +43,24 @@ Files::~Files()
 
 void Files::reset()
 {
-  nextNo = 0;
   fileTasks.clear();
-  infoDD.clear();
+  slots.clear();
+  deques.clear();
+  for (unsigned i = 0; i < BRIDGE_DD_INFO_SIZE; i++)
+  {
+    infoDD[i].reset();
+    infoDD[i].setName(DDInfoNames[i]);
+  }
+  cacheDD.reset();
+  manifest.reset();
 }
 
 
 void Files::rewind()
 {
-  nextNo = 0;
+  for (auto &d: deques)
+    d.range = (static_cast<unsigned long long>(d.first) << 
+      BRIDGE_RANGE_SHIFT) | d.last;
 }
 
 
@@ -176,9 +179,10 @@ void Files::extendTaskList(
     o.fileOutput = e.fullName;
     o.formatOutput = e.format;
 
+    // A binary BDB output is checked by comparison, not line by line.
     o.refFlag = false;
     auto it = refMap.find(in.base);
-    if (it != refMap.end())
+    if (it != refMap.end() && e.format != BRIDGE_FORMAT_BDB)
     {
       for (auto &f: it->second)
       {
@@ -221,9 +225,6 @@ void Files::set(const Options& options)
   vector<FileEntry> inputList, refList, outputList;
   map<string, vector<FileEntry>> refMap;
 
-  if (options.solveFlag || options.traceFlag)
-    infoDD.resize(BRIDGE_DD_INFO_SIZE);
-
   // Set inputList
   if (options.fileInput.setFlag)
   {
@@ -325,17 +326,131 @@ void Files::set(const Options& options)
       Files::extendTaskList(i, outputList, keepFlag, refMap);
     }
   }
+
+  manifest.set(options);
+
+  Files::schedule(options.pipelineFlag ? 
+    options.stageThreads[BRIDGE_STAGE_READ] : options.numThreads);
+}
+
+
+long long Files::taskCost(const FileTask& task) const
+{
+  // The input size is a good proxy for the work, as every board is
+  // read, checked and written in every output format.
+  ifstream fin(task.fileInput.c_str(), ios::binary | ios::ate);
+  if (! fin.is_open())
+    return 0;
+
+  const long long size = static_cast<long long>(fin.tellg());
+  return (size < 0 ? 0 : size);
+}
+
+
+void Files::schedule(const unsigned numWorkers)
+{
+  // Largest files first, so that a few huge files do not end up
+  // at the end of the list with only one thread left working.
+  const unsigned n = static_cast<unsigned>(fileTasks.size());
+  vector<pair<long long, unsigned>> costs(n);
+  for (unsigned i = 0; i < n; i++)
+    costs[i] = make_pair(Files::taskCost(fileTasks[i]), i);
+
+  stable_sort(costs.begin(), costs.end(),
+    [](const pair<long long, unsigned>& a, 
+       const pair<long long, unsigned>& b)
+  {
+    return a.first > b.first;
+  });
+
+  // Deal the tasks out round-robin, so each deque is also sorted
+  // by decreasing size.
+  const unsigned nw = (numWorkers == 0 ? 1 : numWorkers);
+  vector<TaskDeque>(nw).swap(deques);
+  slots.resize(n);
+
+  unsigned s = 0;
+  for (unsigned w = 0; w < nw; w++)
+  {
+    deques[w].first = s;
+    for (unsigned i = w; i < n; i += nw)
+      slots[s++] = costs[i].second;
+    deques[w].last = s;
+  }
+
+  Files::rewind();
 }
 
 
-bool Files::next(FileTask& ftask) 
+bool Files::takeHead(
+  TaskDeque& deque,
+  unsigned& taskNo)
 {
-  if (nextNo >= fileTasks.size())
+  unsigned long long r = deque.range.load();
+  while (true)
+  {
+    const unsigned head = static_cast<unsigned>(r >> BRIDGE_RANGE_SHIFT);
+    const unsigned tail = static_cast<unsigned>(r & BRIDGE_RANGE_MASK);
+    if (head >= tail)
+      return false;
+
+    const unsigned long long rnew = 
+      (static_cast<unsigned long long>(head+1) << BRIDGE_RANGE_SHIFT) | 
+      tail;
+    if (deque.range.compare_exchange_weak(r, rnew))
+    {
+      taskNo = slots[head];
+      return true;
+    }
+  }
+}
+
+
+bool Files::takeTail(
+  TaskDeque& deque,
+  unsigned& taskNo)
+{
+  unsigned long long r = deque.range.load();
+  while (true)
+  {
+    const unsigned head = static_cast<unsigned>(r >> BRIDGE_RANGE_SHIFT);
+    const unsigned tail = static_cast<unsigned>(r & BRIDGE_RANGE_MASK);
+    if (head >= tail)
+      return false;
+
+    const unsigned long long rnew = 
+      (static_cast<unsigned long long>(head) << BRIDGE_RANGE_SHIFT) | 
+      (tail-1);
+    if (deque.range.compare_exchange_weak(r, rnew))
+    {
+      taskNo = slots[tail-1];
+      return true;
+    }
+  }
+}
+
+
+bool Files::next(
+  const unsigned thrNo,
+  FileTask& ftask) 
+{
+  const unsigned nw = static_cast<unsigned>(deques.size());
+  if (nw == 0)
     return false;
 
-  mtx.lock();
-  ftask = fileTasks[nextNo++];
-  mtx.unlock();
+  // Own work first, largest remaining file.  Then steal the smallest
+  // remaining file from another worker, which leaves the victim with
+  // its larger files and keeps the stolen piece short.
+  const unsigned own = thrNo % nw;
+  unsigned taskNo;
+  bool found = Files::takeHead(deques[own], taskNo);
+  for (unsigned k = 1; ! found && k < nw; k++)
+    found = Files::takeTail(deques[(own+k) % nw], taskNo);
+
+  if (! found)
+    return false;
+
+  ftask = fileTasks[taskNo];
   return true;
 }
 
@@ -385,8 +500,92 @@ void Files::addDDInfo(
 }
 
 
-void Files::writeDDInfo(const DDInfoType infoNo) const
+void Files::writeDDInfo(const DDInfoType infoNo)
 {
   infoDD[infoNo].write(DDInfoNames[infoNo]);
 }
 
+
+bool Files::haveTableau(
+  const unsigned holding[][BRIDGE_SUITS],
+  string& info)
+{
+  return cacheDD.lookup(holding, info);
+}
+
+
+void Files::addTableau(
+  const unsigned holding[][BRIDGE_SUITS],
+  const string& info)
+{
+  cacheDD.add(holding, info);
+}
+
+
+string Files::strDDCache() const
+{
+  return cacheDD.str();
+}
+
+
+bool Files::incremental() const
+{
+  return manifest.active();
+}
+
+
+string Files::hashTask(const FileTask& task) const
+{
+  return manifest.hash(task);
+}
+
+
+bool Files::haveTask(
+  const FileTask& task,
+  const string& hash,
+  string& stats)
+{
+  return manifest.lookup(task, hash, stats);
+}
+
+
+void Files::addTask(
+  const FileTask& task,
+  const string& hash,
+  const string& stats)
+{
+  manifest.add(task, hash, stats);
+}
+
+
+void Files::writeManifest()
+{
+  manifest.write();
+}
+
+
+string Files::strManifest() const
+{
+  return manifest.str();
+}
+
+
+unsigned Files::freezeGroup(const Group& group)
+{
+  return corpus.addGroup(group);
+}
+
+
+void Files::thawBoard(
+  const unsigned no,
+  Board& board) const
+{
+  corpus.get(no, board);
+}
+
+
+string Files::strCorpus() const
+{
+  return corpus.str();
+}
+
@@ -13,8 +13,12 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <atomic>
 
 #include "DDInfo.h"
+#include "DDCache.h"
+#include "Manifest.h"
+#include "Corpus.h"
 #include "bconst.h"
 
 using namespace std;
@@ -32,10 +36,26 @@ class Files
 {
   private:
 
+    // Each worker has its own deque of task numbers, stored as the
+    // range [head, tail) of a shared slot array.  Both ends are packed
+    // into one atomic word, so the owner can take from the head and
+    // an idle worker can steal from the tail without a lock.
+
+    struct TaskDeque
+    {
+      atomic<unsigned long long> range;
+      unsigned first;
+      unsigned last;
+    };
+
     vector<FileTask> fileTasks;
-    unsigned nextNo;
+    vector<unsigned> slots;
+    vector<TaskDeque> deques;
 
-    vector<DDInfo> infoDD;
+    DDInfo infoDD[BRIDGE_DD_INFO_SIZE];
+    DDCache cacheDD;
+    Manifest manifest;
+    Corpus corpus;
     vector<string> dirList; // Sloppy to keep this
 
     bool fillEntry(
@@ -63,6 +83,18 @@ class Files
       const string& dir,
       const Options& options);
 
+    long long taskCost(const FileTask& task) const;
+
+    void schedule(const unsigned numWorkers);
+
+    bool takeHead(
+      TaskDeque& deque,
+      unsigned& taskNo);
+
+    bool takeTail(
+      TaskDeque& deque,
+      unsigned& taskNo);
+
 
   public:
 
@@ -76,7 +108,9 @@ class Files
 
     void set(const Options& options);
 
-    bool next(FileTask& ftask);
+    bool next(
+      const unsigned thrNo,
+      FileTask& ftask);
 
     void print() const;
 
@@ -93,7 +127,43 @@ class Files
       const vector<string>& casesMissing,
       const vector<string>& infoMissing);
 
-    void writeDDInfo(const DDInfoType infoNo) const;
+    void writeDDInfo(const DDInfoType infoNo);
+
+    bool haveTableau(
+      const unsigned holding[][BRIDGE_SUITS],
+      string& info);
+
+    void addTableau(
+      const unsigned holding[][BRIDGE_SUITS],
+      const string& info);
+
+    string strDDCache() const;
+
+    bool incremental() const;
+
+    string hashTask(const FileTask& task) const;
+
+    bool haveTask(
+      const FileTask& task,
+      const string& hash,
+      string& stats);
+
+    void addTask(
+      const FileTask& task,
+      const string& hash,
+      const string& stats);
+
+    void writeManifest();
+
+    string strManifest() const;
+
+    unsigned freezeGroup(const Group& group);
+
+    void thawBoard(
+      const unsigned no,
+      Board& board) const;
+
+    string strCorpus() const;
 };
 
 #endif
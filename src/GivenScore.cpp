@@ -8,12 +8,13 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 
 #include "bconst.h"
 #include "GivenScore.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -102,6 +103,23 @@ void GivenScore::setMP(
 }
 
 
+void GivenScore::writeBDB(BDBWriter& bw) const
+{
+  bw.putBool(setFlag);
+  if (setFlag)
+    bw.putFloat(score);
+}
+
+
+void GivenScore::readBDB(BDBReader& br)
+{
+  GivenScore::reset();
+  setFlag = br.getBool();
+  if (setFlag)
+    score = br.getFloat();
+}
+
+
 bool GivenScore::operator == (const GivenScore& gs2) const
 {
   if (setFlag != gs2.setFlag)
@@ -126,7 +144,7 @@ bool GivenScore::operator != (const GivenScore& gs2) const
 
 string GivenScore::str(const Format format) const
 {
-  stringstream ss;
+  string st;
   
   if (FORMAT_INPUT_MAP[format] == BRIDGE_FORMAT_LIN)
   {
@@ -135,22 +153,28 @@ string GivenScore::str(const Format format) const
       if ((format == BRIDGE_FORMAT_LIN ||
           format == BRIDGE_FORMAT_LIN_TRN) && 
           ! setFlag)
-        ss << ",,";
+        st = ",,";
       else
-        ss << "--,--,";
+        st = "--,--,";
     }
     else if (score > 0.0f)
-      ss << setprecision(1) << fixed << score << ",,";
+    {
+      appendFixed(st, static_cast<double>(score), 1);
+      st += ",,";
+    }
     else
-      ss << "," << setprecision(1) << fixed << -score << ",";
-    return ss.str();
+    {
+      st = ",";
+      appendFixed(st, static_cast<double>(-score), 1);
+      st += ",";
+    }
+    return st;
   }
   else if (format == BRIDGE_FORMAT_PBN && setFlag)
   {
-    ss << "[ScoreIMP \"NS ";
-    ss << setprecision(2) << fixed << score << "\"]\n";
-
-    return ss.str();
+    st = "[ScoreIMP \"NS ";
+    appendFixed(st, static_cast<double>(score), 2);
+    return st + "\"]\n";
   }
   else
     return "";
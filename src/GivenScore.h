@@ -13,6 +13,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class GivenScore
 {
   private:
@@ -37,6 +41,9 @@ class GivenScore
       const string& text,
       const Format format);
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const GivenScore& gs2) const;
 
     bool operator != (const GivenScore& gs2) const;
@@ -10,6 +10,7 @@
 #include <sstream>
 
 #include "Group.h"
+#include "BDB.h"
 #include "Bdiff.h"
 
 
@@ -80,6 +81,24 @@ Segment * Group::make()
 }
 
 
+Segment * Group::splice(
+  Group& group2,
+  const unsigned no)
+{
+  auto it = group2.segments.begin();
+  for (unsigned i = 0; i < no && it != group2.segments.end(); i++)
+    it++;
+
+  segments.splice(segments.end(), group2.segments,
+    it, group2.segments.end());
+
+  if (segments.empty())
+    return nullptr;
+  else
+    return &segments.back();
+}
+
+
 unsigned Group::size() const
 {
   return segments.size();
@@ -106,6 +125,29 @@ unsigned Group::countBoards() const
 }
 
 
+void Group::writeBDB(BDBWriter& bw) const
+{
+  bw.putBool(flagCOCO);
+  bw.putUnsigned(static_cast<unsigned>(segments.size()));
+  for (auto &segment: segments)
+    segment.writeBDB(bw);
+}
+
+
+void Group::readBDB(BDBReader& br)
+{
+  segments.clear();
+  flagCOCO = br.getBool();
+
+  const unsigned n = br.getUnsigned();
+  for (unsigned i = 0; i < n; i++)
+  {
+    segments.emplace_back(Segment());
+    segments.back().readBDB(br);
+  }
+}
+
+
 bool Group::operator == (const Group& group2) const
 {
   const unsigned s1 = segments.size();
@@ -18,6 +18,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Group
 {
   private:
@@ -48,6 +52,12 @@ class Group
 
     Segment * make();
 
+    // Moves the segments of group2 from position no onwards to the
+    // end.  Returns the last segment, or nullptr if there is none.
+    Segment * splice(
+      Group& group2,
+      const unsigned no);
+
     void setCOCO(const Format format = BRIDGE_FORMAT_SIZE);
     bool isCOCO() const;
 
@@ -55,6 +65,9 @@ class Group
     unsigned count() const;
     unsigned countBoards() const;
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Group& group2) const;
     bool operator != (const Group& group2) const;
     bool operator <= (const Group& group2) const;
@@ -14,6 +14,7 @@
 
 #include "HeaderLIN.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 
 
@@ -367,6 +368,47 @@ void HeaderLIN::setBoardsList(
 }
 
 
+void HeaderLIN::writeBDB(BDBWriter& bw) const
+{
+  bw.putUnsigned(len);
+  for (unsigned i = 0; i < len; i++)
+  {
+    const LINData& ld = LINdata[i];
+    bw.putString(ld.no);
+    for (unsigned j = 0; j < 2; j++)
+    {
+      bw.putString(ld.data[j].contract);
+      for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+        bw.putString(ld.data[j].players[p]);
+      bw.putString(ld.data[j].mp);
+    }
+  }
+  bw.putBool(playersListFlag);
+}
+
+
+void HeaderLIN::readBDB(BDBReader& br)
+{
+  HeaderLIN::reset();
+
+  len = br.getUnsigned();
+  LINdata.resize(len);
+  for (unsigned i = 0; i < len; i++)
+  {
+    LINData& ld = LINdata[i];
+    ld.no = br.getString();
+    for (unsigned j = 0; j < 2; j++)
+    {
+      ld.data[j].contract = br.getString();
+      for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+        ld.data[j].players[p] = br.getString();
+      ld.data[j].mp = br.getString();
+    }
+  }
+  playersListFlag = br.getBool();
+}
+
+
 LINData const * HeaderLIN::getEntry(const unsigned intNo) const
 {
   return &LINdata[intNo];
@@ -16,6 +16,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class HeaderLIN
 {
   private:
@@ -76,6 +80,9 @@ class HeaderLIN
       const string& text,
       const Format format);
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     LINData const * getEntry(const unsigned intNo) const;
 
     bool isSet() const;
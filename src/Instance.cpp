@@ -8,12 +8,13 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 
 #include "Instance.h"
+#include "append.h"
 #include "bconst.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -139,7 +140,12 @@ void Instance::setAuction(
   const Format format)
 {
   auction.addAuction(text, format);
+  Instance::finishAuction();
+}
+
 
+void Instance::finishAuction()
+{
   if (auction.hasDealerVul())
     contract.setVul(auction.getVul());
 
@@ -252,6 +258,37 @@ void Instance::setPlays(
 }
 
 
+void Instance::addPlay(const string& text)
+{
+  play.addPlay(text);
+}
+
+
+void Instance::addTrick(
+  const vector<string>& cards,
+  const Format format)
+{
+  play.addTrick(cards, format);
+}
+
+
+void Instance::addTrick(
+  const string& trick,
+  const Format format)
+{
+  play.addTrick(trick, format);
+}
+
+
+void Instance::finishPlays()
+{
+  play.finishPlays();
+
+  if (play.isOver())
+    contract.setTricks(play.getTricks());
+}
+
+
 void Instance::undoLastPlay()
 {
   play.undoPlay();
@@ -388,6 +425,12 @@ bool Instance::overlappingPlayers(const Instance& inst2) const
 }
 
 
+bool Instance::samePlayers(const Instance& inst2) const
+{
+  return players.same(inst2.players);
+}
+
+
 void Instance::setRoom(
   const string& text,
   const Format format)
@@ -420,6 +463,43 @@ void Instance::setTrace(const string& strCompact)
 }
 
 
+void Instance::writeBDB(BDBWriter& bw) const
+{
+  // The trace comes from a DD run and is not stored.
+  players.writeBDB(bw);
+  auction.writeBDB(bw);
+  contract.writeBDB(bw);
+  play.writeBDB(bw);
+  bw.putBool(LINset);
+}
+
+
+void Instance::readBDB(
+  BDBReader& br,
+  LINInstData const * lin)
+{
+  Instance::reset();
+
+  players.readBDB(br);
+  auction.readBDB(br);
+  contract.readBDB(br);
+  play.readBDB(br);
+
+  if (br.getBool() && lin != nullptr)
+  {
+    LINdata = lin;
+    LINset = true;
+  }
+}
+
+
+size_t Instance::heapSize() const
+{
+  return players.heapSize() + auction.heapSize() + play.heapSize() +
+    trace.heapSize();
+}
+
+
 bool Instance::operator == (const Instance& inst2) const
 {
   // We don't compare players.
@@ -467,7 +547,9 @@ string Instance::strVul(const Format format) const
 }
 
 
-string Instance::strAuction(const Format format) const
+void Instance::appendAuction(
+  string& st,
+  const Format format) const
 {
   if (format == BRIDGE_FORMAT_TXT)
   {
@@ -479,10 +561,34 @@ string Instance::strAuction(const Format format) const
         (players.strPlayer(pp, format).length());
       lengths[p] = Max(12, lengths[p]+1);
     }
-    return auction.str(format, lengths);
+    auction.appendStr(st, format, lengths);
   }
   else
-    return auction.str(format);
+    auction.appendStr(st, format);
+}
+
+
+void Instance::appendContract(
+  string& st,
+  const Format format) const
+{
+  contract.appendStr(st, format);
+}
+
+
+void Instance::appendPlay(
+  string& st,
+  const Format format) const
+{
+  play.appendStr(st, format);
+}
+
+
+string Instance::strAuction(const Format format) const
+{
+  string st;
+  Instance::appendAuction(st, format);
+  return st;
 }
 
 
@@ -621,17 +727,20 @@ string Instance::strResult(
 
 string Instance::strResultEntry() const
 {
-  stringstream ss;
-  ss << setw(8) << left << contract.str(BRIDGE_FORMAT_LIN);
+  string st;
+  appendLeft(st, contract.str(BRIDGE_FORMAT_LIN), 8);
 
   const int score = contract.getScore();
   if (score == 0)
-    ss << "     --     --";
+    st += "     --     --";
   else if (score > 0)
-    ss << setw(7) << right << score << setw(7) << "";
+  {
+    appendInt(st, score, 7);
+    appendSpaces(st, 7);
+  }
   else
-    ss << setw(14) << right << -score;
-  return ss.str() + "  |  ";
+    appendInt(st, -score, 14);
+  return st + "  |  ";
 }
 
 
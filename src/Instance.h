@@ -21,6 +21,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Instance
 {
   private:
@@ -39,6 +43,12 @@ class Instance
 
     Instance();
 
+    Instance(const Instance& inst2) = default;
+    Instance(Instance&& inst2) = default;
+
+    Instance& operator = (const Instance& inst2) = default;
+    Instance& operator = (Instance&& inst2) = default;
+
     ~Instance();
 
     void reset();
@@ -83,6 +93,8 @@ class Instance
       const string& text,
       const Format format);
 
+    void finishAuction();
+
     bool auctionIsEmpty() const;
 
     bool hasDealerVul() const;
@@ -121,6 +133,18 @@ class Instance
       const string& text,
       const Format format);
 
+    void addPlay(const string& text);
+
+    void addTrick(
+      const vector<string>& cards,
+      const Format format);
+
+    void addTrick(
+      const string& trick,
+      const Format format);
+
+    void finishPlays();
+
     void undoLastPlay();
 
     bool dealIsSet() const;
@@ -172,6 +196,7 @@ class Instance
 
     unsigned missingPlayers() const;
     bool overlappingPlayers(const Instance& inst2) const;
+    bool samePlayers(const Instance& inst2) const;
 
     void setRoom(
       const string& s,
@@ -185,10 +210,27 @@ class Instance
 
     void setTrace(const string& strCompact);
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(
+      BDBReader& br,
+      LINInstData const * lin);
+
+    size_t heapSize() const;
+
     bool operator == (const Instance& inst2) const;
     bool operator != (const Instance& inst2) const;
     bool operator <= (const Instance& inst2) const;
 
+    void appendAuction(
+      string& st,
+      const Format format) const;
+    void appendContract(
+      string& st,
+      const Format format) const;
+    void appendPlay(
+      string& st,
+      const Format format) const;
+
     string strDealer(const Format format) const;
     string strVul(const Format format) const;
     string strAuction(const Format format) const;
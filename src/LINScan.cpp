@@ -0,0 +1,221 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define LINSCAN_AVX2
+  #define LINSCAN_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define LINSCAN_SSE2
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#include "LINScan.h"
+#include "bconst.h"
+
+
+#if defined(LINSCAN_AVX2)
+  #define LINSCAN_BEST LINSCAN_PATH_AVX2
+#elif defined(LINSCAN_SSE2)
+  #define LINSCAN_BEST LINSCAN_PATH_SSE2
+#else
+  #define LINSCAN_BEST LINSCAN_PATH_SCALAR
+#endif
+
+static LINScanPath scanPath = LINSCAN_BEST;
+
+
+static void scanPipes(
+  const char * text,
+  const unsigned len,
+  const LINScanPath path,
+  vector<unsigned>& pipes);
+
+
+LINScanner::LINScanner()
+{
+  LINScanner::reset();
+}
+
+
+LINScanner::~LINScanner()
+{
+}
+
+
+void LINScanner::reset()
+{
+  text = nullptr;
+  len = 0;
+  pipes.clear();
+  hint = 0;
+}
+
+
+LINScanPath LINScanner::bestPath()
+{
+  return LINSCAN_BEST;
+}
+
+
+void LINScanner::setPath(const LINScanPath path)
+{
+  // A path that was not compiled in falls back to the best one that was.
+  scanPath = (path > LINSCAN_BEST ? LINSCAN_BEST : path);
+}
+
+
+LINScanPath LINScanner::getPath()
+{
+  return scanPath;
+}
+
+
+#if defined(LINSCAN_SSE2)
+static unsigned lowestBit(const unsigned mask)
+{
+#if defined(_MSC_VER)
+  unsigned long b;
+  _BitScanForward(&b, mask);
+  return static_cast<unsigned>(b);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+
+static void addPipes(
+  const unsigned base,
+  unsigned mask,
+  vector<unsigned>& pipes)
+{
+  while (mask)
+  {
+    pipes.push_back(base + lowestBit(mask));
+    mask &= mask - 1;
+  }
+}
+#endif
+
+
+static void scanPipes(
+  const char * text,
+  const unsigned len,
+  const LINScanPath path,
+  vector<unsigned>& pipes)
+{
+  unsigned i = 0;
+
+#if defined(LINSCAN_AVX2)
+  if (path >= LINSCAN_PATH_AVX2)
+  {
+    const __m256i bar32 = _mm256_set1_epi8('|');
+    for ( ; i + 32 <= len; i += 32)
+    {
+      const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(text + i));
+      addPipes(i, static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, bar32))), pipes);
+    }
+  }
+#endif
+
+#if defined(LINSCAN_SSE2)
+  if (path >= LINSCAN_PATH_SSE2)
+  {
+    const __m128i bar16 = _mm_set1_epi8('|');
+    for ( ; i + 16 <= len; i += 16)
+    {
+      const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(text + i));
+      addPipes(i, static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(v, bar16))), pipes);
+    }
+  }
+#else
+  UNUSED(path);
+#endif
+
+  for ( ; i < len; i++)
+  {
+    if (text[i] == '|')
+      pipes.push_back(i);
+  }
+}
+
+
+void LINScanner::set(
+  const char * textIn,
+  const unsigned lenIn)
+{
+  text = textIn;
+  len = lenIn;
+  pipes.clear();
+  hint = 0;
+  scanPipes(text, len, scanPath, pipes);
+}
+
+
+bool LINScanner::covers(
+  const char * textIn,
+  const unsigned lenIn) const
+{
+  return (text == textIn && len == lenIn);
+}
+
+
+size_t LINScanner::find(const size_t pos)
+{
+  // Same as string::find('|', pos) on the line.  Searches mostly
+  // continue just after the previous hit, so try that first.
+  const unsigned n = static_cast<unsigned>(pipes.size());
+  if ((hint < n && pipes[hint] < pos) ||
+      (hint > 0 && pipes[hint-1] >= pos))
+  {
+    hint = static_cast<unsigned>(
+      lower_bound(pipes.begin(), pipes.end(), pos) - pipes.begin());
+  }
+
+  if (hint == n)
+    return string::npos;
+  else
+    return pipes[hint++];
+}
+
+
+bool LINScanner::nextPair(
+  size_t& pos,
+  StrView& label,
+  StrView& value)
+{
+  if (pos == len)
+    return false;
+
+  const size_t lpos = LINScanner::find(pos);
+  if (lpos == string::npos)
+    return false;
+  const size_t vpos = LINScanner::find(lpos+1);
+  if (vpos == string::npos)
+    return false;
+
+  label.text = text + pos;
+  label.len = static_cast<unsigned>(lpos - pos);
+  value.text = text + lpos + 1;
+  value.len = static_cast<unsigned>(vpos - lpos - 1);
+  pos = vpos+1;
+  return true;
+}
+
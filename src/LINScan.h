@@ -0,0 +1,78 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// LINScanner finds all the pipes of a LIN line in a single pass,
+// 32 or 16 bytes at a time with AVX2 or SSE2 if the compiler has
+// them, and byte by byte otherwise.  After that, searches and
+// label|value| pairs come from the list of positions, and the
+// pairs are views into the line, so nothing is allocated.
+// The vector path can be turned down at run time, which is only
+// meant for comparing the paths in a benchmark.
+
+
+#ifndef BRIDGE_LINSCAN_H
+#define BRIDGE_LINSCAN_H
+
+#include <string>
+#include <vector>
+
+#include "parse.h"
+
+using namespace std;
+
+enum LINScanPath
+{
+  LINSCAN_PATH_SCALAR = 0,
+  LINSCAN_PATH_SSE2 = 1,
+  LINSCAN_PATH_AVX2 = 2
+};
+
+
+class LINScanner
+{
+  private:
+
+    const char * text;
+    unsigned len;
+    vector<unsigned> pipes;
+    unsigned hint;
+
+
+  public:
+
+    LINScanner();
+
+    ~LINScanner();
+
+    void reset();
+
+    static LINScanPath bestPath();
+
+    // Not thread-safe: set it before any reading starts.
+    static void setPath(const LINScanPath path);
+
+    static LINScanPath getPath();
+
+    void set(
+      const char * textIn,
+      const unsigned lenIn);
+
+    bool covers(
+      const char * textIn,
+      const unsigned lenIn) const;
+
+    size_t find(const size_t pos);
+
+    bool nextPair(
+      size_t& pos,
+      StrView& label,
+      StrView& value);
+};
+
+#endif
+
@@ -11,6 +11,7 @@
 #include <sstream>
 
 #include "Location.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -74,6 +75,20 @@ void Location::set(
 }
 
 
+void Location::writeBDB(BDBWriter& bw) const
+{
+  bw.putString(locGeneral);
+  bw.putString(locSpecific);
+}
+
+
+void Location::readBDB(BDBReader& br)
+{
+  locGeneral = br.getString();
+  locSpecific = br.getString();
+}
+
+
 bool Location::operator == (const Location& location2) const
 {
   if (locGeneral != location2.locGeneral)
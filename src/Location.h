@@ -17,6 +17,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Location
 {
   private:
@@ -43,6 +47,9 @@ class Location
       const string& text,
       const Format f);
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Location& location2) const;
 
     bool operator != (const Location& location2) const;
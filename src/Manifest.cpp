@@ -0,0 +1,258 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+#include "Manifest.h"
+#include "MappedFile.h"
+#include "parse.h"
+#include "Bexcept.h"
+
+#define MANIFEST_MAGIC "BridgeData manifest 1"
+
+// Part of every task hash.  Change it when the serialized stats
+// change, so that older entries are redone rather than misread.
+#define MANIFEST_STATS "stats 2"
+
+
+Manifest::Manifest()
+{
+  Manifest::reset();
+}
+
+
+Manifest::~Manifest()
+{
+}
+
+
+void Manifest::reset()
+{
+  fileName = "";
+  optionsKey = "";
+  activeFlag = false;
+  changedFlag = false;
+  entries.clear();
+  numSkipped = 0;
+  numRun = 0;
+}
+
+
+void Manifest::set(const Options& options)
+{
+  Manifest::reset();
+  if (! options.fileManifest.setFlag)
+    return;
+
+  fileName = options.fileManifest.name;
+  activeFlag = true;
+
+  // The options that change the results of a task.  The file names
+  // are part of the task itself.
+  stringstream ss;
+  ss << options.tableIMPFlag << options.compareFlag << 
+    options.playersFlag << options.equalFlag << 
+    options.valuationFlag << options.solveFlag << 
+    options.traceFlag << options.statsFlag << options.quoteFlag << 
+    " " << options.formatSetFlag << " " << 
+    static_cast<unsigned>(options.format) << 
+    " " << options.fileDigest.name << " " << options.dirDigest.name;
+  optionsKey = ss.str();
+
+  Manifest::read();
+}
+
+
+bool Manifest::active() const
+{
+  return activeFlag;
+}
+
+
+void Manifest::mix(
+  uint64_t& h,
+  const char * data,
+  const size_t len) const
+{
+  // FNV-1a.
+  for (size_t i = 0; i < len; i++)
+  {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= 1099511628211ull;
+  }
+}
+
+
+void Manifest::mixFile(
+  uint64_t& h,
+  const string& fname) const
+{
+  // A missing file and an empty file hash the same, which is fine,
+  // as neither has any content to process.
+  Manifest::mix(h, fname.c_str(), fname.length()+1);
+
+  MappedFile mapping;
+  if (mapping.open(fname))
+    Manifest::mix(h, mapping.begin(), mapping.size());
+
+  const char sep = '\n';
+  Manifest::mix(h, &sep, 1);
+}
+
+
+string Manifest::hash(const FileTask& task) const
+{
+  uint64_t h = 14695981039346656037ull;
+  Manifest::mix(h, MANIFEST_STATS, sizeof(MANIFEST_STATS));
+  Manifest::mix(h, optionsKey.c_str(), optionsKey.length()+1);
+
+  Manifest::mixFile(h, task.fileInput);
+  Manifest::mixFile(h, changeExt(task.fileInput, ".ref"));
+
+  for (auto &t: task.taskList)
+  {
+    const string st = t.fileOutput + " " + STR(t.formatOutput);
+    Manifest::mix(h, st.c_str(), st.length()+1);
+    if (t.refFlag)
+      Manifest::mixFile(h, t.fileRef);
+  }
+
+  stringstream ss;
+  ss << hex << setfill('0') << setw(16) << h;
+  return ss.str();
+}
+
+
+bool Manifest::lookup(
+  const FileTask& task,
+  const string& hashTask,
+  string& stats)
+{
+  {
+    lock_guard<mutex> lck(mtx);
+    auto it = entries.find(task.fileInput);
+    if (it == entries.end() || it->second.hash != hashTask)
+      return false;
+
+    for (auto &o: it->second.outputs)
+    {
+      ifstream fout(o.c_str());
+      if (! fout.is_open())
+        return false;
+    }
+
+    stats = it->second.stats;
+  }
+
+  numSkipped++;
+  return true;
+}
+
+
+void Manifest::add(
+  const FileTask& task,
+  const string& hashTask,
+  const string& stats)
+{
+  ManifestEntry entry;
+  entry.hash = hashTask;
+  entry.stats = stats;
+  if (! task.removeOutputFlag)
+  {
+    for (auto &t: task.taskList)
+      if (t.fileOutput != "")
+        entry.outputs.push_back(t.fileOutput);
+  }
+
+  lock_guard<mutex> lck(mtx);
+  entries[task.fileInput] = entry;
+  changedFlag = true;
+  numRun++;
+}
+
+
+void Manifest::read()
+{
+  ifstream fin(fileName.c_str(), ios::binary);
+  if (! fin.is_open())
+    return;
+
+  string line;
+  if (! getline(fin, line) || line != MANIFEST_MAGIC)
+    THROW("Not a manifest: " + fileName);
+
+  unsigned n, m;
+  string key, output;
+  readField(fin, n);
+  for (unsigned i = 0; i < n; i++)
+  {
+    readField(fin, key);
+    ManifestEntry& entry = entries[key];
+    readField(fin, entry.hash);
+    readField(fin, m);
+    for (unsigned j = 0; j < m; j++)
+    {
+      readField(fin, output);
+      entry.outputs.push_back(output);
+    }
+    readField(fin, entry.stats);
+  }
+}
+
+
+void Manifest::write()
+{
+  if (! activeFlag || ! changedFlag)
+    return;
+
+  // Write a new manifest next to the old one and then swap them.
+  const string nameTmp = fileName + ".tmp";
+  ofstream fout(nameTmp.c_str(), ios::binary);
+  if (! fout.is_open())
+    THROW("Could not create " + nameTmp);
+
+  fout << MANIFEST_MAGIC << "\n";
+  writeField(fout, static_cast<unsigned>(entries.size()));
+  for (auto &it: entries)
+  {
+    writeField(fout, it.first);
+    writeField(fout, it.second.hash);
+    writeField(fout, static_cast<unsigned>(it.second.outputs.size()));
+    for (auto &o: it.second.outputs)
+      writeField(fout, o);
+    writeField(fout, it.second.stats);
+  }
+  fout.close();
+
+  // As for the DD store index: replace atomically where rename()
+  // can, and remove the old manifest first on Windows.
+#if defined(_WIN32)
+  remove(fileName.c_str());
+#endif
+  if (rename(nameTmp.c_str(), fileName.c_str()) != 0)
+    THROW("Could not rename " + nameTmp);
+
+  changedFlag = false;
+}
+
+
+string Manifest::str() const
+{
+  if (! activeFlag)
+    return "";
+
+  stringstream ss;
+  ss << "Manifest: " << numSkipped << " files unchanged, " <<
+    numRun << " files processed\n";
+  return ss.str();
+}
+
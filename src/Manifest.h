@@ -0,0 +1,104 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Manifest remembers, for each input file, a hash of everything that
+// determines its results: the options, the input file, its ref file,
+// the outputs and their reference files.  It also keeps the outputs
+// that were produced and the serialized per-file stats.  A task whose
+// hash is unchanged and whose outputs still exist can be skipped, and
+// its stats are merged from the manifest instead.
+
+
+#ifndef BRIDGE_MANIFEST_H
+#define BRIDGE_MANIFEST_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <cstdint>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+#else
+  #include <thread>
+  #include <mutex>
+#endif
+
+#include "bconst.h"
+
+using namespace std;
+
+
+class Manifest
+{
+  private:
+
+    struct ManifestEntry
+    {
+      string hash;
+      vector<string> outputs;
+      string stats;
+    };
+
+    string fileName;
+    string optionsKey;
+    bool activeFlag;
+    bool changedFlag;
+
+    map<string, ManifestEntry> entries;
+    mutex mtx;
+
+    atomic<unsigned> numSkipped;
+    atomic<unsigned> numRun;
+
+
+    void mix(
+      uint64_t& h,
+      const char * data,
+      const size_t len) const;
+
+    void mixFile(
+      uint64_t& h,
+      const string& fname) const;
+
+    void read();
+
+
+  public:
+
+    Manifest();
+
+    ~Manifest();
+
+    void reset();
+
+    void set(const Options& options);
+
+    bool active() const;
+
+    string hash(const FileTask& task) const;
+
+    bool lookup(
+      const FileTask& task,
+      const string& hashTask,
+      string& stats);
+
+    void add(
+      const FileTask& task,
+      const string& hashTask,
+      const string& stats);
+
+    void write();
+
+    string str() const;
+};
+
+#endif
+
@@ -0,0 +1,154 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+
+MappedFile::MappedFile()
+{
+  data = nullptr;
+  len = 0;
+#if defined(_WIN32)
+  fileHandle = nullptr;
+  mapHandle = nullptr;
+#else
+  fd = -1;
+#endif
+}
+
+
+MappedFile::~MappedFile()
+{
+  MappedFile::close();
+}
+
+
+void MappedFile::reset()
+{
+  MappedFile::close();
+}
+
+
+bool MappedFile::open(const string& fname)
+{
+  // Returns false if the file is missing or empty.  An empty file
+  // cannot be mapped, but callers can treat it as an empty view.
+
+  MappedFile::close();
+
+#if defined(_WIN32)
+  HANDLE fh = CreateFileA(fname.c_str(), GENERIC_READ, 
+    FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (fh == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER fsize;
+  if (! GetFileSizeEx(fh, &fsize) || fsize.QuadPart == 0)
+  {
+    CloseHandle(fh);
+    return false;
+  }
+
+  HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mh == nullptr)
+  {
+    CloseHandle(fh);
+    return false;
+  }
+
+  void * p = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+  if (p == nullptr)
+  {
+    CloseHandle(mh);
+    CloseHandle(fh);
+    return false;
+  }
+
+  fileHandle = fh;
+  mapHandle = mh;
+  data = static_cast<const char *>(p);
+  len = static_cast<size_t>(fsize.QuadPart);
+#else
+  const int fdn = ::open(fname.c_str(), O_RDONLY);
+  if (fdn == -1)
+    return false;
+
+  struct stat st;
+  if (fstat(fdn, &st) == -1 || st.st_size == 0)
+  {
+    ::close(fdn);
+    return false;
+  }
+
+  const size_t l = static_cast<size_t>(st.st_size);
+  void * p = mmap(nullptr, l, PROT_READ, MAP_PRIVATE, fdn, 0);
+  if (p == MAP_FAILED)
+  {
+    ::close(fdn);
+    return false;
+  }
+
+  fd = fdn;
+  data = static_cast<const char *>(p);
+  len = l;
+#endif
+
+  return true;
+}
+
+
+void MappedFile::close()
+{
+  if (data == nullptr)
+    return;
+
+#if defined(_WIN32)
+  UnmapViewOfFile(data);
+  CloseHandle(static_cast<HANDLE>(mapHandle));
+  CloseHandle(static_cast<HANDLE>(fileHandle));
+  fileHandle = nullptr;
+  mapHandle = nullptr;
+#else
+  munmap(const_cast<char *>(data), len);
+  ::close(fd);
+  fd = -1;
+#endif
+
+  data = nullptr;
+  len = 0;
+}
+
+
+bool MappedFile::isOpen() const
+{
+  return (data != nullptr);
+}
+
+
+const char * MappedFile::begin() const
+{
+  return data;
+}
+
+
+size_t MappedFile::size() const
+{
+  return len;
+}
+
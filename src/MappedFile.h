@@ -0,0 +1,57 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// A read-only memory mapping of a whole file.
+
+
+#ifndef BRIDGE_MAPPEDFILE_H
+#define BRIDGE_MAPPEDFILE_H
+
+#include <string>
+
+using namespace std;
+
+
+class MappedFile
+{
+  private:
+
+    const char * data;
+    size_t len;
+
+#if defined(_WIN32)
+    void * fileHandle;
+    void * mapHandle;
+#else
+    int fd;
+#endif
+
+
+  public:
+
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+    void reset();
+
+    bool open(const string& fname);
+
+    void close();
+
+    bool isOpen() const;
+
+    const char * begin() const;
+
+    size_t size() const;
+};
+
+#endif
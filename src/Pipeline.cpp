@@ -0,0 +1,118 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include "Pipeline.h"
+#include "Timers.h"
+
+// Queue slots per consumer thread.
+#define BRIDGE_PIPE_DEPTH 2
+
+
+Pipeline::Pipeline()
+{
+  Pipeline::reset();
+}
+
+
+Pipeline::~Pipeline()
+{
+  Pipeline::reset();
+}
+
+
+void Pipeline::reset()
+{
+  for (auto &q: queues)
+  {
+    for (auto item: q.items)
+      delete item;
+    q.items.clear();
+    q.capacity = BRIDGE_PIPE_DEPTH;
+    q.producers = 0;
+  }
+}
+
+
+void Pipeline::set(const Options& options)
+{
+  Pipeline::reset();
+  for (unsigned s = 0; s+1 < BRIDGE_STAGE_SIZE; s++)
+  {
+    queues[s].capacity = BRIDGE_PIPE_DEPTH * options.stageThreads[s+1];
+    queues[s].producers = options.stageThreads[s];
+  }
+}
+
+
+void Pipeline::push(
+  const PipeStage stage,
+  PipeItem * item,
+  Timers& timers)
+{
+  Queue& q = queues[stage];
+
+  timers.startStage(stage, BRIDGE_STAGE_BLOCKED);
+  unique_lock<mutex> lck(q.mtx);
+  q.notFull.wait(lck, [&q]
+  {
+    return q.items.size() < q.capacity;
+  });
+  q.items.push_back(item);
+  lck.unlock();
+  timers.stopStage(stage, BRIDGE_STAGE_BLOCKED);
+
+  q.notEmpty.notify_one();
+}
+
+
+bool Pipeline::pop(
+  const PipeStage stage,
+  PipeItem *& item,
+  Timers& timers)
+{
+  Queue& q = queues[stage-1];
+
+  timers.startStage(stage, BRIDGE_STAGE_STARVED);
+  unique_lock<mutex> lck(q.mtx);
+  q.notEmpty.wait(lck, [&q]
+  {
+    return ! q.items.empty() || q.producers == 0;
+  });
+
+  if (q.items.empty())
+  {
+    // All producers are done.
+    lck.unlock();
+    timers.stopStage(stage, BRIDGE_STAGE_STARVED);
+    return false;
+  }
+
+  timers.addOccupancy(stage, static_cast<unsigned>(q.items.size()));
+  item = q.items.front();
+  q.items.pop_front();
+  lck.unlock();
+  timers.stopStage(stage, BRIDGE_STAGE_STARVED);
+
+  q.notFull.notify_one();
+  return true;
+}
+
+
+void Pipeline::finish(const PipeStage stage)
+{
+  if (stage+1 >= BRIDGE_STAGE_SIZE)
+    return;
+
+  Queue& q = queues[stage];
+  lock_guard<mutex> lck(q.mtx);
+  if (q.producers > 0)
+    q.producers--;
+  q.notEmpty.notify_all();
+}
+
@@ -0,0 +1,93 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Pipeline connects the stages of the pipelined mode with bounded
+// queues of items, each of which carries one input file through the
+// stages.  A full queue blocks its producers, so a fast stage cannot
+// run arbitrarily far ahead of a slow one.
+
+
+#ifndef BRIDGE_PIPELINE_H
+#define BRIDGE_PIPELINE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+  #include "mingw.condition_variable.h"
+#else
+  #include <thread>
+  #include <mutex>
+  #include <condition_variable>
+#endif
+
+#include "Group.h"
+#include "RefLines.h"
+#include "bconst.h"
+
+class Timers;
+
+using namespace std;
+
+
+struct PipeItem
+{
+  FileTask task;
+  Group group;
+  RefLines refLines;
+  vector<string> texts; // One per output task, from the write stage
+};
+
+
+class Pipeline
+{
+  private:
+
+    // Queue number s feeds stage s+1.
+
+    struct Queue
+    {
+      deque<PipeItem *> items;
+      unsigned capacity;
+      unsigned producers;
+      mutex mtx;
+      condition_variable notFull;
+      condition_variable notEmpty;
+    };
+
+    Queue queues[BRIDGE_STAGE_SIZE-1];
+
+
+  public:
+
+    Pipeline();
+
+    ~Pipeline();
+
+    void reset();
+
+    void set(const Options& options);
+
+    void push(
+      const PipeStage stage,
+      PipeItem * item,
+      Timers& timers);
+
+    bool pop(
+      const PipeStage stage,
+      PipeItem *& item,
+      Timers& timers);
+
+    void finish(const PipeStage stage);
+};
+
+#endif
+
@@ -8,26 +8,17 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
-#include <map>
 #include <algorithm>
 
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.thread.h"
-  #include "mingw.mutex.h"
-#else
-  #include <thread>
-  #include <mutex>
-#endif
-
 #include "Play.h"
+#include "append.h"
 #include "Contract.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
-
-static mutex mtx;
+#include "ctable.h"
 
 
 #define PLAY_SEQ_INIT 28
@@ -62,28 +53,39 @@ struct CardInfo
 static string PLAY_NO_TO_CARD[PLAY_NUM_CARDS];
 static string PLAY_NO_TO_CARD_TXT[PLAY_NUM_CARDS];
 
-static map<string, CardInfo> PLAY_CARD_TO_INFO; // All syntaxes
-
 static CardInfo PLAY_NO_TO_INFO[PLAY_NUM_CARDS];
 
+// Cards are decoded directly from their two characters.
+// These tables are fixed at compile time.
+
+static constexpr unsigned playCharToSuit(const unsigned c)
+{
+  return (c == 'S' ? 0 : c == 'H' ? 1 : c == 'D' ? 2 : c == 'C' ? 3 :
+    BRIDGE_SUITS);
+}
+
+static constexpr unsigned playCharToRank(const unsigned c)
+{
+  return (c >= '2' && c <= '9' ? c - '2' :
+    c == 'T' ? 8 : c == 'J' ? 9 : c == 'Q' ? 10 : c == 'K' ? 11 :
+    c == 'A' ? 12 : BRIDGE_TRICKS);
+}
+
+static constexpr unsigned PLAY_CHAR_TO_SUIT[256] =
+  { CTABLE_256(playCharToSuit, 0) };
+static constexpr unsigned PLAY_CHAR_TO_RANK[256] =
+  { CTABLE_256(playCharToRank, 0) };
+
 static unsigned TRICK_RANKS[BRIDGE_DENOMS][BRIDGE_SUITS][PLAY_NUM_CARDS];
 
-static bool setPlayTables = false;
+static bool isStarLine(const StrView& line);
 
-static bool bothAreSpaces(char lhs, char rhs);
+static unsigned cardToNo(const string& text);
 
 
 Play::Play()
 {
   Play::reset();
-  if (! setPlayTables)
-  {
-    mtx.lock();
-    if (! setPlayTables)
-      Play::setTables();
-    setPlayTables = true;
-    mtx.unlock();
-  }
 }
 
 
@@ -95,6 +97,8 @@ Play::~Play()
 void Play::reset()
 {
   setDDFlag = false;
+  declarer = BRIDGE_PLAYER_NONE;
+  denom = BRIDGE_NOTRUMP;
 
   setDealFlag = false;
 
@@ -108,6 +112,12 @@ void Play::reset()
   tricksDecl = 0;
   tricksDef = 0;
 
+  for (unsigned t = 0; t < BRIDGE_TRICKS; t++)
+  {
+    leads[t].leader = BRIDGE_PLAYER_NONE;
+    leads[t].suit = BRIDGE_NOTRUMP;
+    leads[t].wonByDeclarer = false;
+  }
 }
 
 
@@ -129,12 +139,11 @@ void Play::setTables()
       s2 << PLAY_DENOMS[d % 4] << PLAY_CARDS_TXT[p];
       PLAY_NO_TO_CARD_TXT[no] = s2.str();
 
-      PLAY_CARD_TO_INFO[str].no = no;
-      PLAY_CARD_TO_INFO[str].bitValue = 1u << (p + 2); // DDS encoding
-      PLAY_CARD_TO_INFO[str].suit = d % 4;
-      PLAY_CARD_TO_INFO[str].rank = p;
-
-      PLAY_NO_TO_INFO[no] = PLAY_CARD_TO_INFO[str];
+      CardInfo& info = PLAY_NO_TO_INFO[no];
+      info.no = no;
+      info.bitValue = 1u << (p + 2); // DDS encoding
+      info.suit = d % 4;
+      info.rank = p;
     }
   }
 
@@ -240,15 +249,15 @@ unsigned Play::trickWinnerRelative() const
 }
 
 
-void Play::addTrickPBN(const string& text)
+void Play::addTrickPBN(const StrView& text)
 {
   // In PBN the cards are given starting with the opening leader,
   // even for later tricks.
 
-  string plays[BRIDGE_PLAYERS];
+  StrView plays[BRIDGE_PLAYERS];
   unsigned count;
   if (! getWords(text, plays, 4, count))
-    THROW("Not a valid PBN play line: " + text);
+    THROW("Not a valid PBN play line: " + view2str(text));
 
   unsigned offset = static_cast<unsigned>
     ((leads[trickToPlay].leader + 4 - leads[0].leader) % 4);
@@ -257,12 +266,29 @@ void Play::addTrickPBN(const string& text)
     unsigned pp = p % 4;
     if (pp >= count)
       continue;
-    if (plays[pp].at(0) != '-') // - and --
-      Play::addPlay(plays[pp]);
+    if (plays[pp].text[0] != '-') // - and --
+      Play::addPlay(view2str(plays[pp]));
   }
 }
 
 
+static unsigned cardToNo(const string& text)
+{
+  // Returns PLAY_NUM_CARDS if not a valid card such as "SA".
+  if (text.length() != 2)
+    return PLAY_NUM_CARDS;
+
+  const unsigned suit =
+    PLAY_CHAR_TO_SUIT[static_cast<unsigned char>(text[0])];
+  const unsigned rank =
+    PLAY_CHAR_TO_RANK[static_cast<unsigned char>(text[1])];
+  if (suit == BRIDGE_SUITS || rank == BRIDGE_TRICKS)
+    return PLAY_NUM_CARDS;
+
+  return BRIDGE_TRICKS * suit + rank;
+}
+
+
 void Play::addPlay(const string& text)
 {
   if (playOverFlag)
@@ -271,11 +297,11 @@ void Play::addPlay(const string& text)
   if (! setDealFlag)
     THROW("Holding not set");
 
-  auto it = PLAY_CARD_TO_INFO.find(text);
-  if (it == PLAY_CARD_TO_INFO.end())
+  const unsigned cardNo = cardToNo(text);
+  if (cardNo == PLAY_NUM_CARDS)
     THROW("Invalid card: '" + text + "'");
 
-  const CardInfo& info = it->second;
+  const CardInfo& info = PLAY_NO_TO_INFO[cardNo];
 
   Player leader = leads[trickToPlay].leader;
   Player player = static_cast<Player>
@@ -345,55 +371,60 @@ void Play::addPlay(const string& text)
 }
 
 
-static bool bothAreSpaces(char lhs, char rhs)
+static bool isStarLine(const StrView& line)
 {
-  // stackoverflow.com/questions/8362094/
-  // replace-multiple-spaces-with-one-space-in-a-string
-  return (lhs == rhs) && (lhs == ' ');
+  // Spaces, then a single *.
+  unsigned i = 0;
+  while (i < line.len && line.text[i] == ' ')
+    i++;
+  return (i+1 == line.len && line.text[i] == '*');
 }
 
 
-void Play::setPlaysPBN(const vector<string>& list)
+void Play::setPlaysPBN(
+  const StrView list[],
+  const unsigned count)
 {
   if (! setDDFlag)
     THROW("Declarer and denomination should be set by now");
 
+  if (count == 0)
+    THROW("Empty PBN play");
+
   Player opldr;
-  if (! char2player(list[0].at(0), opldr))
+  if (list[0].len == 0 || ! char2player(list[0].text[0], opldr))
     THROW("Not an opening leader");
 
   if ((declarer + 1) % 4 != opldr)
     THROW("Wrong opening leader");
 
-  const unsigned l = list.size();
-  for (unsigned i = 1; i < l; i++)
+  // getWords splits on any number of spaces, so there is no need to
+  // compress them.
+  for (unsigned i = 1; i < count; i++)
   {
-    // Compress adjacent spaces just to be sure.
-    string s = list[i];
-    auto new_end = unique(s.begin(), s.end(), bothAreSpaces);
-    s.erase(new_end, s.end());
-
     // Permit last line of *.
-    if (i == l-1 && (s == "*" || s == " *"))
+    if (i == count-1 && isStarLine(list[i]))
       break;
 
-    Play::addTrickPBN(s);
+    Play::addTrickPBN(list[i]);
   }
 }
 
 
-unsigned Play::getRotationalOffset(const vector<string>& cards) const
+unsigned Play::getRotationalOffset(
+  const string cards[],
+  const unsigned cs) const
 {
   // In early LIN_VG there were sometimes rotated tricks!
   const Player leader = leads[trickToPlay].leader;
 
-  for (unsigned offset = 0; offset < cards.size(); offset++)
+  for (unsigned offset = 0; offset < cs; offset++)
   {
-    auto it = PLAY_CARD_TO_INFO.find(cards[offset]);
-    if (it == PLAY_CARD_TO_INFO.end())
+    const unsigned cardNo = cardToNo(cards[offset]);
+    if (cardNo == PLAY_NUM_CARDS)
       THROW("Invalid card: '" + cards[offset] + "'");
 
-    const CardInfo& info = it->second;
+    const CardInfo& info = PLAY_NO_TO_INFO[cardNo];
 
     if ((holding[leader][info.suit] & info.bitValue))
       return offset;
@@ -403,80 +434,112 @@ unsigned Play::getRotationalOffset(const vector<string>& cards) const
 }
 
 
-void Play::setPlaysRBN(
-  const string& text,
+void Play::addTrickCards(
+  const string cards[],
+  const unsigned cs,
   const Format format)
 {
-  string str = text;
-  if (str.length() < 2)
-    THROW("String too short: " + str);
+  if (format == BRIDGE_FORMAT_LIN_VG && cs > 1)
+  {
+    const unsigned offset = Play::getRotationalOffset(cards, cs);
+    if (offset == BRIDGE_PLAYER_SIZE)
+    {
+      string st;
+      for (unsigned cn = 0; cn < cs; cn++)
+        st += cards[cn];
+      THROW("No rotational offset fits: " + st);
+    }
 
-  toUpper(str);
+    for (unsigned cn = offset; cn < offset + cs; cn++)
+      Play::addPlay(cards[cn % cs]);
+  }
+  else
+  {
+    for (unsigned cn = 0; cn < cs; cn++)
+      Play::addPlay(cards[cn]);
+  }
+}
 
-  int seen = static_cast<int>(count(str.begin(), str.end(), ':'));
-  if (seen > BRIDGE_TRICKS-1)
-    THROW("Too many colons in RBN " + str);
 
-  vector<string> tricks(BRIDGE_TRICKS);
-  tricks.clear();
-  tokenize(str, tricks, ":");
+void Play::addTrick(
+  const vector<string>& cards,
+  const Format format)
+{
+  const unsigned cs = static_cast<unsigned>(cards.size());
+  if (cs > BRIDGE_PLAYERS)
+    THROW("Too many plays in trick");
 
-  vector<string> cards;
-  for (unsigned t = 0; t < tricks.size(); t++)
-  {
-    const string& trick = tricks[t];
-    const unsigned l = static_cast<unsigned>(trick.length());
-    if (l < 2 || l > 8)
-      THROW("Bad RBN trick " + trick);
-
-    const char suitLed = trick.at(0); // Might be invalid
-    stringstream ss;
-    unsigned i = 0;
-    cards.clear();
-    while (i < l)
-    {
+  Play::addTrickCards(cards.data(), cs, format);
+}
 
-      ss.str("");
-      char next = trick.at(i);
-      if (next == PLAY_DENOMS[0] || next == PLAY_DENOMS[1] ||
-          next == PLAY_DENOMS[2] || next == PLAY_DENOMS[3])
-      {
-        ss << next << trick.at(i+1);
-        i += 2;
-      }
-      else
-      {
-        ss << suitLed << next;
-        i++;
-      }
-      cards.push_back(ss.str());
-    }
 
-    unsigned cs = cards.size();
-    if (cs > BRIDGE_PLAYERS)
+void Play::addTrick(
+  const string& trick,
+  const Format format)
+{
+  const unsigned l = static_cast<unsigned>(trick.length());
+  if (l < 2 || l > 8)
+    THROW("Bad RBN trick " + trick);
+
+  const char suitLed = trick.at(0); // Might be invalid
+  string cards[BRIDGE_PLAYERS];
+  unsigned cs = 0;
+  unsigned i = 0;
+  while (i < l)
+  {
+    if (cs == BRIDGE_PLAYERS)
       THROW("Too many plays in trick " + trick);
 
-    if (format == BRIDGE_FORMAT_LIN_VG && cs > 1)
+    const char next = trick.at(i);
+    if (next == PLAY_DENOMS[0] || next == PLAY_DENOMS[1] ||
+        next == PLAY_DENOMS[2] || next == PLAY_DENOMS[3])
     {
-      const unsigned offset = Play::getRotationalOffset(cards);
-      if (offset == BRIDGE_PLAYER_SIZE)
-        THROW("No rotational offset fits: " + tricks[t]);
-
-      for (unsigned cn = offset; cn < offset + cs; cn++)
-        Play::addPlay(cards[cn % cs]);
+      cards[cs++] = string(1, next) + trick.at(i+1);
+      i += 2;
     }
     else
     {
-      for (unsigned cn = 0; cn < cs; cn++)
-        Play::addPlay(cards[cn]);
+      cards[cs++] = string(1, suitLed) + next;
+      i++;
     }
   }
 
+  Play::addTrickCards(cards, cs, format);
+}
+
+
+void Play::finishPlays()
+{
   if (playOverFlag)
     Play::makeClaim(tricksDecl);
 }
 
 
+void Play::setPlaysRBN(
+  const string& text,
+  const Format format)
+{
+  string str = text;
+  if (str.length() < 2)
+    THROW("String too short: " + str);
+
+  toUpper(str);
+
+  int seen = static_cast<int>(count(str.begin(), str.end(), ':'));
+  if (seen > BRIDGE_TRICKS-1)
+    THROW("Too many colons in RBN " + str);
+
+  StrView tricks[BRIDGE_TRICKS];
+  unsigned numTricks;
+  tokenize(str2view(str), tricks, BRIDGE_TRICKS, numTricks, ":");
+
+  for (unsigned t = 0; t < numTricks; t++)
+    Play::addTrick(view2str(tricks[t]), format);
+
+  Play::finishPlays();
+}
+
+
 void Play::setPlays(
   const string& text,
   const Format format)
@@ -485,9 +548,12 @@ void Play::setPlays(
   {
     case BRIDGE_FORMAT_PBN:
       {
-        vector<string> lines;
-        str2lines(text, lines);
-        Play::setPlaysPBN(lines);
+        // The opening leader, the tricks and perhaps a line of *.
+        StrView lines[BRIDGE_TRICKS+2];
+        unsigned count;
+        if (! str2lines(str2view(text), lines, BRIDGE_TRICKS+2, count))
+          THROW("Too many lines in PBN play");
+        Play::setPlaysPBN(lines, count);
         break;
       }
 
@@ -533,8 +599,7 @@ void Play::undoPlay()
   unsigned cardUndone = sequence[len-1];
   len--;
 
-  string str = PLAY_NO_TO_CARD[cardUndone];
-  CardInfo& info = PLAY_CARD_TO_INFO[str];
+  const CardInfo& info = PLAY_NO_TO_INFO[cardUndone];
   Player pUndone = static_cast<Player>
     ((static_cast<unsigned>(leads[trickToPlay].leader) + cardToPlay) % 4);
   holding[pUndone][info.suit] ^= info.bitValue;
@@ -650,6 +715,108 @@ void Play::getPlayedBy(vector<Player>& playedBy) const
 }
 
 
+void Play::writeBDB(BDBWriter& bw) const
+{
+  bw.putBool(setDDFlag);
+  if (setDDFlag)
+  {
+    bw.putByte(declarer);
+    bw.putByte(denom);
+  }
+
+  // These are the cards not yet played.
+  bw.putBool(setDealFlag);
+  if (setDealFlag)
+  {
+    for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+      for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+        bw.putHolding(holding[p][s]);
+  }
+
+  bw.putByte(len);
+  for (unsigned l = 0; l < len; l++)
+    bw.putByte(sequence[l]);
+
+  bw.putBool(playOverFlag);
+  bw.putBool(claimMadeFlag);
+  bw.putByte(tricksDecl);
+  bw.putByte(tricksDef);
+
+  if (! setDDFlag)
+    return;
+
+  // Only the parts of the lead table that the play has reached.
+  for (unsigned t = 0; t <= trickToPlay && t < BRIDGE_TRICKS; t++)
+  {
+    bw.putByte(leads[t].leader);
+    if (t < trickToPlay || cardToPlay > 0)
+      bw.putByte(leads[t].suit);
+    if (t < trickToPlay)
+      bw.putBool(leads[t].wonByDeclarer);
+  }
+}
+
+
+void Play::readBDB(BDBReader& br)
+{
+  Play::reset();
+
+  setDDFlag = br.getBool();
+  if (setDDFlag)
+  {
+    declarer = static_cast<Player>(br.getByte());
+    denom = static_cast<Denom>(br.getByte());
+  }
+
+  setDealFlag = br.getBool();
+  if (setDealFlag)
+  {
+    for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+      for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+        holding[p][s] = br.getHolding();
+  }
+
+  len = br.getByte();
+  if (len > BRIDGE_PLAYERS * BRIDGE_TRICKS)
+    THROW("Too many cards played: " + STR(len));
+  if (len > lenMax)
+  {
+    lenMax = len;
+    sequence.resize(lenMax);
+  }
+
+  for (unsigned l = 0; l < len; l++)
+    sequence[l] = br.getByte();
+
+  // The position in the play follows from the number of cards.
+  trickToPlay = len / BRIDGE_PLAYERS;
+  cardToPlay = len % BRIDGE_PLAYERS;
+
+  playOverFlag = br.getBool();
+  claimMadeFlag = br.getBool();
+  tricksDecl = br.getByte();
+  tricksDef = br.getByte();
+
+  if (! setDDFlag)
+    return;
+
+  for (unsigned t = 0; t <= trickToPlay && t < BRIDGE_TRICKS; t++)
+  {
+    leads[t].leader = static_cast<Player>(br.getByte());
+    if (t < trickToPlay || cardToPlay > 0)
+      leads[t].suit = static_cast<Denom>(br.getByte());
+    if (t < trickToPlay)
+      leads[t].wonByDeclarer = br.getBool();
+  }
+}
+
+
+size_t Play::heapSize() const
+{
+  return sequence.capacity() * sizeof(unsigned);
+}
+
+
 bool Play::operator == (const Play& play2) const
 {
   // We don't require the holdings to be identical.
@@ -715,44 +882,38 @@ bool Play::operator <= (const Play& play2) const
 
 
 
-string Play::strLIN() const
+void Play::appendLIN(string& st) const
 {
-  stringstream ss;
   for (unsigned l = 0; l < len; l++)
   {
-    ss << "pc|" << PLAY_NO_TO_CARD[sequence[l]] << "|";
+    st += "pc|";
+    st += PLAY_NO_TO_CARD[sequence[l]];
+    st += "|";
     if (l % 4 == 3)
-      ss << "pg||";
+      st += "pg||";
   }
-  return ss.str();
 }
 
 
-string Play::strLIN_RP() const
+void Play::appendLIN_RP(string& st) const
 {
-  stringstream ss;
   for (unsigned t = 0; t < ((len+3) >> 2); t++)
   {
-    ss << "pc|";
+    st += "pc|";
     for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
     {
       unsigned pos = 4*t + p;
       if (pos >= len)
         break;
-      ss << PLAY_NO_TO_CARD[sequence[pos]];
+      st += PLAY_NO_TO_CARD[sequence[pos]];
     }
-    ss << "|pg||\n";
+    st += "|pg||\n";
   }
-  return ss.str();
 }
 
 
-string Play::strLIN_VG() const
+void Play::appendLIN_VG(string& st) const
 {
-  if (len == 0)
-    return "";
-
-  stringstream ss;
   for (unsigned t = 0; t < ((len+3) >> 2); t++)
   {
     for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
@@ -760,35 +921,37 @@ string Play::strLIN_VG() const
       unsigned pos = 4*t + p;
       if (pos >= len)
         break;
-      ss << "pc|" << PLAY_NO_TO_CARD[sequence[pos]] << "|";
+      st += "pc|";
+      st += PLAY_NO_TO_CARD[sequence[pos]];
+      st += "|";
     }
-    ss << "pg||\n";
+    st += "pg||\n";
   }
-  return ss.str();
 }
 
 
-string Play::strLIN_TRN() const
+void Play::appendLIN_TRN(string& st) const
 {
-  stringstream ss;
   for (unsigned l = 0; l < len; l++)
   {
-    ss << "pc|" << PLAY_NO_TO_CARD[sequence[l]] << "|";
+    st += "pc|";
+    st += PLAY_NO_TO_CARD[sequence[l]];
+    st += "|";
     if (l % 4 == 3 && (l != len-1 || len == PLAY_NUM_CARDS))
-      ss << "pg||";
+      st += "pg||";
   }
-  return ss.str();
 }
 
 
-string Play::strPBN() const
+void Play::appendPBN(string& st) const
 {
   if (len == 0)
-    return "";
+    return;
 
-  stringstream ss;
   Player openingLeader = leads[0].leader;
-  ss << "[Play \"" << PLAYER_NAMES_SHORT[openingLeader] << "\"]\n";
+  st += "[Play \"";
+  st += PLAYER_NAMES_SHORT[openingLeader];
+  st += "\"]\n";
   for (unsigned t = 0; t < trickToPlay; t++)
   {
     unsigned offset = t << 2;
@@ -797,10 +960,10 @@ string Play::strPBN() const
       unsigned p = offset + (static_cast<unsigned>(openingLeader) + 4u - 
         static_cast<unsigned>(leads[t].leader) + c) % 4;
       if (c > 0)
-        ss << " ";
-      ss << PLAY_NO_TO_CARD[sequence[p]];
+        st += " ";
+      st += PLAY_NO_TO_CARD[sequence[p]];
     }
-    ss << "\n";
+    st += "\n";
   }
 
   // The incomplete last trick is different with Pavlicek:
@@ -818,64 +981,42 @@ string Play::strPBN() const
         offset + (static_cast<unsigned>(openingLeader) + 4u - 
           static_cast<unsigned>(leads[trickToPlay].leader) + c) % 4;
       if (c > 0)
-        ss << " ";
+        st += " ";
       if (p < len)
       {
-        ss << PLAY_NO_TO_CARD[sequence[p]];
+        st += PLAY_NO_TO_CARD[sequence[p]];
         num--;
       }
       else
-        ss << "--";
+        st += "--";
       // For PBN behavior:  
       // else if (num > 0) 
-      //   ss << "- ";
+      //   st += "- ";
     }
-    ss << "\n";
+    st += "\n";
   }
 
   // For PBN behavior:
   // if (claimMadeFlag)
-  ss << "*\n";
-
-  return ss.str();
+  st += "*\n";
 }
 
 
-string Play::strRBNCore() const
+void Play::appendRBNCore(string& st) const
 {
-  stringstream ss;
   for (unsigned l = 0; l < len; l++)
   {
     if (l % 4 == 0)
-      ss << PLAY_NO_TO_CARD[sequence[l]];
+      st += PLAY_NO_TO_CARD[sequence[l]];
     else if (PLAY_NO_TO_INFO[sequence[l]].suit != 
         static_cast<unsigned>(leads[l >> 2].suit))
-      ss << PLAY_NO_TO_CARD[sequence[l]];
+      st += PLAY_NO_TO_CARD[sequence[l]];
     else
-      ss << PLAY_CARDS[PLAY_NO_TO_INFO[sequence[l]].rank];
+      st += PLAY_CARDS[PLAY_NO_TO_INFO[sequence[l]].rank];
 
     if (l % 4 == 3 && l != len-1)
-      ss << ":";
+      st += ":";
   }
-  return ss.str();
-}
-
-
-string Play::strRBN() const
-{
-  if (len == 0)
-    return "";
-  else
-    return "P " + Play::strRBNCore() + "\n";
-}
-
-
-string Play::strRBX() const
-{
-  if (len == 0)
-    return "";
-  else
-    return "P{" + Play::strRBNCore() + "}";
 }
 
 
@@ -884,26 +1025,19 @@ string Play::strTXT() const
   if (len == 0)
     return "";
 
-  stringstream ss;
   if (len == 1)
-  {
-    ss << "Lead: " << PLAY_NO_TO_CARD_TXT[sequence[0]] << "\n";
-    return ss.str();
-  }
+    return "Lead: " + PLAY_NO_TO_CARD_TXT[sequence[0]] + "\n";
 
-  ss << setw(5) << "Trick" <<
-    setw(7) << "Lead" <<
-    setw(7) << "2nd" <<
-    setw(7) << "3rd" <<
-    setw(7) << "4th" << "\n";
+  string st = "Trick   Lead    2nd    3rd    4th\n";
 
   for (unsigned t = 0; t < ((len+3) >> 2); t++)
   {
-    ss << t+1 << ". " << PLAYER_NAMES_SHORT[leads[t].leader];
+    appendUnsigned(st, t+1);
+    st += ". " + PLAYER_NAMES_SHORT[leads[t].leader];
     if (t >= 9)
-      ss << "   ";
+      st += "   ";
     else
-      ss << "    ";
+      st += "    ";
 
     for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
     {
@@ -912,60 +1046,62 @@ string Play::strTXT() const
         break;
 
       // Pavlicek?
-      const int width = (p == 0 ? 8 : 7);
+      const unsigned width = (p == 0 ? 8 : 7);
 
       // Full card when lead or when other suit than lead.
-      const string st = (p == 0 || 
+      const string card = (p == 0 || 
           PLAY_NO_TO_INFO[sequence[pp]].suit != 
           static_cast<unsigned>(leads[t].suit) ?
           PLAY_NO_TO_CARD_TXT[sequence[pp]] :
           PLAY_CARDS_TXT[PLAY_NO_TO_INFO[sequence[pp]].rank]);
 
         if (p == 3 || pp == len-1)
-          ss << st;
+          st += card;
         else
-          ss << setw(width) << left << st;
+          appendLeft(st, card, width);
     }
-    ss << "\n";
+    st += "\n";
   }
 
-  return ss.str();
+  return st;
 }
 
 
 string Play::strEML() const
 {
-  stringstream ss;
-  ss << " ";
+  string st = " ";
   for (unsigned l = 0; l < (len+3) >> 2; l++)
-    ss << setw(3) << l+1;
-  ss << "\n";
+    appendUnsigned(st, l+1, 3);
+  st += "\n";
 
-  stringstream ps[BRIDGE_PLAYERS];
+  string ps[BRIDGE_PLAYERS];
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
-    ps[p] << PLAYER_NAMES_SHORT[(p+3) % 4];
+    ps[p] = PLAYER_NAMES_SHORT[(p+3) % 4];
 
   for (unsigned l = 0; l < len; l++)
   {
     unsigned t = l >> 2;
     unsigned pEML = (static_cast<unsigned>(leads[t].leader) + 1u + l) % 4;
     if (t > 0 && l % 4 == 0)
-      ps[pEML] << "-";
+      ps[pEML] += "-";
     else
-      ps[pEML] << " ";
+      ps[pEML] += " ";
 
     if (l % 4 == 0)
-      ps[pEML] << setw(2) << PLAY_NO_TO_CARD[sequence[l]];
+      appendRight(ps[pEML], PLAY_NO_TO_CARD[sequence[l]], 2);
     else if (PLAY_NO_TO_INFO[sequence[l]].suit != 
         static_cast<unsigned>(leads[l >> 2].suit))
-      ps[pEML] << setw(2) << PLAY_NO_TO_CARD[sequence[l]];
+      appendRight(ps[pEML], PLAY_NO_TO_CARD[sequence[l]], 2);
     else
-      ps[pEML] << setw(2) << PLAY_CARDS[PLAY_NO_TO_INFO[sequence[l]].rank];
+    {
+      ps[pEML] += " ";
+      ps[pEML] += PLAY_CARDS[PLAY_NO_TO_INFO[sequence[l]].rank];
+    }
   }
 
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
-    ss << ps[p].str() << "\n";
-  return ss.str();
+    st += ps[p] + "\n";
+  return st;
 }
 
 
@@ -974,12 +1110,13 @@ string Play::strREC() const
   if (len == 0)
     return "";
 
-  stringstream ss;
+  string st;
 
   for (unsigned t = 0; t < ((len+3) >> 2); t++)
   {
-    ss << setw(2) << right << t+1 << "  " << 
-        setw(6) << left << PLAYER_NAMES_LONG[leads[t].leader];
+    appendUnsigned(st, t+1, 2);
+    st += "  ";
+    appendLeft(st, PLAYER_NAMES_LONG[leads[t].leader], 6);
 
     for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
     {
@@ -988,23 +1125,25 @@ string Play::strREC() const
         break;
 
       if (p == 0)
-        ss << setw(3) << right << PLAY_NO_TO_CARD[sequence[pp]];
+        appendRight(st, PLAY_NO_TO_CARD[sequence[pp]], 3);
       else if (PLAY_NO_TO_INFO[sequence[pp]].suit != 
           static_cast<unsigned>(leads[t].suit))
       {
-        ss << setw(3) << right << PLAY_NO_TO_CARD[sequence[pp]];
+        appendRight(st, PLAY_NO_TO_CARD[sequence[pp]], 3);
       }
       else
-        ss << setw(3) << right << 
-            PLAY_CARDS[PLAY_NO_TO_INFO[sequence[pp]].rank];
+      {
+        st += "  ";
+        st += PLAY_CARDS[PLAY_NO_TO_INFO[sequence[pp]].rank];
+      }
 
       if (p != 3 && pp != len-1)
-        ss << ",";
+        st += ",";
     }
-    ss << "\n";
+    st += "\n";
   }
 
-  return ss.str() + "\n";
+  return st + "\n";
 }
 
 
@@ -1018,42 +1157,65 @@ string Play::strPAR() const
 }
 
 
-string Play::str(const Format format) const
+void Play::appendStr(
+  string& st,
+  const Format format) const
 {
   switch(format)
   {
     case BRIDGE_FORMAT_LIN:
-      return Play::strLIN();
+      Play::appendLIN(st);
+      break;
 
     case BRIDGE_FORMAT_LIN_RP:
-      return Play::strLIN_RP();
+      Play::appendLIN_RP(st);
+      break;
 
     case BRIDGE_FORMAT_LIN_VG:
-      return Play::strLIN_VG();
+      Play::appendLIN_VG(st);
+      break;
 
     case BRIDGE_FORMAT_LIN_TRN:
-      return Play::strLIN_TRN();
+      Play::appendLIN_TRN(st);
+      break;
 
     case BRIDGE_FORMAT_PBN:
-      return Play::strPBN();
+      Play::appendPBN(st);
+      break;
 
     case BRIDGE_FORMAT_RBN:
-      return Play::strRBN();
+      if (len > 0)
+      {
+        st += "P ";
+        Play::appendRBNCore(st);
+        st += "\n";
+      }
+      break;
 
     case BRIDGE_FORMAT_RBX:
-      return Play::strRBX();
+      if (len > 0)
+      {
+        st += "P{";
+        Play::appendRBNCore(st);
+        st += "}";
+      }
+      break;
 
     case BRIDGE_FORMAT_TXT:
-      return Play::strTXT();
+      st += Play::strTXT();
+      break;
 
     case BRIDGE_FORMAT_EML:
-      return Play::strEML();
+      st += Play::strEML();
+      break;
 
     case BRIDGE_FORMAT_REC:
-      return Play::strREC();
+      st += Play::strREC();
+      break;
 
     case BRIDGE_FORMAT_PAR:
-      return Play::strPAR();
+      st += Play::strPAR();
+      break;
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -1061,6 +1223,14 @@ string Play::str(const Format format) const
 }
 
 
+string Play::str(const Format format) const
+{
+  string st;
+  Play::appendStr(st, format);
+  return st;
+}
+
+
 string Play::strLead(const Format format) const
 {
   switch(format)
@@ -1107,7 +1277,7 @@ string Play::strClaimLIN() const
   if (! claimMadeFlag)
     return "";
 
-  return "mc|" + STR(tricksDecl) + "|";
+  return "mc|" + to_string(tricksDecl) + "|";
   
 }
 
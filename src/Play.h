@@ -13,11 +13,16 @@
 #include <string>
 
 #include "bconst.h"
+#include "Arena.h"
 #include "ddsIF.h"
 
 using namespace std;
 
+
+class BDBWriter;
+class BDBReader;
 class Contract;
+struct StrView;
 
 
 enum playStatus
@@ -64,7 +69,7 @@ class Play
 
     unsigned len;
     unsigned lenMax;
-    vector<unsigned> sequence;
+    ArenaVector<unsigned> sequence;
 
     unsigned trickToPlay;
     unsigned cardToPlay;
@@ -76,34 +81,37 @@ class Play
     LeadInfo leads[BRIDGE_TRICKS];
 
 
-    void setTables();
-
     void setDeclAndDenom(
       const Player decl,
       const Denom denom);
     
     unsigned trickWinnerRelative() const;
 
-    void addPlay(const string& text);
+    unsigned getRotationalOffset(
+      const string cards[],
+      const unsigned cs) const;
 
-    unsigned getRotationalOffset(const vector<string>& cards) const;
+    void addTrickCards(
+      const string cards[],
+      const unsigned cs,
+      const Format format);
 
-    void addTrickPBN(const string& text); // Currently unused
+    void addTrickPBN(const StrView& text);
     
-    void setPlaysPBN(const vector<string>& list);
+    void setPlaysPBN(
+      const StrView list[],
+      const unsigned count);
 
     void setPlaysRBN(
       const string& text,
       const Format format);
     
-    string strLIN() const;
-    string strLIN_VG() const;
-    string strLIN_TRN() const;
-    string strLIN_RP() const;
-    string strPBN() const;
-    string strRBNCore() const;
-    string strRBN() const;
-    string strRBX() const;
+    void appendLIN(string& st) const;
+    void appendLIN_VG(string& st) const;
+    void appendLIN_TRN(string& st) const;
+    void appendLIN_RP(string& st) const;
+    void appendPBN(string& st) const;
+    void appendRBNCore(string& st) const;
     string strEML() const;
     string strTXT() const;
     string strREC() const;
@@ -118,6 +126,8 @@ class Play
 
     ~Play();
 
+    static void setTables();
+
     void reset();
 
     void setContract(const Contract& contract);
@@ -127,6 +137,19 @@ class Play
     void setPlays(
       const string& text,
       const Format format);
+
+    // Card by card, as the LIN reader delivers them.
+    void addPlay(const string& text);
+
+    void addTrick(
+      const vector<string>& cards,
+      const Format format);
+
+    void addTrick(
+      const string& trick,
+      const Format format);
+
+    void finishPlays();
     
     void undoPlay();
 
@@ -144,10 +167,20 @@ class Play
 
     void getPlayedBy(vector<Player>& playedBy) const;
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
+    size_t heapSize() const;
+
     bool operator == (const Play& play2) const;
     bool operator != (const Play& play2) const;
     bool operator <= (const Play& play2) const;
 
+    // The file writers append straight onto their output text.
+    void appendStr(
+      string& st,
+      const Format format) const;
+
     string str(const Format format) const;
 
     string strLead(const Format format) const;
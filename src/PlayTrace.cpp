@@ -235,6 +235,15 @@ void PlayTrace::set(
 }
 
 
+size_t PlayTrace::heapSize() const
+{
+  // A list node also holds two pointers.
+  return tricks.capacity() * sizeof(unsigned) +
+    playedBy.capacity() * sizeof(Player) +
+    playErrors.size() * (sizeof(PlayErrorRecord) + 2 * sizeof(void *));
+}
+
+
 bool PlayTrace::operator == (const PlayTrace& pt2) const
 {
   if (len != pt2.len)
@@ -87,6 +87,8 @@ class PlayTrace
       const vector<Player>& playedByIn,
       const vector<PlayError>& playErrorIn);
 
+    size_t heapSize() const;
+
     bool operator == (const PlayTrace& pt2) const;
 
     bool operator != (const PlayTrace& pt2) const;
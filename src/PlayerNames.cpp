@@ -0,0 +1,107 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <unordered_map>
+#include <cstdlib>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+  #include "mingw.mutex.h"
+#else
+  #include <thread>
+  #include <mutex>
+#endif
+
+#include "PlayerNames.h"
+#include "parse.h"
+#include "Bexcept.h"
+
+// The names are kept in chunks that never move, so a name can be
+// looked up by its number without taking the lock.
+#define NAME_CHUNK_BITS 12
+#define NAME_CHUNK (1u << NAME_CHUNK_BITS)
+#define NAME_CHUNKS 4096
+
+
+static mutex mtx;
+static unordered_map<string, unsigned> nameToId;
+static string * chunks[NAME_CHUNKS];
+static unsigned numNames = 1;
+
+static const string emptyName = "";
+
+// Each thread remembers its own answers, so no lock is needed.
+static thread_local unordered_map<unsigned long long, bool> similarCache;
+
+
+unsigned PlayerNames::intern(const string& name)
+{
+  if (name.empty())
+    return 0;
+
+  lock_guard<mutex> lck(mtx);
+
+  auto it = nameToId.find(name);
+  if (it != nameToId.end())
+    return it->second;
+
+  const unsigned id = numNames;
+  const unsigned chunk = id >> NAME_CHUNK_BITS;
+  if (chunk >= NAME_CHUNKS)
+    THROW("Too many player names");
+  if (chunks[chunk] == nullptr)
+    chunks[chunk] = new string[NAME_CHUNK];
+
+  chunks[chunk][id & (NAME_CHUNK-1)] = name;
+  nameToId[name] = id;
+  numNames++;
+  return id;
+}
+
+
+const string& PlayerNames::name(const unsigned id)
+{
+  if (id == 0)
+    return emptyName;
+  return chunks[id >> NAME_CHUNK_BITS][id & (NAME_CHUNK-1)];
+}
+
+
+unsigned PlayerNames::size()
+{
+  lock_guard<mutex> lck(mtx);
+  return numNames;
+}
+
+
+bool PlayerNames::similar(
+  const unsigned id1,
+  const unsigned id2)
+{
+  if (id1 == id2)
+    return true;
+
+  const unsigned long long key = (id1 < id2 ?
+    (static_cast<unsigned long long>(id1) << 32) | id2 :
+    (static_cast<unsigned long long>(id2) << 32) | id1);
+
+  auto it = similarCache.find(key);
+  if (it != similarCache.end())
+    return it->second;
+
+  const string& s1 = PlayerNames::name(id1);
+  const string& s2 = PlayerNames::name(id2);
+  const int l1 = static_cast<int>(s1.length());
+  const int l2 = static_cast<int>(s2.length());
+  const bool b = (abs(l1-l2) <= 2 && levenshtein_test(s1, s2, 2));
+
+  similarCache[key] = b;
+  return b;
+}
+
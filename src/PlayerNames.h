@@ -0,0 +1,42 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Player names are interned once for the whole process, so that the
+// model only keeps a number per name.  Number 0 is the empty name.
+// A number stays valid for as long as the process runs, and the same
+// name always gets the same number, also across threads.  So names
+// are the same exactly when their numbers are.
+
+
+#ifndef BRIDGE_PLAYERNAMES_H
+#define BRIDGE_PLAYERNAMES_H
+
+#include <string>
+
+using namespace std;
+
+
+class PlayerNames
+{
+  public:
+
+    static unsigned intern(const string& name);
+
+    static const string& name(const unsigned id);
+
+    static unsigned size();
+
+    // Within an edit distance of 2.  Each thread works out the answer
+    // for a pair of different names once and then remembers it.
+    static bool similar(
+      const unsigned id1,
+      const unsigned id2);
+};
+
+#endif
+
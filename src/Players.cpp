@@ -7,13 +7,15 @@
 */
 
 
-#include <iomanip>
 #include <sstream>
 #include <algorithm>
 #include <vector>
 
 #include "Players.h"
+#include "PlayerNames.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -29,6 +31,9 @@ static const string ROOM_PBN[] =
   "Open", "Closed", ""
 };
 
+// The numbers of the seat names, which count as no name.
+static unsigned SEAT_IDS[BRIDGE_PLAYERS];
+
 
 
 Players::Players()
@@ -42,15 +47,28 @@ Players::~Players()
 }
 
 
+void Players::setTables()
+{
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    SEAT_IDS[p] = PlayerNames::intern(PLAYER_NAMES_LONG[p]);
+}
+
+
 void Players::reset()
 {
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
-    players[p] = "";
+    players[p] = 0;
 
   roomVal = BRIDGE_ROOM_UNDEFINED;
 }
 
 
+const string& Players::name(const unsigned p) const
+{
+  return PlayerNames::name(players[p]);
+}
+
+
 void Players::setRBNSide(
   const string& text,
   const Player p1,
@@ -67,8 +85,8 @@ void Players::setRBNSide(
   v.clear();
   tokenize(text, v, "+");
 
-  players[p1] = v[0];
-  players[p2] = v[1];
+  players[p1] = PlayerNames::intern(v[0]);
+  players[p2] = PlayerNames::intern(v[1]);
 }
 
 
@@ -107,21 +125,21 @@ void Players::setLIN(
   }
   else if (hardFlag)
   {
-    players[BRIDGE_SOUTH] = v[start];
-    players[BRIDGE_WEST] = v[start+1];
-    players[BRIDGE_NORTH] = v[start+2];
-    players[BRIDGE_EAST] = v[start+3];
+    players[BRIDGE_SOUTH] = PlayerNames::intern(v[start]);
+    players[BRIDGE_WEST] = PlayerNames::intern(v[start+1]);
+    players[BRIDGE_NORTH] = PlayerNames::intern(v[start+2]);
+    players[BRIDGE_EAST] = PlayerNames::intern(v[start+3]);
   }
   else
   {
     if (v[start] != "")
-      players[BRIDGE_SOUTH] = v[start];
+      players[BRIDGE_SOUTH] = PlayerNames::intern(v[start]);
     if (v[start+1] != "")
-      players[BRIDGE_WEST] = v[start+1];
+      players[BRIDGE_WEST] = PlayerNames::intern(v[start+1]);
     if (v[start+2] != "")
-      players[BRIDGE_NORTH] = v[start+2];
+      players[BRIDGE_NORTH] = PlayerNames::intern(v[start+2]);
     if (v[start+3] != "")
-      players[BRIDGE_EAST] = v[start+3];
+      players[BRIDGE_EAST] = PlayerNames::intern(v[start+3]);
   }
 }
 
@@ -181,13 +199,13 @@ void Players::set(const string list[])
   else
   {
     if (list[0] != "")
-      players[BRIDGE_NORTH] = list[0];
+      players[BRIDGE_NORTH] = PlayerNames::intern(list[0]);
     if (list[1] != "")
-      players[BRIDGE_EAST] = list[1];
+      players[BRIDGE_EAST] = PlayerNames::intern(list[1]);
     if (list[2] != "")
-      players[BRIDGE_SOUTH] = list[2];
+      players[BRIDGE_SOUTH] = PlayerNames::intern(list[2]);
     if (list[3] != "")
-      players[BRIDGE_WEST] = list[3];
+      players[BRIDGE_WEST] = PlayerNames::intern(list[3]);
   }
 }
 
@@ -209,7 +227,7 @@ void Players::setPlayer(
   else
     THROW("Player out of bounds");
 
-  players[p] = name;
+  players[p] = PlayerNames::intern(name);
 }
 
 
@@ -294,7 +312,7 @@ unsigned Players::missing() const
   unsigned m = 0;
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
   {
-    if (players[p] == "" || players[p] == PLAYER_NAMES_LONG[p])
+    if (players[p] == 0 || players[p] == SEAT_IDS[p])
       m++;
   }
   return m;
@@ -305,32 +323,64 @@ bool Players::overlap(const Players& players2) const
 {
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
   {
-    if (players[p] == "" || players[p] == PLAYER_NAMES_LONG[p])
+    if (players[p] == 0 || players[p] == SEAT_IDS[p])
       continue;
 
-    for (unsigned p2 = 0; p2 < BRIDGE_PLAYERS; p2++)
-      if (players[p] == players2.players[p])
-        return true;
+    if (players[p] == players2.players[p])
+      return true;
   }
   return false;
 }
 
 
+bool Players::same(const Players& players2) const
+{
+  // Unlike operator ==, this is exact and does not throw.
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+  {
+    if (players[p] != players2.players[p])
+      return false;
+  }
+  return (roomVal == players2.roomVal);
+}
+
+
+void Players::writeBDB(BDBWriter& bw) const
+{
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    bw.putString(Players::name(p));
+  bw.putByte(roomVal);
+}
+
+
+void Players::readBDB(BDBReader& br)
+{
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    players[p] = PlayerNames::intern(br.getString());
+  roomVal = static_cast<Room>(br.getByte());
+}
+
+
+size_t Players::heapSize() const
+{
+  // The names themselves are shared in PlayerNames.
+  return 0;
+}
+
+
 bool Players::operator == (const Players& players2) const
 {
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
     if (players[p] != players2.players[p])
     {
-      if ((players[p] == "" && 
-          players2.players[p] == PLAYER_NAMES_LONG[p]) || 
-          (players[p] == PLAYER_NAMES_LONG[p] && 
-          players2.players[p] == ""))
+      if ((players[p] == 0 && players2.players[p] == SEAT_IDS[p]) ||
+          (players[p] == SEAT_IDS[p] && players2.players[p] == 0))
       {
         // Accept.
       }
       else
         DIFF("Players differ: '" + 
-             players[p] + "' vs '" + players2.players[p] + "'");
+             Players::name(p) + "' vs '" + players2.name(p) + "'");
     }
 
   if (roomVal != players2.roomVal)
@@ -349,23 +399,21 @@ bool Players::operator != (const Players& players2) const
 string Players::strLIN() const
 {
   return 
-    players[BRIDGE_SOUTH] + "," +
-    players[BRIDGE_WEST] + "," +
-    players[BRIDGE_NORTH] + "," +
-    players[BRIDGE_EAST];
+    Players::name(BRIDGE_SOUTH) + "," +
+    Players::name(BRIDGE_WEST) + "," +
+    Players::name(BRIDGE_NORTH) + "," +
+    Players::name(BRIDGE_EAST);
 }
 
 
 string Players::strRBNCore() const
 {
-  stringstream ss;
-  if (players[BRIDGE_NORTH] != "" || players[BRIDGE_SOUTH] != "")
-    ss << players[BRIDGE_NORTH] << "+" << players[BRIDGE_SOUTH];
-  ss << ":";
-  if (players[BRIDGE_WEST] != "" || players[BRIDGE_EAST] != "")
-    ss << players[BRIDGE_WEST] << "+" << players[BRIDGE_EAST];
-
-  string st = ss.str();
+  string st;
+  if (players[BRIDGE_NORTH] != 0 || players[BRIDGE_SOUTH] != 0)
+    st += Players::name(BRIDGE_NORTH) + "+" + Players::name(BRIDGE_SOUTH);
+  st += ":";
+  if (players[BRIDGE_WEST] != 0 || players[BRIDGE_EAST] != 0)
+    st += Players::name(BRIDGE_WEST) + "+" + Players::name(BRIDGE_EAST);
 
   if (roomVal == BRIDGE_ROOM_OPEN)
     st += ":O";
@@ -389,16 +437,16 @@ string Players::strRBX() const
 
 string Players::strTXT() const
 {
-  stringstream ss;
+  string st;
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
   {
     const unsigned pTXT = PLAYER_DDS_TO_TXT[p];
     const unsigned l = 1u + 
-      static_cast<unsigned>(Max(11, players[pTXT].length()));
-    ss << setw(static_cast<int>(l)) << left << players[pTXT];
+      static_cast<unsigned>(Max(11, Players::name(pTXT).length()));
+    appendLeft(st, Players::name(pTXT), l);
   }
 
-  string st = trimTrailing(ss.str());
+  st = trimTrailing(st);
   if (st == "")
     return "";
   else
@@ -408,18 +456,15 @@ string Players::strTXT() const
 
 string Players::strREC() const
 {
-  stringstream s;
-  s << setw(9) << left << "West" <<
-      setw(9) << left << "North" <<
-      setw(9) << left << "East" <<
-      "South\n";
-
-  s << setw(8) << left << players[BRIDGE_WEST].substr(0, 8) << " " <<
-      setw(8) << left << players[BRIDGE_NORTH].substr(0, 8) << " " <<
-      setw(8) << left << players[BRIDGE_EAST].substr(0, 8) << " " <<
-      players[BRIDGE_SOUTH].substr(0, 8) << "\n";
-
-  return s.str();
+  string st = "West     North    East     South\n";
+
+  appendLeft(st, Players::name(BRIDGE_WEST).substr(0, 8), 8);
+  st += " ";
+  appendLeft(st, Players::name(BRIDGE_NORTH).substr(0, 8), 8);
+  st += " ";
+  appendLeft(st, Players::name(BRIDGE_EAST).substr(0, 8), 8);
+  st += " ";
+  return st + Players::name(BRIDGE_SOUTH).substr(0, 8) + "\n";
 }
 
 
@@ -470,7 +515,7 @@ string Players::strDelta(
       {
         unsigned pLIN = PLAYER_DDS_TO_LIN[p];
         if (players[pLIN] != refPlayers.players[pLIN])
-          st += players[pLIN];
+          st += Players::name(pLIN);
         st += ",";
       }
       return st;
@@ -489,20 +534,20 @@ string Players::strPlayer(
   {
     case BRIDGE_FORMAT_PBN:
       return "[" + PLAYER_NAMES_LONG[player] + " \"" +
-        players[player] + "\"]\n";
+        Players::name(player) + "\"]\n";
     
     case BRIDGE_FORMAT_TXT:
     case BRIDGE_FORMAT_PAR:
-      return players[player];
+      return Players::name(player);
     
     case BRIDGE_FORMAT_EML:
-      return players[player].substr(0, 8);
+      return Players::name(player).substr(0, 8);
 
     case BRIDGE_FORMAT_REC:
-      if (players[player] == "")
+      if (players[player] == 0)
         return PLAYER_NAMES_LONG[player];
       else
-        return players[player].substr(0, 11);
+        return Players::name(player).substr(0, 11);
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -523,7 +568,7 @@ string Players::strRoom(
     case BRIDGE_FORMAT_LIN_RP:
     case BRIDGE_FORMAT_LIN_VG:
     case BRIDGE_FORMAT_LIN_TRN:
-      return "qx|" + ROOM_LIN[roomVal] + STR(no) + "|";
+      return "qx|" + ROOM_LIN[roomVal] + to_string(no) + "|";
     
     case BRIDGE_FORMAT_PBN:
       return "[Room \"" + ROOM_PBN[roomVal] + "\"]\n";
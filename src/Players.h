@@ -17,14 +17,21 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Players
 {
   private:
 
-    string players[BRIDGE_PLAYERS];
+    // Interned in PlayerNames.
+    unsigned players[BRIDGE_PLAYERS];
 
     Room roomVal;
 
+    const string& name(const unsigned p) const;
+
     void setRBNSide(
       const string& side,
       const Player p1,
@@ -49,6 +56,8 @@ class Players
 
     ~Players();
 
+    static void setTables();
+
     void reset();
 
     void set(
@@ -75,6 +84,12 @@ class Players
 
     unsigned missing() const;
     bool overlap(const Players& players2) const;
+    bool same(const Players& players2) const;
+
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
+    size_t heapSize() const;
 
     bool operator == (const Players& players2) const;
     bool operator != (const Players& players2) const;
@@ -12,14 +12,6 @@
 #include <regex>
 #include <map>
 
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.thread.h"
-  #include "mingw.mutex.h"
-#else
-  #include <thread>
-  #include <mutex>
-#endif
-
 #include "RefComment.h"
 #include "parse.h"
 #include "Bexcept.h"
@@ -473,21 +465,10 @@ static map<string, RefTag> TagMap;
 static bool ActionCommentOK[REF_ACTION_SIZE][ERR_SIZE];
 static bool TagCommentOK[REF_TAGS_SIZE][ERR_SIZE];
 
-static mutex mtx;
-static bool setTablesFlag = false;
-
 
 RefComment::RefComment()
 {
   RefComment::reset();
-  if (! setTablesFlag)
-  {
-    mtx.lock();
-    if (! setTablesFlag)
-      RefComment::setTables();
-    setTablesFlag = true;
-    mtx.unlock();
-  }
 }
 
 
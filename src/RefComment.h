@@ -29,11 +29,10 @@ class RefComment
   unsigned count1, count2, count3;
   string quote;
 
-  void setTables();
-  void setCommentMap();
-  void setRefTag();
-  void setActionTable();
-  void setTagTable();
+  static void setCommentMap();
+  static void setRefTag();
+  static void setActionTable();
+  static void setTagTable();
 
   RefTag str2ref(const string& refstr) const;
 
@@ -44,6 +43,8 @@ class RefComment
 
     ~RefComment();
 
+    static void setTables();
+
     void reset();
 
     void parse(
@@ -13,6 +13,7 @@
 
 #include "RefStats.h"
 #include "RefComment.h"
+#include "parse.h"
 #include "Bexcept.h"
 
 using namespace std;
@@ -73,6 +74,13 @@ void RefStats::reset()
 }
 
 
+bool RefStats::emptyRefEntry(const RefEntry& re) const
+{
+  return (re.files == 0 && re.noRefLines == 0 && re.count.lines == 0 &&
+    re.count.units == 0 && re.count.hands == 0 && re.count.boards == 0);
+}
+
+
 void RefStats::incrRefEntry(
   RefEntry& re,
   const RefEntry& re2) const
@@ -203,6 +211,72 @@ void RefStats::operator +=(const RefStats& rf2)
 }
 
 
+void RefStats::serialize(ostream& fout) const
+{
+  for (unsigned table = 0; table < REFSTATS_SIZE; table++)
+    writeField(fout, numFiles[table]);
+
+  unsigned n = 0;
+  for (unsigned table = 0; table < REFSTATS_SIZE; table++)
+    for (unsigned cat = 0; cat < ERR_SIZE; cat++)
+      if (! RefStats::emptyRefEntry(data[table][cat]))
+        n++;
+
+  writeField(fout, n);
+  for (unsigned table = 0; table < REFSTATS_SIZE; table++)
+  {
+    for (unsigned cat = 0; cat < ERR_SIZE; cat++)
+    {
+      const RefEntry& re = data[table][cat];
+      if (RefStats::emptyRefEntry(re))
+        continue;
+
+      writeField(fout, table);
+      writeField(fout, cat);
+      writeField(fout, re.files);
+      writeField(fout, re.noRefLines);
+      writeField(fout, re.count.lines);
+      writeField(fout, re.count.units);
+      writeField(fout, re.count.hands);
+      writeField(fout, re.count.boards);
+    }
+  }
+}
+
+
+void RefStats::deserialize(istream& fin)
+{
+  // Adds to the stats, like +=.
+  unsigned u;
+  for (unsigned table = 0; table < REFSTATS_SIZE; table++)
+  {
+    readField(fin, u);
+    numFiles[table] += u;
+  }
+
+  unsigned n, table, cat;
+  RefEntry re;
+  readField(fin, n);
+  for (unsigned i = 0; i < n; i++)
+  {
+    readField(fin, table);
+    readField(fin, cat);
+    readField(fin, re.files);
+    readField(fin, re.noRefLines);
+    readField(fin, re.count.lines);
+    readField(fin, re.count.units);
+    readField(fin, re.count.hands);
+    readField(fin, re.count.boards);
+
+    if (table >= REFSTATS_SIZE || cat >= ERR_SIZE)
+      THROW("Bad ref stats entry");
+
+    RefStats::incr(static_cast<RefTables>(table), 
+      static_cast<CommentType>(cat), re);
+  }
+}
+
+
 void RefStats::print(ostream& fstr) const
 {
   if (numFiles[REFSTATS_SOURCE] == 0)
@@ -39,6 +39,8 @@ class RefStats
 
     void resetRefEntry(RefEntry& re) const;
 
+    bool emptyRefEntry(const RefEntry& re) const;
+
     void incrRefEntry(
       RefEntry& re,
       const RefEntry& ref2) const;
@@ -86,6 +88,10 @@ class RefStats
 
     void operator += (const RefStats& rf2);
 
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
+
     void print(ostream& fstr) const;
 };
 
@@ -10,6 +10,7 @@
 #include <sstream>
 
 #include "Scoring.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -155,6 +156,21 @@ bool Scoring::isIMPs() const
 }
 
 
+void Scoring::writeBDB(BDBWriter& bw) const
+{
+  bw.putByte(scoring);
+}
+
+
+void Scoring::readBDB(BDBReader& br)
+{
+  const unsigned u = br.getByte();
+  if (u > BRIDGE_SCORING_UNDEFINED)
+    THROW("Bad scoring: " + STR(u));
+  scoring = static_cast<ScoringStruct>(u);
+}
+
+
 bool Scoring::operator == (const Scoring& scoring2) const
 {
   if (scoring != scoring2.scoring)
@@ -17,6 +17,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Scoring
 {
   private:
@@ -64,6 +68,9 @@ class Scoring
 
     bool isIMPs() const;
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Scoring& scoring2) const;
 
     bool operator != (const Scoring& scoring2) const;
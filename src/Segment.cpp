@@ -9,12 +9,13 @@
 
 #include <iostream>
 #include <sstream>
-#include <iomanip>
 #include <string>
 #include <regex>
 
 #include "Segment.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -35,6 +36,7 @@ void Segment::reset()
 {
   len = 0;
   boards.clear();
+  extToInt.clear();
 
   bmin = BIGNUM;
   bmax = 0;
@@ -53,28 +55,28 @@ void Segment::reset()
 
 Board const * Segment::getBoard(const unsigned extNo) const
 {
-  for (auto &p: boards)
-    if (p.extNo == extNo)
-      return &p.board;
-
-  return nullptr;
+  auto it = extToInt.find(extNo);
+  if (it == extToInt.end())
+    return nullptr;
+  else
+    return &boards[it->second].board;
 }
 
 
 Board * Segment::acquireBoard(const unsigned extNo)
 {
-  for (auto &p: boards)
-    if (p.extNo == extNo)
-      return &p.board;
+  auto it = extToInt.find(extNo);
+  if (it != extToInt.end())
+    return &boards[it->second].board;
 
-  // Make a new board
-  BoardPair * bpPrev = (len > 0 ? &boards.back() : nullptr);
+  // Make a new board.
   boards.emplace_back(BoardPair());
   BoardPair& bp = boards.back();
   Board& board = bp.board;
 
   bp.intNo = len;
   bp.extNo = extNo;
+  extToInt[extNo] = len;
   len++;
 
   if (extNo < bmin)
@@ -93,36 +95,71 @@ Board * Segment::acquireBoard(const unsigned extNo)
   else if (len > 1)
   {
     // Copy players in order to have something.
-    const unsigned instCount = bpPrev->board.countAll();
+    const Board& boardPrev = boards[len-2].board;
+    const unsigned instCount = boardPrev.countAll();
     if (instCount == 0)
       THROW("Empty predecessor board");
 
     // Make enough room.
     board.acquireInstance(instCount-1);
-    board.copyPlayers(bpPrev->board);
+    board.copyPlayers(boardPrev);
   }
 
   return &bp.board;
 }
 
 
+void Segment::moveBoards(
+  Segment& segment2,
+  const unsigned intNo)
+{
+  for (unsigned i = intNo; i < segment2.len; i++)
+  {
+    boards.push_back(move(segment2.boards[i]));
+    BoardPair& bp = boards.back();
+
+    bp.intNo = len;
+    extToInt[bp.extNo] = len;
+    len++;
+
+    if (bp.extNo < bmin)
+      bmin = bp.extNo;
+    if (bp.extNo > bmax)
+      bmax = bp.extNo;
+  }
+
+  if (intNo < segment2.len)
+  {
+    segment2.boards.resize(intNo);
+    for (auto it = segment2.extToInt.begin();
+        it != segment2.extToInt.end(); )
+    {
+      if (it->second >= intNo)
+        it = segment2.extToInt.erase(it);
+      else
+        it++;
+    }
+    segment2.len = intNo;
+  }
+}
+
+
 unsigned Segment::getIntBoardNo(const unsigned extNo) const
 {
-  for (auto &p: boards)
-    if (p.extNo == extNo)
-      return p.intNo;
+  auto it = extToInt.find(extNo);
+  if (it == extToInt.end())
+    THROW("Bad external board number: " + STR(extNo));
 
-  THROW("Bad external board number: " + STR(extNo));
+  return it->second;
 }
 
 
 unsigned Segment::getExtBoardNo(const unsigned intNo) const
 {
-  for (auto &p: boards)
-    if (p.intNo == intNo)
-      return p.extNo;
+  if (intNo >= len)
+    THROW("Bad internal board number: " + STR(intNo));
 
-  THROW("Bad internal board number: " + STR(intNo));
+  return boards[intNo].extNo;
 }
 
 
@@ -475,6 +512,65 @@ void Segment::equalHeader(const Segment& segment2) const
 }
 
 
+void Segment::writeBDB(BDBWriter& bw) const
+{
+  bw.putString(title);
+  date.writeBDB(bw);
+  location.writeBDB(bw);
+  bw.putString(event);
+  session.writeBDB(bw);
+  scoring.writeBDB(bw);
+  teams.writeBDB(bw);
+  headerLIN.writeBDB(bw);
+
+  bw.putBool(flagCOCO);
+  bw.putUnsigned(bmin);
+  bw.putUnsigned(bmax);
+
+  // Internal numbers are the list positions.
+  bw.putUnsigned(len);
+  for (auto &bp: boards)
+  {
+    bw.putUnsigned(bp.extNo);
+    bp.board.writeBDB(bw);
+  }
+}
+
+
+void Segment::readBDB(BDBReader& br)
+{
+  Segment::reset();
+
+  title = br.getString();
+  date.readBDB(br);
+  location.readBDB(br);
+  event = br.getString();
+  session.readBDB(br);
+  scoring.readBDB(br);
+  teams.readBDB(br);
+  headerLIN.readBDB(br);
+
+  flagCOCO = br.getBool();
+  bmin = br.getUnsigned();
+  bmax = br.getUnsigned();
+
+  const unsigned n = br.getUnsigned();
+  for (len = 0; len < n; )
+  {
+    boards.emplace_back(BoardPair());
+    BoardPair& bp = boards.back();
+    bp.intNo = len;
+    bp.extNo = br.getUnsigned();
+    extToInt[bp.extNo] = len;
+    len++;
+
+    LINData const * lin = (headerLIN.isSet() ?
+      headerLIN.getEntry(Segment::getLINActiveNo(bp.intNo)) : nullptr);
+    bp.board.readBDB(br, lin);
+  }
+}
+
+
 bool Segment::operator == (const Segment& segment2) const
 {
   Segment::equalHeader(segment2);
@@ -524,19 +620,16 @@ bool Segment::operator <= (const Segment& segment2) const
 
 string Segment::strTitleLINCore() const
 {
-  stringstream ss;
-  if (bmin == 0)
-    ss << ",";
-  else
-    ss << bmin << ",";
+  string st;
+  if (bmin != 0)
+    appendUnsigned(st, bmin);
+  st += ",";
 
-  if (bmax == 0)
-    ss << ",";
-  else
-    ss << bmax << ",";
+  if (bmax != 0)
+    appendUnsigned(st, bmax);
+  st += ",";
 
-  ss << teams.str(BRIDGE_FORMAT_LIN) << "|";
-  return ss.str();
+  return st + teams.str(BRIDGE_FORMAT_LIN) + "|";
 }
 
 
@@ -710,45 +803,51 @@ string Segment::strNumber(
 {
   unsigned intNo;
 
-  stringstream ss;
+  string st;
   switch(format)
   {
     case BRIDGE_FORMAT_LIN:
     case BRIDGE_FORMAT_LIN_TRN:
+      st = "ah|Board ";
       if (format == BRIDGE_FORMAT_LIN_TRN || ! headerLIN.isSet())
-        ss << "ah|Board " << extNo << "|";
+        appendUnsigned(st, extNo);
       else
       {
         intNo = Segment::getIntBoardNo(extNo);
-        ss << "ah|Board " << headerLIN.strBoard(intNo) << "|";
+        st += headerLIN.strBoard(intNo);
       }
-      return ss.str();
+      return st + "|";
 
     case BRIDGE_FORMAT_PBN:
-      ss << "[Board \"" << extNo << "\"]\n";
-      return ss.str();
+      st = "[Board \"";
+      appendUnsigned(st, extNo);
+      return st + "\"]\n";
 
     case BRIDGE_FORMAT_RBN:
-      ss << "B " << extNo << "\n";
-      return ss.str();
+      st = "B ";
+      appendUnsigned(st, extNo);
+      return st + "\n";
 
     case BRIDGE_FORMAT_RBX:
-      ss << "B{" << extNo << "}";
-      return ss.str();
+      st = "B{";
+      appendUnsigned(st, extNo);
+      return st + "}";
 
     case BRIDGE_FORMAT_EML:
       if (! scoring.isIMPs())
         return "";
-      ss << "Teams Board " << extNo;
-      return ss.str();
+      st = "Teams Board ";
+      appendUnsigned(st, extNo);
+      return st;
 
     case BRIDGE_FORMAT_TXT:
-      ss << extNo << ".";
-      return ss.str();
+      appendUnsigned(st, extNo);
+      return st + ".";
 
     case BRIDGE_FORMAT_REC:
-      ss << "Board " << extNo;
-      return ss.str();
+      st = "Board ";
+      appendUnsigned(st, extNo);
+      return st;
 
     default:
       THROW("Invalid format: " + STR(format));
@@ -903,25 +1002,26 @@ string Segment::strScores(const Format format) const
 
 string Segment::strBoards(const Format format) const
 {
-  stringstream ss;
   string st;
 
   switch(format)
   {
     case BRIDGE_FORMAT_LIN:
-      ss << "bn|";
+      st = "bn|";
       if (! headerLIN.isSet())
       {
         for (auto &p: boards)
-          ss << p.extNo << ",";
+        {
+          appendUnsigned(st, p.extNo);
+          st += ",";
+        }
       }
       else
       {
         for (auto &p: boards)
-          ss << headerLIN.strBoard(p.extNo - bmin) << ",";
+          st += headerLIN.strBoard(p.extNo - bmin) + ",";
       }
 
-      st = ss.str();
       st.pop_back(); // Remove trailing comma
       return st + "|\npg||\n";
 
@@ -938,22 +1038,22 @@ string Segment::strBoards(const Format format) const
 
 string Segment::strIMPSheetHeader() const
 {
-  stringstream ss;
+  string st;
   const string divider = "  |  ";
   const string dashes(72, '-');
-  ss << setw(4) << right << "Bd." << "  " <<
-    setw(8) << left << "Contr." <<
-    setw(7) << right << "NS" <<
-    setw(7) << "EW" <<
-    divider <<
-    setw(8) << left << "Contr." <<
-    setw(7) << right << "NS" <<
-    setw(7) << "EW" <<
-    divider <<
-    setw(6) << "Home" <<
-    setw(6) << "Visit" << "\n";
-  ss << dashes << "\n";
-  return ss.str();
+  appendRight(st, "Bd.", 4);
+  st += "  ";
+  appendLeft(st, "Contr.", 8);
+  appendRight(st, "NS", 7);
+  appendRight(st, "EW", 7);
+  st += divider;
+  appendLeft(st, "Contr.", 8);
+  appendRight(st, "NS", 7);
+  appendRight(st, "EW", 7);
+  st += divider;
+  appendRight(st, "Home", 6);
+  appendRight(st, "Visit", 6);
+  return st + "\n" + dashes + "\n";
 }
 
 
@@ -961,10 +1061,10 @@ string Segment::strIMPSheetFooter(
   const unsigned score1,
   const unsigned score2) const
 {
-  stringstream ss;
   const string dashes(72, '-');
-  ss << dashes << "\n";
-  ss << setw(66) << right << score1 << setw(6) << score2 << "\n\n";
-  return ss.str();  
+  string st = dashes + "\n";
+  appendUnsigned(st, score1, 66);
+  appendUnsigned(st, score2, 6);
+  return st + "\n\n";
 }
 
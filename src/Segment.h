@@ -11,7 +11,8 @@
 #define BRIDGE_SEGMENT_H
 
 #include <string>
-#include <list>
+#include <vector>
+#include <unordered_map>
 #include <iostream>
 
 #include "Date.h"
@@ -20,12 +21,17 @@
 #include "Scoring.h"
 #include "Teams.h"
 #include "HeaderLIN.h"
+#include "Arena.h"
 #include "Board.h"
 #include "bconst.h"
 
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 struct BoardPair
 {
   unsigned intNo; // Internal Segment number
@@ -49,8 +55,12 @@ class Segment
 
     bool flagCOCO; // Team order is swapped in the input
 
+    // Boards are stored in internal order, so intNo is the position.
+    // A deque never moves a board once it is added.
     unsigned len;
-    list<BoardPair> boards;
+    ArenaDeque<BoardPair> boards;
+    unordered_map<unsigned, unsigned, hash<unsigned>, equal_to<unsigned>,
+      ArenaAlloc<pair<const unsigned, unsigned>>> extToInt;
     unsigned bmin;
     unsigned bmax;
 
@@ -81,11 +91,13 @@ class Segment
 
     ~Segment();
 
-    list<BoardPair>::const_iterator begin() const { return boards.begin(); }
-    list<BoardPair>::const_iterator end() const { return boards.end(); }
+    ArenaDeque<BoardPair>::const_iterator begin() const
+      { return boards.begin(); }
+    ArenaDeque<BoardPair>::const_iterator end() const
+      { return boards.end(); }
 
-    list<BoardPair>::iterator mbegin() { return boards.begin(); }
-    list<BoardPair>::iterator mend() { return boards.end(); }
+    ArenaDeque<BoardPair>::iterator mbegin() { return boards.begin(); }
+    ArenaDeque<BoardPair>::iterator mend() { return boards.end(); }
 
     void reset();
 
@@ -93,6 +105,11 @@ class Segment
 
     Board * acquireBoard(const unsigned extNo);
 
+    // Moves the boards of segment2 from intNo onwards to the end.
+    void moveBoards(
+      Segment& segment2,
+      const unsigned intNo);
+
     void setBoard(const unsigned extNo);
 
     void setCOCO(const Format format = BRIDGE_FORMAT_SIZE);
@@ -177,6 +194,9 @@ class Segment
       unsigned& score1,
       unsigned& score2) const;
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Segment& s2) const;
     bool operator != (const Segment& s2) const;
     bool operator <= (const Segment& s2) const;
@@ -11,8 +11,10 @@
 #include <regex>
 
 #include "Session.h"
+#include "append.h"
 #include "parse.h"
 #include "Bdiff.h"
+#include "BDB.h"
 #include "Bexcept.h"
 
 
@@ -366,6 +368,30 @@ bool Session::isRoundOfLike(const string& text) const
 }
 
 
+void Session::writeBDB(BDBWriter& bw) const
+{
+  bw.putString(general1);
+  bw.putByte(stage);
+  bw.putUnsigned(roundOf);
+  bw.putString(extension);
+  bw.putString(general2);
+  bw.putUnsigned(sessionNo);
+  bw.putString(sessExt);
+}
+
+
+void Session::readBDB(BDBReader& br)
+{
+  general1 = br.getString();
+  stage = static_cast<Stage>(br.getByte());
+  roundOf = br.getUnsigned();
+  extension = br.getString();
+  general2 = br.getString();
+  sessionNo = br.getUnsigned();
+  sessExt = br.getString();
+}
+
+
 bool Session::operator == (const Session& session2) const
 {
   if (stage != session2.stage)
@@ -407,18 +433,19 @@ string Session::strLIN() const
   if (stage == BRIDGE_SESSION_UNDEFINED)
     return "";
 
-  stringstream ss;
-  if (stage != BRIDGE_SESSION_ROUND_OF)
-    ss << STAGE_NAMES_SHORT[stage];
-  else
-    ss << STAGE_NAMES_SHORT[stage] << roundOf;
+  string st = STAGE_NAMES_SHORT[stage];
+  if (stage == BRIDGE_SESSION_ROUND_OF)
+    appendUnsigned(st, roundOf);
 
   if (sessionNo > 0)
-    ss << ":" << sessionNo;
+  {
+    st += ":";
+    appendUnsigned(st, sessionNo);
+  }
   else if (general2 != "")
-    ss << ":" << general2;
+    st += ":" + general2;
 
-  return ss.str();
+  return st;
 }
 
 
@@ -428,35 +455,37 @@ string Session::strLIN_RP() const
   if (stage == BRIDGE_SESSION_UNDEFINED)
     return ",";
 
-  stringstream ss;
+  string st;
 
   // This is an odd Pavlicek choice.
   if (stage != BRIDGE_SESSION_ROUND_OF && extension != "")
   {
-    ss << "," << STAGE_NAMES_SHORT[stage] << extension;
+    st = "," + STAGE_NAMES_SHORT[stage] + extension;
   }
   else if (stage == BRIDGE_SESSION_ROUND_OF)
   {
+    st = ",R";
+    appendUnsigned(st, roundOf);
     if (extension != "" && roundOf >= 64)
-      ss << ",R" << roundOf << " " << extension;
-    else
-      ss << ",R" << roundOf << extension;
+      st += " ";
+    st += extension;
   }
   else
   {
     // For some reason Pavlicek doesn't do this for Rxy.
-    ss << " " << STAGE_NAMES[stage] << extension << ",";
+    st = " " + STAGE_NAMES[stage] + extension + ",";
     if (sessionNo > 0)
     {
-      ss << SESSION_NAMES[stage] << " " << sessionNo;
+      st += SESSION_NAMES[stage] + " ";
+      appendUnsigned(st, sessionNo);
       if (sessExt != "")
-        ss << " " << sessExt;
+        st += " " + sessExt;
     }
     else
-      ss << general2;
+      st += general2;
   }
 
-  return ss.str();
+  return st;
 }
 
 
@@ -466,18 +495,19 @@ string Session::strLIN_VG() const
   if (stage == BRIDGE_SESSION_UNDEFINED)
     return general1;
 
-  stringstream ss;
-  if (stage != BRIDGE_SESSION_ROUND_OF)
-    ss << STAGE_NAMES_SHORT[stage];
-  else
-    ss << STAGE_NAMES_SHORT[stage] << roundOf;
+  string st = STAGE_NAMES_SHORT[stage];
+  if (stage == BRIDGE_SESSION_ROUND_OF)
+    appendUnsigned(st, roundOf);
 
   if (sessionNo > 0)
-    ss << ":" << sessionNo;
+  {
+    st += ":";
+    appendUnsigned(st, sessionNo);
+  }
   else if (general2 != "")
-    ss << ":" << general2;
+    st += ":" + general2;
 
-  return ss.str();
+  return st;
 }
 
 
@@ -492,27 +522,31 @@ string Session::strPBN() const
 
 string Session::strRBNCore() const
 {
-  stringstream ss;
+  string st;
   if (stage == BRIDGE_SESSION_UNDEFINED)
-    ss << general1;
+    st = general1;
   else if (stage != BRIDGE_SESSION_ROUND_OF)
-    ss << STAGE_NAMES_SHORT[stage] << extension;
-  else if (extension != "" && roundOf >= 64)
-    // Pavlicek...
-    ss << STAGE_NAMES_SHORT[stage] << roundOf << " " << extension;
+    st = STAGE_NAMES_SHORT[stage] + extension;
   else
-    ss << STAGE_NAMES_SHORT[stage] << roundOf << extension;
+  {
+    st = STAGE_NAMES_SHORT[stage];
+    appendUnsigned(st, roundOf);
+    if (extension != "" && roundOf >= 64)
+      st += " "; // Pavlicek...
+    st += extension;
+  }
 
   if (sessionNo > 0)
   {
-    ss << ":" << sessionNo;
+    st += ":";
+    appendUnsigned(st, sessionNo);
     if (sessExt != "")
-      ss << " " << sessExt;
+      st += " " + sessExt;
   }
   else if (general2 != "")
-    ss << ":" << general2;
+    st += ":" + general2;
 
-  return ss.str();
+  return st;
 }
 
 
@@ -530,33 +564,43 @@ string Session::strRBX() const
 
 string Session::strTXT() const
 {
-  stringstream ss;
+  string st;
   if (stage == BRIDGE_SESSION_UNDEFINED)
-    ss << general1;
+    st = general1;
   else if (stage != BRIDGE_SESSION_ROUND_OF)
   {
-    ss << STAGE_NAMES[stage];
+    st = STAGE_NAMES[stage];
     if (extension != "")
-      ss << " " << extension;
+      st += " " + extension;
   }
-  else if (extension != "" && roundOf >= 64)
-    // Pavlicek...
-    ss << STAGE_NAMES[stage] << roundOf << " " << extension;
   else
-    ss << STAGE_NAMES[stage] << roundOf << extension;
+  {
+    st = STAGE_NAMES[stage];
+    appendUnsigned(st, roundOf);
+    if (extension != "" && roundOf >= 64)
+      st += " "; // Pavlicek...
+    st += extension;
+  }
 
   if (sessionNo > 0)
   {
+    st += ", ";
     if (sessExt == "")
-      ss << ", " << SESSION_NAMES[stage] << " " << sessionNo;
+    {
+      st += SESSION_NAMES[stage] + " ";
+      appendUnsigned(st, sessionNo);
+    }
     else
+    {
       // Pavlicek bug?
-      ss << ", " << sessionNo << " " << sessExt;
+      appendUnsigned(st, sessionNo);
+      st += " " + sessExt;
+    }
   }
   else if (general2 != "")
-    ss << ", " << general2;
+    st += ", " + general2;
 
-  return ss.str();
+  return st;
 }
 
 
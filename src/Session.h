@@ -17,6 +17,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 // Private to Session, but needs to be here...
 
 enum Stage
@@ -89,6 +93,9 @@ class Session
 
     bool isRoundOfLike(const string& text) const;
 
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Session& session2) const;
 
     bool operator != (const Session& session2) const;
@@ -8,14 +8,15 @@
 
 
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 #include <vector>
 #include <algorithm>
 
 #include "Tableau.h"
+#include "append.h"
 #include "Contract.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -279,6 +280,24 @@ unsigned Tableau::get(
 }
 
 
+void Tableau::writeBDB(BDBWriter& bw) const
+{
+  bw.putByte(setNum);
+  for (unsigned d = 0; d < BRIDGE_DENOMS; d++)
+    for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+      bw.putByte(table[d][p]);
+}
+
+
+void Tableau::readBDB(BDBReader& br)
+{
+  setNum = br.getByte();
+  for (unsigned d = 0; d < BRIDGE_DENOMS; d++)
+    for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+      table[d][p] = br.getByte();
+}
+
+
 bool Tableau::operator == (const Tableau& tableau2) const
 {
   if (setNum != tableau2.setNum) 
@@ -315,36 +334,35 @@ bool Tableau::operator != (const Tableau& tableau2) const
 
 string Tableau::strPBN() const
 {
-  stringstream ss;
-  ss << "[OptimumResultTable \"Declarer Denomination Result\"]\n";
+  string st = "[OptimumResultTable \"Declarer Denomination Result\"]\n";
   for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
   {
     for (unsigned d = 0; d < BRIDGE_DENOMS; d++)
     {
-      ss << PLAYER_NAMES_SHORT[p] << " " <<
-        DENOM_NAMES_SHORT_RBN[d] << " " <<
-      Tableau::get(static_cast<Player>(p), DENOM_RBN_TO_DDS[d]) << "\n";
+      st += PLAYER_NAMES_SHORT[p] + " " + DENOM_NAMES_SHORT_RBN[d] + " ";
+      appendUnsigned(st,
+        Tableau::get(static_cast<Player>(p), DENOM_RBN_TO_DDS[d]));
+      st += "\n";
     }
   }
-  return ss.str();
+  return st;
 }
 
 
 string Tableau::strTXT() const
 {
-  stringstream ss;
-  ss << "opt  S  N    E  W\n";
+  string st = "opt  S  N    E  W\n";
   for (unsigned d = 0; d < BRIDGE_DENOMS; d++)
   {
     Denom drbn = DENOM_RBN_TO_DDS[d];
-    ss << setw(3) << DENOM_NAMES_SHORT_RBN[d] <<
-      setw(3) << Tableau::get(BRIDGE_SOUTH, drbn) <<
-      setw(3) << Tableau::get(BRIDGE_NORTH, drbn) <<
-      setw(5) << Tableau::get(BRIDGE_EAST, drbn) <<
-      setw(3) << Tableau::get(BRIDGE_WEST, drbn) << "\n";
-  }
-  ss << "\n";
-  return ss.str();
+    appendRight(st, DENOM_NAMES_SHORT_RBN[d], 3);
+    appendUnsigned(st, Tableau::get(BRIDGE_SOUTH, drbn), 3);
+    appendUnsigned(st, Tableau::get(BRIDGE_NORTH, drbn), 3);
+    appendUnsigned(st, Tableau::get(BRIDGE_EAST, drbn), 5);
+    appendUnsigned(st, Tableau::get(BRIDGE_WEST, drbn), 3);
+    st += "\n";
+  }
+  return st + "\n";
 }
 
 
@@ -357,31 +375,32 @@ string Tableau::strRBN() const
   unsigned ninv = 0xddddd - n;
   unsigned sinv = 0xddddd - s;
 
-  stringstream text;
-  text << hex << uppercase;
-  text << "::" << n;
+  string text = "::";
+  appendHex(text, n);
   if (n == s)
-    text << "=";
+    text += "=";
   else
-    text << "+" << s;
-  text << ":";
+  {
+    text += "+";
+    appendHex(text, s);
+  }
+  text += ":";
 
   if (ninv == w)
-    text << "!";
+    text += "!";
   else
-    text << w;
+    appendHex(text, w);
 
   if (ninv != w && sinv != e && w != e)
-    text << "+";
+    text += "+";
   if (sinv == e)
-    text << "!";
+    text += "!";
   else if (w == e)
-    text << "=";
+    text += "=";
   else
-    text << e;
-  text << "\n" << dec << nouppercase;
+    appendHex(text, e);
 
-  return text.str();
+  return text + "\n";
 }
 
 
@@ -402,8 +421,6 @@ string Tableau::str(const Format format) const
   if (! Tableau::isComplete())
     return "";
 
-  stringstream ss("");
-
   switch(format)
   {
     case BRIDGE_FORMAT_LIN:
@@ -516,21 +533,18 @@ bool Tableau::getPar(
   if (! Tableau::getPar(dealer, vul, clist))
     return false;
 
-  stringstream s;
-  s.clear();
+  text = "";
   bool first = true;
   for (auto &contract: clist)
   {
     if (first)
       first = false;
     else
-      s << " ";
+      text += " ";
 
-    s << contract.str(BRIDGE_FORMAT_PAR);
+    text += contract.str(BRIDGE_FORMAT_PAR);
   }
-  s << "\n";
-
-  text = s.str();
+  text += "\n";
   return true;
 }
 
@@ -18,6 +18,8 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
 class Contract;
 
 
@@ -143,6 +145,9 @@ class Tableau
       const Player player,
       const Denom denom) const;
     
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Tableau& tableau2) const;
 
     bool operator != (const Tableau& tableau2) const;
@@ -9,10 +9,11 @@
 
 #include <regex>
 #include <sstream>
-#include <iomanip>
 
 #include "Team.h"
+#include "append.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -120,6 +121,29 @@ void Team::setPair(
 }
 
 
+void Team::writeBDB(BDBWriter& bw) const
+{
+  bw.putString(name);
+  bw.putByte(carry);
+  if (carry == BRIDGE_CARRY_INT)
+    bw.putInt(carryi);
+  else if (carry == BRIDGE_CARRY_FLOAT)
+    bw.putFloat(carryf);
+}
+
+
+void Team::readBDB(BDBReader& br)
+{
+  Team::reset();
+  name = br.getString();
+  carry = static_cast<Carry>(br.getByte());
+  if (carry == BRIDGE_CARRY_INT)
+    carryi = br.getInt();
+  else if (carry == BRIDGE_CARRY_FLOAT)
+    carryf = br.getFloat();
+}
+
+
 bool Team::operator == (const Team& team2) const
 {
   if (name != team2.name)
@@ -170,7 +194,7 @@ unsigned Team::getCarry() const
 
 string Team::strCarry(const bool forceFlag) const
 {
-  stringstream ss;
+  string st;
 
   switch(carry)
   {
@@ -178,12 +202,12 @@ string Team::strCarry(const bool forceFlag) const
       return (forceFlag ? "0" : "");
 
     case BRIDGE_CARRY_INT:
-      ss << carryi;
-      return ss.str();
+      appendInt(st, carryi);
+      return st;
 
     case BRIDGE_CARRY_FLOAT:
-      ss << fixed << setprecision(2) << carryf;
-      return ss.str();
+      appendFixed(st, static_cast<double>(carryf), 2);
+      return st;
 
     default:
       THROW("Unknown carry");
@@ -207,21 +231,19 @@ string Team::strPBN(const string& label) const
   if (name == "" && carry == BRIDGE_CARRY_NONE)
     return "";
 
-  stringstream ss;
-  ss << "[" + label + " \"" + name;
+  string st = "[" + label + " \"" + name;
   if (carry != BRIDGE_CARRY_NONE)
-    ss << ":" << Team::strCarry();
-  return ss.str() + "\"]\n";
+    st += ":" + Team::strCarry();
+  return st + "\"]\n";
 }
 
 
 string Team::strTXT() const
 {
-  stringstream ss;
-  ss << name;
-  if (carry != BRIDGE_CARRY_NONE)
-    ss << " (" << Team::strCarry() << ")";
-  return ss.str();
+  if (carry == BRIDGE_CARRY_NONE)
+    return name;
+  else
+    return name + " (" + Team::strCarry() + ")";
 }
 
 
@@ -230,28 +252,27 @@ string Team::strTXT(const int score) const
   if (name == "")
     return "\n";
 
-  stringstream ss;
-  ss << name << " ";
+  string st = name + " ";
 
   switch(carry)
   {
     case BRIDGE_CARRY_NONE:
-      ss << score;
+      appendInt(st, score);
       break;
 
     case BRIDGE_CARRY_INT:
-      ss << score + carryi;
+      appendInt(st, score + carryi);
       break;
 
     case BRIDGE_CARRY_FLOAT:
-      ss << fixed << setprecision(2) << score + carryf;
+      appendFixed(st, static_cast<double>(score + carryf), 2);
       break;
 
     default:
       THROW("Unknown carry");
   }
 
-  return ss.str();
+  return st;
 }
 
 
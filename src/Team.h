@@ -17,6 +17,9 @@
 
 using namespace std;
 
+
+class BDBWriter;
+class BDBReader;
 class Teams;
 
 
@@ -74,6 +77,9 @@ class Team
 
     unsigned getCarry() const;
       
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Team& t2) const;
 
     bool operator != (const Team& t2) const;
@@ -9,10 +9,10 @@
 
 #include <regex>
 #include <sstream>
-#include <iomanip>
 
 #include "Teams.h"
 #include "parse.h"
+#include "BDB.h"
 #include "Bexcept.h"
 #include "Bdiff.h"
 
@@ -212,6 +212,20 @@ void Teams::getCarry(
 }
 
 
+void Teams::writeBDB(BDBWriter& bw) const
+{
+  team1.writeBDB(bw);
+  team2.writeBDB(bw);
+}
+
+
+void Teams::readBDB(BDBReader& br)
+{
+  team1.readBDB(br);
+  team2.readBDB(br);
+}
+
+
 bool Teams::operator == (const Teams& teams2) const
 {
   if (team1 != teams2.team1)
@@ -249,25 +263,15 @@ string Teams::strRBNCore(const bool swapFlag) const
       team2.carry == BRIDGE_CARRY_NONE)
     return "";
 
-  stringstream ss;
-  if (swapFlag)
-  {
-    ss << team2.name << ":" << team1.name;
+  const Team& first = (swapFlag ? team2 : team1);
+  const Team& second = (swapFlag ? team1 : team2);
 
-    if (team1.carry != BRIDGE_CARRY_NONE ||
-        team2.carry != BRIDGE_CARRY_NONE)
-      ss << ":" << team2.strCarry() << ":" << team1.strCarry();
-  }
-  else
-  {
-    ss << team1.name << ":" << team2.name;
-
-    if (team1.carry != BRIDGE_CARRY_NONE ||
-        team2.carry != BRIDGE_CARRY_NONE)
-      ss << ":" << team1.strCarry() << ":" << team2.strCarry();
-  }
+  string st = first.name + ":" + second.name;
+  if (team1.carry != BRIDGE_CARRY_NONE ||
+      team2.carry != BRIDGE_CARRY_NONE)
+    st += ":" + first.strCarry() + ":" + second.strCarry();
 
-  return ss.str();
+  return st;
 }
 
 string Teams::strRBN(const bool swapFlag) const
@@ -313,7 +317,6 @@ string Teams::strTXT(
   if (team1.name == "" && team2.name == "")
     return "\n";
 
-  stringstream s1, s2;
   bool order12Flag = true;
 
   switch(team1.carry)
@@ -18,6 +18,10 @@
 using namespace std;
 
 
+class BDBWriter;
+class BDBReader;
+
+
 class Teams
 {
   private:
@@ -71,6 +75,9 @@ class Teams
       unsigned& score1,
       unsigned& score2) const;
       
+    void writeBDB(BDBWriter& bw) const;
+    void readBDB(BDBReader& br);
+
     bool operator == (const Teams& t2) const;
 
     bool operator != (const Teams& t2) const;
@@ -19,6 +19,7 @@
 
 #include "TextStats.h"
 #include "parse.h"
+#include "Bexcept.h"
 
 #define BRIDGE_STATS_MAX_LENGTH 64
 #define BRIDGE_STATS_NUM_FIELDS 7
@@ -157,6 +158,71 @@ void TextStats::operator += (const TextStats& statsIn)
 }
 
 
+void TextStats::serialize(ostream& fout) const
+{
+  unsigned n = 0;
+  for (unsigned f = 0; f < BRIDGE_FORMAT_SIZE; f++)
+    for (unsigned l = 0; l < BRIDGE_STATS_NUM_FIELDS; l++)
+      for (unsigned i = 0; i < BRIDGE_STATS_MAX_LENGTH; i++)
+        if (stats[f][l].datum[i].count > 0)
+          n++;
+
+  writeField(fout, n);
+  for (unsigned f = 0; f < BRIDGE_FORMAT_SIZE; f++)
+  {
+    for (unsigned l = 0; l < BRIDGE_STATS_NUM_FIELDS; l++)
+    {
+      for (unsigned i = 0; i < BRIDGE_STATS_MAX_LENGTH; i++)
+      {
+        const TextDatum &td = stats[f][l].datum[i];
+        if (td.count == 0)
+          continue;
+
+        writeField(fout, f);
+        writeField(fout, l);
+        writeField(fout, i);
+        writeField(fout, td.count);
+        writeField(fout, td.source);
+        writeField(fout, td.example);
+      }
+    }
+  }
+}
+
+
+void TextStats::deserialize(istream& fin)
+{
+  // Adds to the stats, like +=.  The field count is the sum of 
+  // its datum counts.
+  unsigned n, f, l, i;
+  TextDatum tdIn;
+  readField(fin, n);
+  for (unsigned k = 0; k < n; k++)
+  {
+    readField(fin, f);
+    readField(fin, l);
+    readField(fin, i);
+    readField(fin, tdIn.count);
+    readField(fin, tdIn.source);
+    readField(fin, tdIn.example);
+
+    if (f >= BRIDGE_FORMAT_SIZE || 
+        l >= BRIDGE_STATS_NUM_FIELDS ||
+        i >= BRIDGE_STATS_MAX_LENGTH)
+      THROW("Bad text stats entry");
+
+    TextDatum &td = stats[f][l].datum[i];
+    if (td.count == 0)
+    {
+      td.source = tdIn.source;
+      td.example = tdIn.example;
+    }
+    td.count += tdIn.count;
+    stats[f][l].count += tdIn.count;
+  }
+}
+
+
 void TextStats::printDetails(
   const unsigned label,
   ostream& fstr) const
@@ -65,6 +65,10 @@ class TextStats
       const Format format);
 
     void operator += (const TextStats& statsIn);
+
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
       
     void print(
       ostream& fstr,
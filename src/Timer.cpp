@@ -56,6 +56,12 @@ void Timer::operator += (const Timer& timer2)
 }
 
 
+double Timer::seconds() const
+{
+  return sum / 1000000.;
+}
+
+
 string Timer::str(const int prec) const 
 {
   if (no == 0)
@@ -42,6 +42,8 @@ class Timer
 
     void operator += (const Timer& timer2);
 
+    double seconds() const;
+
     string str(const int prec = 1) const;
 };
 
@@ -21,7 +21,17 @@ const string TimerName[]
   "Stats",
   "Refs",
   "Value",
-  "Sheet"
+  "Sheet",
+  "DD",
+  "Trace"
+};
+
+const string StageName[]
+{
+  "Read",
+  "Analyze",
+  "Write",
+  "Validate"
 };
 
 
@@ -41,6 +51,15 @@ void Timers::reset()
   for (unsigned fnc = 0; fnc < BRIDGE_TIMER_SIZE; fnc++)
     for (unsigned format = 0; format < BRIDGE_FORMAT_SIZE; format++)
       timer[fnc][format].reset();
+
+  for (unsigned stage = 0; stage < BRIDGE_STAGE_SIZE; stage++)
+  {
+    for (unsigned state = 0; state < BRIDGE_STAGE_STATE_SIZE; state++)
+      stageTimer[stage][state].reset();
+    stageThreads[stage] = 0;
+    queueSum[stage] = 0;
+    queueNo[stage] = 0;
+  }
 }
 
 
@@ -60,11 +79,51 @@ void Timers::stop(
 }
 
 
+void Timers::setStage(const PipeStage stage)
+{
+  stageThreads[stage]++;
+}
+
+
+void Timers::startStage(
+  const PipeStage stage,
+  const StageState state)
+{
+  stageTimer[stage][state].start();
+}
+
+
+void Timers::stopStage(
+  const PipeStage stage,
+  const StageState state)
+{
+  stageTimer[stage][state].stop();
+}
+
+
+void Timers::addOccupancy(
+  const PipeStage stage,
+  const unsigned depth)
+{
+  queueSum[stage] += depth;
+  queueNo[stage]++;
+}
+
+
 void Timers::operator += (const Timers& timer2)
 {
   for (unsigned fnc = 0; fnc < BRIDGE_TIMER_SIZE; fnc++)
     for (unsigned format = 0; format < BRIDGE_FORMAT_SIZE; format++)
       timer[fnc][format] += timer2.timer[fnc][format];
+
+  for (unsigned stage = 0; stage < BRIDGE_STAGE_SIZE; stage++)
+  {
+    for (unsigned state = 0; state < BRIDGE_STAGE_STATE_SIZE; state++)
+      stageTimer[stage][state] += timer2.stageTimer[stage][state];
+    stageThreads[stage] += timer2.stageThreads[stage];
+    queueSum[stage] += timer2.queueSum[stage];
+    queueNo[stage] += timer2.queueNo[stage];
+  }
 }
 
 
@@ -125,7 +184,10 @@ void Timers::print(const unsigned numThreads) const
       sum += timer[fnc][format].sum;
 
   if (sum == 0.)
+  {
+    Timers::printStages();
     return;
+  }
 
   vector<unsigned> active;
   Timers::findActive(active);
@@ -158,5 +220,56 @@ void Timers::print(const unsigned numThreads) const
     cout << " (" << numThreads << " threads)";
   cout << "\n";
 
+  Timers::printStages();
+}
+
+
+void Timers::printStages() const
+{
+  bool flag = false;
+  for (unsigned stage = 0; stage < BRIDGE_STAGE_SIZE; stage++)
+    if (stageThreads[stage] > 0)
+      flag = true;
+
+  if (! flag)
+    return;
+
+  // The input queue of the read stage is the file list, so it has
+  // no occupancy.
+  cout << "\n" << setw(10) << left << "Stage" << 
+    setw(8) << right << "Threads" <<
+    setw(8) << "Items" <<
+    setw(8) << "Busy%" <<
+    setw(10) << "Starved%" <<
+    setw(10) << "Blocked%" <<
+    setw(8) << "Queue" << "\n";
+
+  for (unsigned stage = 0; stage < BRIDGE_STAGE_SIZE; stage++)
+  {
+    double total = 0.;
+    for (unsigned state = 0; state < BRIDGE_STAGE_STATE_SIZE; state++)
+      total += stageTimer[stage][state].sum;
+
+    cout << setw(10) << left << StageName[stage] <<
+      setw(8) << right << stageThreads[stage] <<
+      setw(8) << stageTimer[stage][BRIDGE_STAGE_BUSY].no;
+
+    for (unsigned state = 0; state < BRIDGE_STAGE_STATE_SIZE; state++)
+    {
+      const int w = (state == BRIDGE_STAGE_BUSY ? 8 : 10);
+      if (total == 0.)
+        cout << setw(w) << "-";
+      else
+        cout << setw(w) << fixed << setprecision(1) <<
+          100. * stageTimer[stage][state].sum / total;
+    }
+
+    if (queueNo[stage] == 0)
+      cout << setw(8) << "-";
+    else
+      cout << setw(8) << fixed << setprecision(1) <<
+        static_cast<double>(queueSum[stage]) / queueNo[stage];
+    cout << "\n";
+  }
 }
 
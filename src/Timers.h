@@ -29,9 +29,18 @@ enum TimerFunction
   BRIDGE_TIMER_REF_STATS = 5,
   BRIDGE_TIMER_VALUE = 6,
   BRIDGE_TIMER_DIGEST = 7,
-  BRIDGE_TIMER_SIZE = 8
+  BRIDGE_TIMER_DD = 8,
+  BRIDGE_TIMER_TRACE = 9,
+  BRIDGE_TIMER_SIZE = 10
 };
 
+enum StageState
+{
+  BRIDGE_STAGE_BUSY = 0,
+  BRIDGE_STAGE_STARVED = 1,
+  BRIDGE_STAGE_BLOCKED = 2,
+  BRIDGE_STAGE_STATE_SIZE = 3
+};
 
 
 class Timers
@@ -40,6 +49,14 @@ class Timers
 
     Timer timer[BRIDGE_TIMER_SIZE][BRIDGE_FORMAT_SIZE];
 
+    // Only used in pipelined mode.  A stage is busy with an item,
+    // starved while waiting for input, or blocked while waiting for
+    // room in the next queue.
+    Timer stageTimer[BRIDGE_STAGE_SIZE][BRIDGE_STAGE_STATE_SIZE];
+    unsigned stageThreads[BRIDGE_STAGE_SIZE];
+    unsigned long long queueSum[BRIDGE_STAGE_SIZE];
+    unsigned queueNo[BRIDGE_STAGE_SIZE];
+
 
     void findActive(vector<unsigned>& active) const;
 
@@ -49,6 +66,8 @@ class Timers
       const vector<unsigned> active,
       const int prec = 1) const;
 
+    void printStages() const;
+
 
   public:
 
@@ -66,6 +85,20 @@ class Timers
       const TimerFunction fnc,
       const Format format);
 
+    void setStage(const PipeStage stage);
+
+    void startStage(
+      const PipeStage stage,
+      const StageState state);
+
+    void stopStage(
+      const PipeStage stage,
+      const StageState state);
+
+    void addOccupancy(
+      const PipeStage stage,
+      const unsigned depth);
+
     void operator += (const Timers& timers2);
 
     void print(const unsigned numThreads = 1) const;
@@ -10,6 +10,8 @@
 #include <assert.h>
 
 #include "ValProfile.h"
+#include "parse.h"
+#include "Bexcept.h"
 
 
 ValProfile::ValProfile():
@@ -100,6 +102,53 @@ void ValProfile::operator += (const ValProfile& prof2)
 }
 
 
+void ValProfile::serialize(ostream& fout) const
+{
+  unsigned n = 0;
+  for (unsigned v = 0; v < BRIDGE_VAL_SIZE; v++)
+    if (count[v] > 0)
+      n++;
+
+  writeField(fout, n);
+  for (unsigned v = 0; v < BRIDGE_VAL_SIZE; v++)
+  {
+    if (count[v] == 0)
+      continue;
+
+    writeField(fout, v);
+    writeField(fout, count[v]);
+    writeField(fout, example[v].out.lno);
+    writeField(fout, example[v].out.line);
+    writeField(fout, example[v].ref.lno);
+    writeField(fout, example[v].ref.line);
+  }
+}
+
+
+void ValProfile::deserialize(istream& fin)
+{
+  // Adds to the profile, like +=.
+  unsigned n, v, c;
+  ValExample ex;
+  readField(fin, n);
+  for (unsigned i = 0; i < n; i++)
+  {
+    readField(fin, v);
+    readField(fin, c);
+    readField(fin, ex.out.lno);
+    readField(fin, ex.out.line);
+    readField(fin, ex.ref.lno);
+    readField(fin, ex.ref.line);
+
+    if (v >= BRIDGE_VAL_SIZE)
+      THROW("Bad validation label");
+    if (count[v] == 0)
+      example[v] = ex;
+    count[v] += c;
+  }
+}
+
+
 void ValProfile::addRange(
   const ValProfile& prof,
   const unsigned lower,
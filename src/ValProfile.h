@@ -178,6 +178,10 @@ class ValProfile
 
     void operator += (const ValProfile& prof2);
 
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
+
     void addRange(
       const ValProfile& prof,
       const unsigned lower,
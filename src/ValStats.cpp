@@ -11,6 +11,8 @@
 #include <assert.h>
 
 #include "ValStats.h"
+#include "parse.h"
+#include "Bexcept.h"
 
 
 ValStats::ValStats()
@@ -31,6 +33,7 @@ void ValStats::reset()
     for (unsigned vRef = 0; vRef < BRIDGE_FORMAT_LABELS_SIZE; vRef++)
     {
       ValStat& stat = stats[vOrig][vRef];
+      stat.profile.reset();
       for (unsigned s = 0; s < BRIDGE_VAL_SUMM_SIZE; s++)
         stat.count[s] = 0;
     }
@@ -89,6 +92,57 @@ void ValStats::operator += (const ValStats& statsIn)
 }
 
 
+void ValStats::serialize(ostream& fout) const
+{
+  unsigned n = 0;
+  for (unsigned vOrig = 0; vOrig < BRIDGE_FORMAT_LABELS_SIZE; vOrig++)
+    for (unsigned vRef = 0; vRef < BRIDGE_FORMAT_LABELS_SIZE; vRef++)
+      if (stats[vOrig][vRef].count[BRIDGE_VAL_ALL] > 0)
+        n++;
+
+  writeField(fout, n);
+  for (unsigned vOrig = 0; vOrig < BRIDGE_FORMAT_LABELS_SIZE; vOrig++)
+  {
+    for (unsigned vRef = 0; vRef < BRIDGE_FORMAT_LABELS_SIZE; vRef++)
+    {
+      const ValStat& stat = stats[vOrig][vRef];
+      if (stat.count[BRIDGE_VAL_ALL] == 0)
+        continue;
+
+      writeField(fout, vOrig);
+      writeField(fout, vRef);
+      for (unsigned s = 0; s < BRIDGE_VAL_SUMM_SIZE; s++)
+        writeField(fout, stat.count[s]);
+      stat.profile.serialize(fout);
+    }
+  }
+}
+
+
+void ValStats::deserialize(istream& fin)
+{
+  // Adds to the stats, like +=.
+  unsigned n, vOrig, vRef, c;
+  readField(fin, n);
+  for (unsigned i = 0; i < n; i++)
+  {
+    readField(fin, vOrig);
+    readField(fin, vRef);
+    if (vOrig >= BRIDGE_FORMAT_LABELS_SIZE || 
+        vRef >= BRIDGE_FORMAT_LABELS_SIZE)
+      THROW("Bad validation formats");
+
+    ValStat& stat = stats[vOrig][vRef];
+    for (unsigned s = 0; s < BRIDGE_VAL_SUMM_SIZE; s++)
+    {
+      readField(fin, c);
+      stat.count[s] += c;
+    }
+    stat.profile.deserialize(fin);
+  }
+}
+
+
 string ValStats::posOrDash(const unsigned u) const
 {
   if (u == 0)
@@ -84,6 +84,10 @@ class ValStats
       const ValProfile& prof);
 
     void operator += (const ValStats& statsIn);
+
+    void serialize(ostream& fout) const;
+
+    void deserialize(istream& fin);
       
     void print(
       ostream& fstr,
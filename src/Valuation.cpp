@@ -7,16 +7,9 @@
 */
 
 
-#if defined(_WIN32) && defined(__MINGW32__)
-  #include "mingw.mutex.h"
-  #else
-    #include <mutex>
-    #endif
-
 #include <iostream>
 #include <iomanip>
 #include <sstream>
-#include <map>
 #include <algorithm>
 
 #include "Valuation.h"
@@ -24,10 +17,6 @@
 
 #define MAX_HOLDING 8191 // 2^13 - 1
 
-static mutex mtx;
-static bool setValuationTables = false;
-
-
 static CardArray POWER = 
 {
   4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1
@@ -112,7 +101,10 @@ const vector<DistBundle> DistInfo =
   {"ZAR", "Zar", 10}
 };
 
-static map<int, unsigned> distCodeMap;
+// Index of the distribution with the given spade, heart and
+// diamond lengths (clubs make up the rest).
+static unsigned DIST_CODE_TO_NO
+  [BRIDGE_TRICKS+1][BRIDGE_TRICKS+1][BRIDGE_TRICKS+1];
 
 struct CompBundle
 {
@@ -166,14 +158,6 @@ const vector<CompBundle> CompInfo =
 Valuation::Valuation()
 {
   Valuation::reset();
-  if (! setValuationTables)
-  {
-    mtx.lock();
-    if (! setValuationTables)
-      Valuation::setTables();
-    setValuationTables = true;
-    mtx.unlock();
-  }
 }
 
 
@@ -251,9 +235,8 @@ void Valuation::setDistTables()
       {
         const int c = BRIDGE_TRICKS-s-h-d;
 
-        const int distCode = (s << 12) | (h << 8) | (d << 4) | c;
         DistListArray& dlist = DIST_LIST[no];
-        distCodeMap[distCode] = no++;
+        DIST_CODE_TO_NO[s][h][d] = no++;
 
         array<SuitPair, BRIDGE_SUITS> v;
         v[0] = {BRIDGE_SPADES, s};
@@ -293,7 +276,7 @@ void Valuation::setDistTables()
     THROW("Bad number of distributions");
   
   // There is a wonderful formula for calculating directly the
-  // index in dlist without a map (not implemented here):
+  // index in dlist without even a table (not implemented here):
   // https://math.stackexchange.com/questions/2320636/turn-a-restricted-composition-or-partition-into-a-unique-index
 }
 
@@ -668,16 +651,16 @@ void Valuation::lookup(const unsigned cards[BRIDGE_SUITS])
   for (unsigned s = 0; s < BRIDGE_SUITS; s++)
     suitValues[s] = &SUIT_LIST[cards[s] >> 2];
 
-  const int distKey = 
-    ((*suitValues[0])[VS_LENGTH] << 12) |
-    ((*suitValues[1])[VS_LENGTH] << 8) |
-    ((*suitValues[2])[VS_LENGTH] << 4) |
-     (*suitValues[3])[VS_LENGTH];
+  const int ls = (*suitValues[0])[VS_LENGTH];
+  const int lh = (*suitValues[1])[VS_LENGTH];
+  const int ld = (*suitValues[2])[VS_LENGTH];
+  const int lc = (*suitValues[3])[VS_LENGTH];
 
-  auto it = distCodeMap.find(distKey);
-  if (it == distCodeMap.end())
+  if (ls + lh + ld + lc != BRIDGE_TRICKS ||
+      ls < 0 || lh < 0 || ld < 0 || lc < 0)
     THROW("Could not find distKey\n");
-  distValues = &DIST_LIST[it->second];
+
+  distValues = &DIST_LIST[DIST_CODE_TO_NO[ls][lh][ld]];
 }
 
 
@@ -281,46 +281,46 @@ class Valuation
     CompositeArray compValues;
 
 
-    void setSuitTables();
+    static void setSuitTables();
 
-    void setSuitLength(
+    static void setSuitLength(
       SuitListArray& list,
       CardArray& cards,
       const unsigned holding);
 
-    void setSuitHCP(
+    static void setSuitHCP(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitTops(
+    static void setSuitTops(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitCCCC(
+    static void setSuitCCCC(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitZar(
+    static void setSuitZar(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitFL(SuitListArray& list);
+    static void setSuitFL(SuitListArray& list);
 
-    void setSuitPlayTricks(
+    static void setSuitPlayTricks(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitQuickTricks(
+    static void setSuitQuickTricks(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitLosers(
+    static void setSuitLosers(
       SuitListArray& list,
       const CardArray& cards);
 
-    void setSuitEffLength(SuitListArray& list);
+    static void setSuitEffLength(SuitListArray& list);
 
-    void setDistTables();
+    static void setDistTables();
 
     void lookup(const unsigned cards[BRIDGE_SUITS]);
 
@@ -341,7 +341,7 @@ class Valuation
 
     void reset();
 
-    void setTables();
+    static void setTables();
 
     void evaluate(
       const unsigned cards[BRIDGE_SUITS],
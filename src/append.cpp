@@ -0,0 +1,164 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include <stdio.h>
+
+#include "append.h"
+
+
+// Enough for the digits and sign of any 32-bit number.
+#define APPEND_DIGITS 12
+
+
+static void appendPadded(
+  string& st,
+  const char * text,
+  const unsigned len,
+  const unsigned width,
+  const char fill)
+{
+  if (len < width)
+    st.append(width - len, fill);
+  st.append(text, len);
+}
+
+
+void appendUnsigned(
+  string& st,
+  const unsigned u,
+  const unsigned width,
+  const char fill)
+{
+  char digits[APPEND_DIGITS];
+  unsigned pos = APPEND_DIGITS;
+  unsigned v = u;
+  do
+  {
+    digits[--pos] = static_cast<char>('0' + v % 10);
+    v /= 10;
+  }
+  while (v > 0);
+
+  appendPadded(st, digits + pos, APPEND_DIGITS - pos, width, fill);
+}
+
+
+void appendInt(
+  string& st,
+  const int i,
+  const unsigned width,
+  const bool plusFlag)
+{
+  char digits[APPEND_DIGITS];
+  unsigned pos = APPEND_DIGITS;
+
+  // Works for the most negative int as well.
+  unsigned v = (i < 0 ? 0u - static_cast<unsigned>(i) :
+    static_cast<unsigned>(i));
+  do
+  {
+    digits[--pos] = static_cast<char>('0' + v % 10);
+    v /= 10;
+  }
+  while (v > 0);
+
+  if (i < 0)
+    digits[--pos] = '-';
+  else if (plusFlag)
+    digits[--pos] = '+';
+
+  appendPadded(st, digits + pos, APPEND_DIGITS - pos, width, ' ');
+}
+
+
+void appendHex(
+  string& st,
+  const unsigned u)
+{
+  // Upper-case digits, as with hex << uppercase.
+  char digits[APPEND_DIGITS];
+  unsigned pos = APPEND_DIGITS;
+  unsigned v = u;
+  do
+  {
+    digits[--pos] = "0123456789ABCDEF"[v & 0xf];
+    v >>= 4;
+  }
+  while (v > 0);
+
+  st.append(digits + pos, APPEND_DIGITS - pos);
+}
+
+
+void appendFixed(
+  string& st,
+  const double d,
+  const unsigned decimals,
+  const unsigned width)
+{
+  // Same digits as fixed << setprecision(decimals).
+  char buffer[64];
+  const int n = snprintf(buffer, sizeof(buffer), "%.*f",
+    static_cast<int>(decimals), d);
+  if (n < 0)
+    return;
+
+  if (static_cast<size_t>(n) < sizeof(buffer))
+  {
+    appendPadded(st, buffer, static_cast<unsigned>(n), width, ' ');
+    return;
+  }
+
+  string large(static_cast<size_t>(n) + 1, '\0');
+  snprintf(&large[0], large.size(), "%.*f",
+    static_cast<int>(decimals), d);
+  appendPadded(st, large.data(), static_cast<unsigned>(n), width, ' ');
+}
+
+
+void appendSpaces(
+  string& st,
+  const unsigned n)
+{
+  st.append(n, ' ');
+}
+
+
+void appendLeft(
+  string& st,
+  const string& text,
+  const unsigned width)
+{
+  st += text;
+  if (text.length() < width)
+    st.append(width - text.length(), ' ');
+}
+
+
+void appendRight(
+  string& st,
+  const string& text,
+  const unsigned width)
+{
+  appendPadded(st, text.data(), static_cast<unsigned>(text.length()),
+    width, ' ');
+}
+
+
+void padTo(
+  string& st,
+  const size_t start,
+  const unsigned width)
+{
+  // Left-aligns whatever was appended since start.
+  const size_t len = st.length() - start;
+  if (len < width)
+    st.append(width - len, ' ');
+}
+
@@ -0,0 +1,66 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// These functions format straight onto the end of a string, and
+// the writers use them instead of stringstream.  Numbers are
+// converted without a stream or a locale, and padding is added in
+// place.  As with setw, a width is a minimum, so longer text is not
+// cut, and numbers are aligned to the right unless padTo is used.
+
+
+#ifndef BRIDGE_APPEND_H
+#define BRIDGE_APPEND_H
+
+#include <string>
+
+using namespace std;
+
+
+void appendUnsigned(
+  string& st,
+  const unsigned u,
+  const unsigned width = 0,
+  const char fill = ' ');
+
+void appendInt(
+  string& st,
+  const int i,
+  const unsigned width = 0,
+  const bool plusFlag = false);
+
+void appendHex(
+  string& st,
+  const unsigned u);
+
+void appendFixed(
+  string& st,
+  const double d,
+  const unsigned decimals,
+  const unsigned width = 0);
+
+void appendSpaces(
+  string& st,
+  const unsigned n);
+
+void appendLeft(
+  string& st,
+  const string& text,
+  const unsigned width);
+
+void appendRight(
+  string& st,
+  const string& text,
+  const unsigned width);
+
+void padTo(
+  string& st,
+  const size_t start,
+  const unsigned width);
+
+#endif
+
@@ -14,6 +14,7 @@
 #include <string>
 
 #include "args.h"
+#include "parse.h"
 
 using namespace std;
 
@@ -25,7 +26,7 @@ struct OptEntry
   unsigned numArgs;
 };
 
-#define BRIDGE_NUM_OPTIONS 21
+#define BRIDGE_NUM_OPTIONS 28
 
 static const OptEntry OPT_LIST[BRIDGE_NUM_OPTIONS] =
 {
@@ -39,16 +40,23 @@ static const OptEntry OPT_LIST[BRIDGE_NUM_OPTIONS] =
   {"D", "digdir", 1},
   {"t", "tableIMP", 0},
   {"l", "logfile", 1},
+  {"M", "manifest", 1},
   {"c", "compare", 0},
   {"p", "players", 0},
   {"e", "equal", 0},
+  {"L", "lsh", 1},
   {"V", "valuation", 0},
   {"S", "solve", 0},
   {"T", "trace", 0},
+  {"F", "freeze", 0},
   {"f", "format", 1},
   {"s", "stats", 0},
   {"q", "quotes", 0},
   {"n", "threads", 1},
+  {"w", "ddwait", 1},
+  {"x", "split", 1},
+  {"m", "multi", 1},
+  {"P", "pipeline", 1},
   {"v", "verbose", 1}
 };
 
@@ -64,6 +72,14 @@ static void printFileOption(
   const FileOption& fopt,
   const string& text);
 
+static bool parsePipeline(
+  const string& text,
+  Options& options);
+
+static bool parseLSH(
+  const string& text,
+  Options& options);
+
 static void checkArgs(const Options& options);
 
 
@@ -97,6 +113,13 @@ void usage(
     "\n" <<
     "-l, --logfile s    Log file for outputs (default: stdout).\n" <<
     "\n" <<
+    "-M, --manifest s   Manifest file for incremental runs.  Files whose\n" <<
+    "                   input, ref files and options are unchanged are\n" <<
+    "                   skipped, and their stats are taken from the\n" <<
+    "                   manifest.  Per-file log output is not repeated.\n" <<
+    "                   Cannot be combined with -F or -P.\n" <<
+    "                   (Default: not set)\n" <<
+    "\n" <<
     "-c, --compare      Re-read output and compare internally.\n" <<
     "                   (Default: not set)\n" <<
     "\n" <<
@@ -107,6 +130,14 @@ void usage(
     "                   for equals separately. (Default: not set).\n" <<
     "                   Implies --valuation flag as well.\n" <<
     "\n" <<
+    "-L, --lsh b,r      With -e, only look for subsets among segments\n" <<
+    "                   whose MinHash signatures of b bands of r rows\n" <<
+    "                   agree in some band.  A pair with Jaccard\n" <<
+    "                   similarity J is found with probability\n" <<
+    "                   1-(1-J^r)^b: More bands find more, more rows\n" <<
+    "                   try fewer.  (Default: not set, all segments\n" <<
+    "                   that share a deal are tried).\n" <<
+    "\n" <<
     "-V, --valuation    Perform valuation of hands.\n" <<
     "                   (Default: not set)\n" <<
     "\n" <<
@@ -116,8 +147,13 @@ void usage(
     "-T, --trace        Perform double-dummy trace analysis.\n" <<
     "                   (Default: not set)\n" <<
     "\n" <<
+    "-F, --freeze       Keep all boards in memory in a compact form,\n" <<
+    "                   and report the memory used.  With -c, also\n" <<
+    "                   thaw each board and compare it internally.\n" <<
+    "                   (Default: not set)\n" <<
+    "\n" <<
     "-f, --format s     Output format for -O (default: ALL).\n" <<
-    "                   Values LIN, PBN, RBN, TXT, EML, DOC, REC, ALL.\n" <<
+    "                   Values LIN, PBN, RBN, TXT, EML, DOC, REC, BDB, ALL.\n" <<
     "                   Some dialects are set by the input filename.\n" <<
     "\n" <<
     "-s, --stats        Output length stats of free-form fields.\n" <<
@@ -128,6 +164,22 @@ void usage(
     "\n" <<
     "-n, --threads n    Number of threads (default: 1).\n" <<
     "\n" <<
+    "-w, --ddwait n     Collect DD work from several files into full\n" <<
+    "                   batches, waiting at most n ms for a batch to\n" <<
+    "                   fill (0 .. 60000, default: 0, batches per file).\n" <<
+    "\n" <<
+    "-x, --split n      Read each large PBN, RBN or TXT file as up to\n" <<
+    "                   n pieces in parallel (default: 1, no split).\n" <<
+    "\n" <<
+    "-m, --multi n      Write all output formats of a file in one pass\n" <<
+    "                   over its boards, shared among up to n threads\n" <<
+    "                   (default: 0, one format after the other).\n" <<
+    "\n" <<
+    "-P, --pipeline s   Run read, analyze, write and validate as\n" <<
+    "                   separate stages with queues in between, e.g.\n" <<
+    "                   1,2,2,1 threads per stage.  Replaces -n.\n" <<
+    "                   (Default: not set)\n" <<
+    "\n" <<
     "-v, -verbose n     Verbosity (default: 0x1a).  Bits:\n" <<
     "                   0x01: Show input/output file names.\n" <<
     "                   0x02: Show input error messages.\n" <<
@@ -199,6 +251,7 @@ static void setDefaults(Options& options)
   options.fileDigest = {false, ""};
   options.dirDigest = {false, ""};
   options.fileLog = {false, ""};
+  options.fileManifest = {false, ""};
 
   options.tableIMPFlag = false;
   options.compareFlag = false;
@@ -207,6 +260,7 @@ static void setDefaults(Options& options)
   options.valuationFlag = false;
   options.solveFlag = false;
   options.traceFlag = false;
+  options.freezeFlag = false;
 
   options.formatSetFlag = false;
   options.format = BRIDGE_FORMAT_SIZE;
@@ -215,6 +269,15 @@ static void setDefaults(Options& options)
   options.quoteFlag = false;
 
   options.numThreads = 1;
+  options.ddWait = 0;
+  options.splitPieces = 1;
+  options.multiWrite = 0;
+  options.lshBands = 0;
+  options.lshRows = 0;
+
+  options.pipelineFlag = false;
+  for (unsigned s = 0; s < BRIDGE_STAGE_SIZE; s++)
+    options.stageThreads[s] = 1;
 
   options.verboseIO = false;
   options.verboseThrow = true;
@@ -253,6 +316,8 @@ void printOptions(const Options& options)
 
   printFileOption(options.fileLog, "logfile");
 
+  printFileOption(options.fileManifest, "manifest");
+
   if (options.compareFlag)
     cout << setw(12) << "compare" << setw(12) << "set" << "\n";
   else
@@ -273,6 +338,11 @@ void printOptions(const Options& options)
   else
     cout << setw(12) << "trace" << setw(12) << "not set" << "\n";
 
+  if (options.freezeFlag)
+    cout << setw(12) << "freeze" << setw(12) << "set" << "\n";
+  else
+    cout << setw(12) << "freeze" << setw(12) << "not set" << "\n";
+
   if (options.formatSetFlag)
   {
     cout << setw(12) << "format" << 
@@ -286,7 +356,77 @@ void printOptions(const Options& options)
   else
     cout << setw(12) << "stats" << setw(12) << "not set" << "\n";
 
-  cout << setw(12) << "threads" << setw(12) << options.numThreads << "\n\n";
+  cout << setw(12) << "threads" << setw(12) << options.numThreads << "\n";
+  cout << setw(12) << "ddwait" << setw(12) << options.ddWait << "\n";
+  cout << setw(12) << "split" << setw(12) << options.splitPieces << "\n";
+  cout << setw(12) << "multi" << setw(12) << options.multiWrite << "\n";
+
+  if (options.lshBands > 0)
+    cout << setw(12) << "lsh" << setw(12) <<
+      options.lshBands << "," << options.lshRows << "\n";
+  else
+    cout << setw(12) << "lsh" << setw(12) << "not set" << "\n";
+
+  if (options.pipelineFlag)
+  {
+    cout << setw(12) << "pipeline" << setw(12) << 
+      options.stageThreads[BRIDGE_STAGE_READ] << "," <<
+      options.stageThreads[BRIDGE_STAGE_ANALYZE] << "," <<
+      options.stageThreads[BRIDGE_STAGE_WRITE] << "," <<
+      options.stageThreads[BRIDGE_STAGE_VALIDATE] << "\n\n";
+  }
+  else
+    cout << setw(12) << "pipeline" << setw(12) << "not set" << "\n\n";
+}
+
+
+static bool parsePipeline(
+  const string& text,
+  Options& options)
+{
+  vector<string> tokens(BRIDGE_STAGE_SIZE);
+  tokens.clear();
+  tokenize(text, tokens, ",");
+  if (tokens.size() != BRIDGE_STAGE_SIZE)
+    return false;
+
+  unsigned sum = 0;
+  for (unsigned s = 0; s < BRIDGE_STAGE_SIZE; s++)
+  {
+    unsigned u;
+    if (! str2unsigned(tokens[s], u) || u < 1 || u > 8)
+      return false;
+    options.stageThreads[s] = u;
+    sum += u;
+  }
+
+  if (sum > 16)
+    return false;
+
+  options.pipelineFlag = true;
+  return true;
+}
+
+
+static bool parseLSH(
+  const string& text,
+  Options& options)
+{
+  vector<string> tokens(2);
+  tokens.clear();
+  tokenize(text, tokens, ",");
+  if (tokens.size() != 2)
+    return false;
+
+  unsigned bands, rows;
+  if (! str2unsigned(tokens[0], bands) || bands < 1 || bands > 64)
+    return false;
+  if (! str2unsigned(tokens[1], rows) || rows < 1 || rows > 16)
+    return false;
+
+  options.lshBands = bands;
+  options.lshRows = rows;
+  return true;
 }
 
 
@@ -348,6 +488,25 @@ static void checkArgs(const Options& options)
     cout << "Cannot use -f with either -o or -r." << endl;
     exit(0);
   }
+
+  if (options.fileManifest.setFlag && options.pipelineFlag)
+  {
+    cout << "Cannot use -M with -P." << endl;
+    exit(0);
+  }
+
+  if (options.fileManifest.setFlag && options.freezeFlag)
+  {
+    // -M skips unchanged files, so -F would only freeze some of them.
+    cout << "Cannot use -M with -F." << endl;
+    exit(0);
+  }
+
+  if (options.lshBands > 0 && ! options.equalFlag)
+  {
+    cout << "-L requires -e." << endl;
+    exit(0);
+  }
 }
 
 
@@ -418,6 +577,10 @@ void readArgs(
         options.fileLog = {true, optarg};
         break;
 
+      case 'M':
+        options.fileManifest = {true, optarg};
+        break;
+
       case 't':
         options.tableIMPFlag = true;
         break;
@@ -439,6 +602,10 @@ void readArgs(
         options.valuationFlag = true;
         break;
 
+      case 'F':
+        options.freezeFlag = true;
+        break;
+
       case 'S':
         options.solveFlag = true;
         break;
@@ -495,6 +662,81 @@ void readArgs(
         options.numThreads = mu;
         break;
 
+      case 'w':
+        errno = 0;
+        m = strtol(optarg, &temp, 0);
+        if (temp == optarg || *temp != '\0' || errno == ERANGE)
+        {
+          cout << "Could not parse ddwait\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+        else if (m < 0 || m > 60000)
+        {
+          cout << "ddwait out of range\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+
+        options.ddWait = static_cast<unsigned>(m);
+        break;
+
+      case 'x':
+        errno = 0;
+        m = strtol(optarg, &temp, 0);
+        if (temp == optarg || *temp != '\0' || errno == ERANGE)
+        {
+          cout << "Could not parse split\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+        else if (m < 1 || m > 16)
+        {
+          cout << "split out of range\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+
+        options.splitPieces = static_cast<unsigned>(m);
+        break;
+
+      case 'm':
+        errno = 0;
+        m = strtol(optarg, &temp, 0);
+        if (temp == optarg || *temp != '\0' || errno == ERANGE)
+        {
+          cout << "Could not parse multi\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+        else if (m < 0 || m > 16)
+        {
+          cout << "multi out of range\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+
+        options.multiWrite = static_cast<unsigned>(m);
+        break;
+
+      case 'L':
+        if (! parseLSH(optarg, options))
+        {
+          cout << "Could not parse lsh\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+        break;
+
+      case 'P':
+        if (! parsePipeline(optarg, options))
+        {
+          cout << "Could not parse pipeline\n";
+          nextToken -= 2;
+          errFlag = true;
+        }
+        break;
+
       case 'v':
         m = static_cast<int>(strtol(optarg, &temp, 0));
         if (temp == optarg || temp == '\0' ||
@@ -528,6 +770,14 @@ void readArgs(
     exit(0);
   }
 
+  if (options.pipelineFlag)
+  {
+    // Each stage thread has its own stats and log, like the -n threads.
+    options.numThreads = 0;
+    for (unsigned s = 0; s < BRIDGE_STAGE_SIZE; s++)
+      options.numThreads += options.stageThreads[s];
+  }
+
   checkArgs(options);
 }
 
@@ -44,8 +44,9 @@ enum Format
   BRIDGE_FORMAT_TXT = 7,
   BRIDGE_FORMAT_EML = 8,
   BRIDGE_FORMAT_REC = 9,
-  BRIDGE_FORMAT_PAR = 10, // Not a real file format
-  BRIDGE_FORMAT_SIZE = 11
+  BRIDGE_FORMAT_BDB = 10, // Our own binary format
+  BRIDGE_FORMAT_PAR = 11, // Not a real file format
+  BRIDGE_FORMAT_SIZE = 12
 };
 
 
@@ -61,6 +62,7 @@ const string FORMAT_NAMES[BRIDGE_FORMAT_SIZE] =
   "TXT", 
   "EML",
   "REC",
+  "BDB",
   "PAR"
 };
 
@@ -76,6 +78,7 @@ const string FORMAT_EXTENSIONS[BRIDGE_FORMAT_SIZE] =
   "TXT", 
   "EML",
   "REC",
+  "BDB",
   "PAR"
 };
 
@@ -92,6 +95,7 @@ const Format FORMAT_INPUT_MAP[] =
   BRIDGE_FORMAT_TXT,
   BRIDGE_FORMAT_EML,
   BRIDGE_FORMAT_REC,
+  BRIDGE_FORMAT_BDB,
   BRIDGE_FORMAT_SIZE,
   BRIDGE_FORMAT_SIZE
 };
@@ -108,7 +112,8 @@ const vector<Format> FORMAT_ACTIVE =
   BRIDGE_FORMAT_RBX,
   BRIDGE_FORMAT_TXT,
   BRIDGE_FORMAT_EML,
-  BRIDGE_FORMAT_REC
+  BRIDGE_FORMAT_REC,
+  BRIDGE_FORMAT_BDB
 };
 
 
@@ -220,6 +225,18 @@ struct WriteInfo
 };
 
 
+// Stages of the optional pipelined mode.
+
+enum PipeStage
+{
+  BRIDGE_STAGE_READ = 0,
+  BRIDGE_STAGE_ANALYZE = 1,
+  BRIDGE_STAGE_WRITE = 2,
+  BRIDGE_STAGE_VALIDATE = 3,
+  BRIDGE_STAGE_SIZE = 4
+};
+
+
 // Input options.
 
 struct FileOption
@@ -244,6 +261,8 @@ struct Options
 
   FileOption fileLog; // -l, --logfile
 
+  FileOption fileManifest; // -M, --manifest
+
   bool tableIMPFlag; // -T, --tableIMP
   bool compareFlag; // -c, --compare
   bool playersFlag; // -p, --players
@@ -251,6 +270,7 @@ struct Options
   bool valuationFlag; // -V, --valuation
   bool solveFlag; // -S, --solve
   bool traceFlag; // -T, --trace
+  bool freezeFlag; // -F, --freeze
 
   bool formatSetFlag; // -f, --format
   Format format;
@@ -259,6 +279,14 @@ struct Options
   bool quoteFlag; // -q, --quote
 
   unsigned numThreads;
+  unsigned ddWait; // -w, --ddwait
+  unsigned splitPieces; // -x, --split
+  unsigned multiWrite; // -m, --multi
+  unsigned lshBands; // -L, --lsh
+  unsigned lshRows;
+
+  bool pipelineFlag; // -P, --pipeline
+  unsigned stageThreads[BRIDGE_STAGE_SIZE];
 
   bool verboseIO;
   bool verboseThrow;
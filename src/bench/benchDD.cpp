@@ -0,0 +1,206 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Times DD tableaux against the number of worker threads.
+//
+// Usage: benchDD [deals] [threads]
+//
+// For 1, 2, 4, ... up to the given number of threads, the deals are
+// dealt out among that many workers, and each worker solves its own
+// deals in batches of MAXNOOFTABLES through tableauDD, as the reader
+// does with -S.  With one worker, DDS spreads each batch over its own
+// threads.  With several, each worker solves in its own DDS thread
+// context.  The deals come from a fixed random seed, so runs can be
+// compared.
+
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+#else
+  #include <thread>
+#endif
+
+#include "bconst.h"
+#include "ddsIF.h"
+#include "Timer.h"
+#include "dispatch.h"
+#include "Bexcept.h"
+
+using namespace std;
+
+const string BENCH_RANKS = "23456789TJQKA";
+
+
+static void makeDeal(
+  mt19937& rng,
+  string& pbn)
+{
+  vector<unsigned> deck(52);
+  for (unsigned c = 0; c < 52; c++)
+    deck[c] = c;
+  shuffle(deck.begin(), deck.end(), rng);
+
+  unsigned holding[BRIDGE_PLAYERS][BRIDGE_SUITS];
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+      holding[p][s] = 0;
+
+  for (unsigned c = 0; c < 52; c++)
+    holding[c / 13][deck[c] / 13] |= (1u << (deck[c] % 13));
+
+  pbn = "N:";
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+  {
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+    {
+      for (unsigned r = 13; r-- > 0; )
+        if (holding[p][s] & (1u << r))
+          pbn += BENCH_RANKS[r];
+      if (s < 3)
+        pbn += ".";
+    }
+    if (p < 3)
+      pbn += " ";
+  }
+}
+
+
+static void solveShare(
+  const vector<string>& deals,
+  const unsigned thrNo,
+  const unsigned numThreads,
+  vector<unsigned>& errors)
+{
+  // Worker thrNo takes every numThreads'th deal.
+  setDDThreadNumber(thrNo);
+
+  vector<ddTableDealsPBN> tables(1);
+  vector<ddTablesRes> results(1);
+  ddTableDealsPBN& tablePBN = tables[0];
+  ddTablesRes& resDDS = results[0];
+
+  errors[thrNo] = 0;
+  try
+  {
+    tablePBN.noOfTables = 0;
+    for (unsigned i = thrNo; i < deals.size(); i += numThreads)
+    {
+      strcpy(tablePBN.deals[tablePBN.noOfTables].cards,
+        deals[i].c_str());
+      tablePBN.noOfTables++;
+
+      if (tablePBN.noOfTables == MAXNOOFTABLES)
+      {
+        tableauDD(&tablePBN, &resDDS);
+        tablePBN.noOfTables = 0;
+      }
+    }
+
+    if (tablePBN.noOfTables > 0)
+      tableauDD(&tablePBN, &resDDS);
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(cout);
+    errors[thrNo] = 1;
+  }
+}
+
+
+static bool timeThreads(
+  const vector<string>& deals,
+  const unsigned numThreads,
+  double& seconds)
+{
+  setDDThreads(numThreads);
+
+  vector<thread> thr(numThreads-1);
+  vector<unsigned> errors(numThreads);
+
+  Timer timer;
+  timer.start();
+
+  for (unsigned k = 1; k < numThreads; k++)
+    thr[k-1] = thread(solveShare, cref(deals), k, numThreads,
+      ref(errors));
+
+  solveShare(deals, 0, numThreads, errors);
+
+  for (auto &t: thr)
+    t.join();
+
+  timer.stop();
+  seconds = timer.seconds();
+
+  for (auto e: errors)
+    if (e)
+      return false;
+  return true;
+}
+
+
+int main(int argc, char * argv[])
+{
+  if (argc > 3)
+  {
+    cout << "Usage: " << argv[0] << " [deals] [threads]\n";
+    exit(0);
+  }
+
+  const unsigned numDeals = (argc >= 2 ?
+    static_cast<unsigned>(atoi(argv[1])) : 640);
+  const unsigned maxThreads = (argc == 3 ?
+    static_cast<unsigned>(atoi(argv[2])) :
+    Max(1u, thread::hardware_concurrency()));
+
+  if (numDeals == 0 || maxThreads == 0)
+  {
+    cout << "Usage: " << argv[0] << " [deals] [threads]\n";
+    exit(0);
+  }
+
+  setTables();
+
+  mt19937 rng(1);
+  vector<string> deals(numDeals);
+  for (auto &d: deals)
+    makeDeal(rng, d);
+
+  cout << setw(8) << "threads" << setw(12) << "seconds" <<
+    setw(12) << "tables/s" << setw(10) << "speedup" << "\n";
+  cout << fixed;
+
+  vector<unsigned> counts;
+  for (unsigned t = 1; t < maxThreads; t *= 2)
+    counts.push_back(t);
+  counts.push_back(maxThreads);
+
+  double base = 0.;
+  for (auto t: counts)
+  {
+    double seconds;
+    if (! timeThreads(deals, t, seconds))
+      exit(1);
+
+    if (t == 1)
+      base = seconds;
+
+    cout << setw(8) << t <<
+      setw(12) << setprecision(3) << seconds <<
+      setw(12) << setprecision(1) << numDeals / seconds <<
+      setw(10) << setprecision(2) << base / seconds << "\n";
+  }
+}
@@ -0,0 +1,159 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Times the LIN scanner over a LIN file, once for each pipe-finding
+// path that was compiled in (AVX2, SSE2, scalar).
+//
+// Usage: benchLIN file.lin [LIN|LIN-RP|LIN-VG|LIN-TRN] [reps]
+//
+// "lines" is Buffer::next over the whole file, which finds the line
+// ends with the scanner.  "chunks" is readLINChunk over the whole
+// file, which also splits every line into label|value| pairs.
+// The time is the best of the repetitions, and reading the file
+// into the Buffer is not part of it.
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include "Group.h"
+#include "Buffer.h"
+#include "RefLines.h"
+#include "Chunk.h"
+#include "LINScan.h"
+#include "Timer.h"
+#include "fileLIN.h"
+#include "dispatch.h"
+#include "Bexcept.h"
+
+using namespace std;
+
+const string PATH_NAMES[] = { "scalar", "SSE2", "AVX2" };
+
+
+static double timeLines(
+  const string& fname,
+  const Format format,
+  size_t& bytes)
+{
+  Buffer buffer;
+  RefLines refLines;
+  buffer.read(fname, format, refLines);
+
+  LineData lineData;
+  bytes = 0;
+
+  Timer timer;
+  timer.start();
+  while (buffer.next(lineData))
+    bytes += lineData.len + 1;
+  timer.stop();
+  return timer.seconds();
+}
+
+
+static double timeChunks(
+  const string& fname,
+  const Format format,
+  unsigned& chunks)
+{
+  Buffer buffer;
+  RefLines refLines;
+  buffer.read(fname, format, refLines);
+
+  Chunk chunk;
+  chunks = 0;
+
+  Timer timer;
+  timer.start();
+  while (true)
+  {
+    chunk.reset();
+    bool newSegFlag = false;
+    readLINChunk(buffer, chunk, newSegFlag);
+    if (chunk.seemsEmpty())
+      break;
+    chunks++;
+  }
+  timer.stop();
+  return timer.seconds();
+}
+
+
+static string rate(
+  const size_t bytes,
+  const double secs)
+{
+  stringstream ss;
+  ss << fixed << setprecision(1) << setw(9) <<
+    (secs > 0. ? bytes / secs / 1.e6 : 0.) << " MB/s";
+  return ss.str();
+}
+
+
+int main(int argc, char * argv[])
+{
+  if (argc < 2 || argc > 4)
+  {
+    cout << "Usage: " << argv[0] <<
+      " file.lin [LIN|LIN-RP|LIN-VG|LIN-TRN] [reps]\n";
+    exit(0);
+  }
+
+  Format format = BRIDGE_FORMAT_LIN;
+  if (argc >= 3)
+  {
+    const string s(argv[2]);
+    for (unsigned f = BRIDGE_FORMAT_LIN; f <= BRIDGE_FORMAT_LIN_TRN; f++)
+    {
+      if (s == FORMAT_NAMES[f])
+        format = static_cast<Format>(f);
+    }
+  }
+
+  const int reps = (argc == 4 ? atoi(argv[3]) : 10);
+
+  setTables();
+
+  try
+  {
+    size_t bytes = 0;
+    unsigned chunks = 0;
+
+    for (int p = LINScanner::bestPath(); p >= LINSCAN_PATH_SCALAR; p--)
+    {
+      LINScanner::setPath(static_cast<LINScanPath>(p));
+
+      double bestLines = 1.e9, bestChunks = 1.e9;
+      for (int r = 0; r < reps; r++)
+      {
+        const double tl = timeLines(argv[1], format, bytes);
+        if (tl < bestLines)
+          bestLines = tl;
+
+        const double tc = timeChunks(argv[1], format, chunks);
+        if (tc < bestChunks)
+          bestChunks = tc;
+      }
+
+      cout << setw(8) << left << PATH_NAMES[p] << right <<
+        "lines " << rate(bytes, bestLines) <<
+        "   chunks " << rate(bytes, bestChunks) << "\n";
+    }
+
+    cout << "\n" << bytes << " bytes, " << chunks << " chunks\n";
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(cout);
+    exit(1);
+  }
+}
+
@@ -0,0 +1,163 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Times the board lookups of a Segment as it grows, against the
+// list scan that Segment used before it kept an index.
+//
+// Usage: benchSegment [reps]
+//
+// "acquire" adds each board with one instance and then looks it up
+// eight more times, as the readers do for the labels of a board.
+// "get" then fetches every board four times.  "list" does this with
+// the old list<BoardPair> and a linear scan for each lookup, "index"
+// with Segment::acquireBoard and Segment::getBoard.  Both run on the
+// heap.  The times are the best of the repetitions.
+
+
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <cstdlib>
+
+#include "Segment.h"
+#include "Board.h"
+#include "Timer.h"
+#include "dispatch.h"
+#include "Bexcept.h"
+
+using namespace std;
+
+// So that the compiler cannot drop the timed calls.
+static unsigned sink = 0;
+
+
+// The lookups of Segment as they were with a list of boards.
+
+class ListSegment
+{
+  private:
+
+    list<BoardPair> boards;
+    unsigned len;
+
+  public:
+
+    ListSegment() { len = 0; }
+
+    Board const * getBoard(const unsigned extNo) const
+    {
+      for (auto &p: boards)
+        if (p.extNo == extNo)
+          return &p.board;
+      return nullptr;
+    }
+
+    Board * acquireBoard(const unsigned extNo)
+    {
+      for (auto &p: boards)
+        if (p.extNo == extNo)
+          return &p.board;
+
+      boards.emplace_back(BoardPair());
+      BoardPair& bp = boards.back();
+      bp.intNo = len;
+      bp.extNo = extNo;
+      len++;
+      return &bp.board;
+    }
+};
+
+
+template <class S>
+static void timeSegment(
+  const unsigned numBoards,
+  double& tAcquire,
+  double& tGet)
+{
+  S segment;
+  Timer timer;
+
+  timer.start();
+  for (unsigned b = 1; b <= numBoards; b++)
+  {
+    Board * board = segment.acquireBoard(b);
+    board->acquireInstance(0);
+    for (unsigned k = 0; k < 8; k++)
+      segment.acquireBoard(b);
+  }
+  timer.stop();
+  tAcquire = timer.seconds();
+
+  timer.reset();
+  timer.start();
+  for (unsigned rep = 0; rep < 4; rep++)
+    for (unsigned b = 1; b <= numBoards; b++)
+      sink += (segment.getBoard(b) != nullptr);
+  timer.stop();
+  tGet = timer.seconds();
+}
+
+
+template <class S>
+static void timeSize(
+  const unsigned numBoards,
+  const unsigned reps,
+  const string& name)
+{
+  double bestAcquire = 1.e9, bestGet = 1.e9;
+  for (unsigned r = 0; r < reps; r++)
+  {
+    double tAcquire, tGet;
+    timeSegment<S>(numBoards, tAcquire, tGet);
+
+    if (tAcquire < bestAcquire)
+      bestAcquire = tAcquire;
+    if (tGet < bestGet)
+      bestGet = tGet;
+  }
+
+  cout << setw(6) << numBoards << setw(8) << name <<
+    setw(12) << 1000. * bestAcquire << " ms" <<
+    setw(12) << 1000. * bestGet << " ms\n";
+}
+
+
+int main(int argc, char * argv[])
+{
+  if (argc > 2)
+  {
+    cout << "Usage: " << argv[0] << " [reps]\n";
+    exit(0);
+  }
+
+  const unsigned reps = (argc == 2 ?
+    static_cast<unsigned>(atoi(argv[1])) : 10);
+
+  setTables();
+
+  cout << setw(6) << "boards" << setw(8) << "lookup" <<
+    setw(15) << "acquire" << setw(15) << "get" << "\n";
+  cout << fixed << setprecision(3);
+
+  try
+  {
+    for (unsigned n: {32u, 256u, 1024u, 4096u})
+    {
+      timeSize<ListSegment>(n, reps, "list");
+      timeSize<Segment>(n, reps, "index");
+    }
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(cout);
+    exit(1);
+  }
+
+  if (sink == 0)
+    cout << "\n";
+}
@@ -0,0 +1,532 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Times the table-driven decoders for suits, cards, calls, contracts,
+// hand shapes and LIN labels against the std::map lookups that they
+// replaced, in ns per token.
+//
+// Usage: benchTables [reps]
+//
+// "map" is the old lookup, with its map built here as the old
+// setTables() did, on the same tokens.  "table" is the current code.
+// Most of the decoders are private, so they are timed through the
+// thinnest public call that reaches them:
+// - suitToHolding through Deal::set on a PBN deal (16 suits).
+// - addPlay on a whole legal play of 52 cards.
+// - addCall on a whole auction of 10 calls.
+// - setContractByString through Contract::setContract in LIN.
+// - the Valuation lookup through Valuation::evaluate.
+// Those times include the rest of the call, so they understate the
+// gain.  lookupLINLabel is timed on its own.  The inputs come from
+// a fixed random seed, so runs can be compared.
+
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+
+#include "Group.h"
+#include "Deal.h"
+#include "Play.h"
+#include "Auction.h"
+#include "Contract.h"
+#include "Valuation.h"
+#include "Timer.h"
+#include "fileLIN.h"
+#include "dispatch.h"
+#include "Bexcept.h"
+
+using namespace std;
+
+#define NUM_DEALS 1000
+
+const string BENCH_SUITS = "SHDC";
+const string BENCH_RANKS = "23456789TJQKA";
+
+struct BenchDeal
+{
+  string pbn;
+  vector<string> suits;
+  unsigned holding[BRIDGE_PLAYERS][BRIDGE_SUITS];
+  vector<string> plays;
+};
+
+// So that the compiler cannot drop the timed calls.
+static unsigned sink = 0;
+
+// The maps that the tables replaced.
+static map<string, unsigned> REF_SUIT_TO_HOLDING;
+static map<string, unsigned> REF_CARD_TO_NO;
+static map<string, unsigned> REF_CALL_TO_NO;
+static map<string, unsigned> REF_CONTRACT_TO_NO;
+static map<int, unsigned> REF_DIST_TO_NO;
+static map<string, unsigned> REF_LIN_TO_LABEL;
+
+
+static void setRefTables()
+{
+  const string cards = "23456789TJQKA";
+  for (unsigned h = 0; h < (1u << BRIDGE_TRICKS); h++)
+  {
+    string suit("");
+    for (unsigned bit = BRIDGE_TRICKS; bit-- > 0; )
+      if (h & (1u << bit))
+        suit += cards[bit];
+    REF_SUIT_TO_HOLDING[suit] = h;
+    reverse(suit.begin(), suit.end());
+    REF_SUIT_TO_HOLDING[suit] = h;
+  }
+
+  const string denoms = "SHDCshdc";
+  for (unsigned d = 0; d < denoms.length(); d++)
+    for (unsigned r = 0; r < BRIDGE_TRICKS; r++)
+      REF_CARD_TO_NO[string(1, denoms[d]) + cards[r]] =
+        BRIDGE_TRICKS * (d % 4) + r;
+
+  const vector<vector<string>> words =
+    {{"P", "Pass", "pass", "PASS"}, {"D", "X", "Dbl"}, {"R", "XX", "Rdbl"}};
+  for (unsigned w = 0; w < words.size(); w++)
+    for (auto& word: words[w])
+      REF_CALL_TO_NO[word] = w;
+
+  const vector<string> denomsLIN = {"C", "D", "H", "S", "N"};
+  const vector<string> denomsPBN = {"C", "D", "H", "S", "NT"};
+  unsigned no = 3;
+  for (unsigned level = 1; level <= 7; level++)
+  {
+    for (unsigned d = 0; d < BRIDGE_DENOMS; d++, no++)
+    {
+      REF_CALL_TO_NO[to_string(level) + denomsLIN[d]] = no;
+      REF_CALL_TO_NO[to_string(level) + denomsPBN[d]] = no;
+    }
+  }
+
+  // Every contract with and without a result, in both orders.
+  const vector<string> denomTags = {"C", "D", "H", "S", "N", "NT"};
+  const vector<string> multTags = {"", "x", "xx", "X", "XX", "R"};
+  const vector<string> resultTags =
+    {"-13", "-12", "-11", "-10", "-9", "-8", "-7", "-6", "-5", "-4",
+     "-3", "-2", "-1", "=", "+1", "+2", "+3", "+4", "+5", "+6"};
+  no = 0;
+  for (unsigned level = 1; level <= 7; level++)
+  {
+    for (auto& dt: denomTags)
+    {
+      const string s2 = to_string(level) + dt;
+      for (auto& mt: multTags)
+      {
+        for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+        {
+          const string s4 = s2 + mt + PLAYER_NAMES_SHORT[p];
+          const string s4b = s2 + PLAYER_NAMES_SHORT[p] + mt;
+          REF_CONTRACT_TO_NO[s4] = no;
+          REF_CONTRACT_TO_NO[s4b] = no;
+          REF_CONTRACT_TO_NO[s2 + mt + ":" + PLAYER_NAMES_SHORT[p]] = no;
+
+          const unsigned lo = 7 - level;
+          for (unsigned i = lo; i <= lo+13; i++)
+          {
+            REF_CONTRACT_TO_NO[s4 + resultTags[i]] = no;
+            REF_CONTRACT_TO_NO[s4b + resultTags[i]] = no;
+          }
+          no++;
+        }
+      }
+    }
+  }
+
+  no = 0;
+  for (int s = 0; s <= BRIDGE_TRICKS; s++)
+    for (int h = 0; h <= BRIDGE_TRICKS-s; h++)
+      for (int d = 0; d <= BRIDGE_TRICKS-s-h; d++)
+        REF_DIST_TO_NO[(s << 12) | (h << 8) | (d << 4) |
+          (BRIDGE_TRICKS-s-h-d)] = no++;
+
+  const vector<string> labels =
+    {"vg", "rs", "pw", "px", "mp", "bn", "qx", "pn", "md", "sv", "mb",
+     "pc", "mc", "pf", "pg", "st", "rh", "ah", "nt"};
+  for (unsigned l = 0; l < labels.size(); l++)
+    REF_LIN_TO_LABEL[labels[l]] = l;
+}
+
+
+static unsigned refLookup(
+  const map<string, unsigned>& table,
+  const string& key,
+  const bool upperFlag)
+{
+  // As in the old suit and LIN label lookups, a miss is tried again
+  // in the other case.
+  auto it = table.find(key);
+  if (it != table.end())
+    return it->second;
+
+  string k = key;
+  for (auto& c: k)
+    c = static_cast<char>(upperFlag ? toupper(c) : tolower(c));
+  it = table.find(k);
+  return (it == table.end() ? 0 : it->second);
+}
+
+
+static void printRow(
+  const string& name,
+  const double refTime,
+  const double tableTime,
+  const double n)
+{
+  cout << setw(32) << left << name << right <<
+    setw(8) << 1.e9 * refTime / n <<
+    setw(8) << 1.e9 * tableTime / n <<
+    setw(8) << refTime / tableTime << "\n";
+}
+
+
+static void makeDeal(
+  mt19937& rng,
+  BenchDeal& bd)
+{
+  vector<unsigned> deck(52);
+  for (unsigned c = 0; c < 52; c++)
+    deck[c] = c;
+  shuffle(deck.begin(), deck.end(), rng);
+
+  // DDS encoding: players N, E, S, W and suits S, H, D, C, with
+  // the bit for rank r (2 .. 14) at position r.
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+      bd.holding[p][s] = 0;
+
+  for (unsigned c = 0; c < 52; c++)
+    bd.holding[c / 13][deck[c] / 13] |= (1u << (deck[c] % 13 + 2));
+
+  bd.pbn = "N:";
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+  {
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+    {
+      for (unsigned r = 13; r-- > 0; )
+        if (bd.holding[p][s] & (1u << (r+2)))
+          bd.pbn += BENCH_RANKS[r];
+      if (s < 3)
+        bd.pbn += ".";
+    }
+    if (p < 3)
+      bd.pbn += " ";
+  }
+
+  bd.suits.clear();
+  size_t start = 2;
+  for (size_t i = 2; i <= bd.pbn.length(); i++)
+  {
+    if (i == bd.pbn.length() || bd.pbn[i] == '.' || bd.pbn[i] == ' ')
+    {
+      bd.suits.push_back(bd.pbn.substr(start, i-start));
+      start = i+1;
+    }
+  }
+
+  // A legal play in notrump with South as declarer.  Each player
+  // plays the lowest card of the suit led, or else the lowest card
+  // of the first suit held.
+  unsigned hand[BRIDGE_PLAYERS][BRIDGE_SUITS];
+  for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+      hand[p][s] = bd.holding[p][s];
+
+  bd.plays.clear();
+  unsigned leader = BRIDGE_WEST;
+  for (unsigned t = 0; t < BRIDGE_TRICKS; t++)
+  {
+    unsigned suitLed = BRIDGE_SUITS;
+    unsigned winner = leader, winRank = 0;
+    for (unsigned c = 0; c < BRIDGE_PLAYERS; c++)
+    {
+      const unsigned p = (leader + c) % 4;
+      unsigned s = suitLed;
+      if (s == BRIDGE_SUITS || hand[p][s] == 0)
+      {
+        s = 0;
+        while (hand[p][s] == 0)
+          s++;
+      }
+
+      unsigned r = 2;
+      while ((hand[p][s] & (1u << r)) == 0)
+        r++;
+      hand[p][s] ^= (1u << r);
+
+      if (c == 0)
+        suitLed = s;
+      if (s == suitLed && r > winRank)
+      {
+        winner = p;
+        winRank = r;
+      }
+
+      bd.plays.push_back(string(1, BENCH_SUITS[s]) + BENCH_RANKS[r-2]);
+    }
+    leader = winner;
+  }
+}
+
+
+static void timeSuits(
+  const vector<BenchDeal>& deals,
+  const unsigned reps)
+{
+  Timer timer;
+  timer.start();
+  for (unsigned r = 0; r < reps; r++)
+    for (auto& bd: deals)
+      for (auto& suit: bd.suits)
+        sink += refLookup(REF_SUIT_TO_HOLDING, suit, true);
+  timer.stop();
+  const double refTime = timer.seconds();
+
+  Deal deal;
+  timer.reset();
+  timer.start();
+  for (unsigned r = 0; r < reps; r++)
+  {
+    for (auto& bd: deals)
+    {
+      deal.reset();
+      deal.set(bd.pbn, BRIDGE_FORMAT_PBN);
+    }
+  }
+  timer.stop();
+
+  printRow("suitToHolding (Deal::set)", refTime, timer.seconds(),
+    16. * reps * deals.size());
+}
+
+
+static void timePlays(
+  const vector<BenchDeal>& deals,
+  const unsigned reps)
+{
+  Timer timer;
+  timer.start();
+  for (unsigned r = 0; r < reps; r++)
+    for (auto& bd: deals)
+      for (auto& card: bd.plays)
+        sink += refLookup(REF_CARD_TO_NO, card, true);
+  timer.stop();
+  const double refTime = timer.seconds();
+
+  Contract contract;
+  contract.setContract(BRIDGE_VUL_NONE, "3NTS");
+
+  Play play;
+  timer.reset();
+  timer.start();
+  for (unsigned r = 0; r < reps; r++)
+  {
+    for (auto& bd: deals)
+    {
+      play.reset();
+      play.setContract(contract);
+      play.setHoldingDDS(bd.holding);
+      for (auto& card: bd.plays)
+        play.addPlay(card);
+    }
+  }
+  timer.stop();
+  sink += play.getTricks();
+
+  printRow("Play::addPlay", refTime, timer.seconds(),
+    52. * reps * deals.size());
+}
+
+
+static void timeCalls(const unsigned reps)
+{
+  const vector<string> calls =
+    {"1C", "1H", "1S", "2C", "2NT", "P", "3N", "Pass", "PASS", "P"};
+
+  Timer timer;
+  timer.start();
+  for (unsigned r = 0; r < reps * NUM_DEALS; r++)
+    for (auto& call: calls)
+      sink += refLookup(REF_CALL_TO_NO, call, true);
+  timer.stop();
+  const double refTime = timer.seconds();
+
+  Auction auction;
+  timer.reset();
+  timer.start();
+  for (unsigned r = 0; r < reps * NUM_DEALS; r++)
+  {
+    auction.reset();
+    for (auto& call: calls)
+      auction.addCall(call);
+  }
+  timer.stop();
+  sink += auction.length();
+
+  printRow("Auction::addCall", refTime, timer.seconds(),
+    static_cast<double>(calls.size()) * reps * NUM_DEALS);
+}
+
+
+static void timeContracts(const unsigned reps)
+{
+  const vector<string> texts =
+    {"4HE", "3NTS=", "4HxE-1", "6SXXN+1", "1NTS", "5CWx", "7NN-3", "2DW"};
+
+  Timer timer;
+  timer.start();
+  for (unsigned r = 0; r < reps * NUM_DEALS; r++)
+    for (auto& text: texts)
+      sink += refLookup(REF_CONTRACT_TO_NO, text, true);
+  timer.stop();
+  const double refTime = timer.seconds();
+
+  Contract contract;
+  timer.reset();
+  timer.start();
+  for (unsigned r = 0; r < reps * NUM_DEALS; r++)
+  {
+    for (auto& text: texts)
+    {
+      contract.reset();
+      contract.setContract(text, BRIDGE_FORMAT_LIN);
+    }
+  }
+  timer.stop();
+  sink += contract.isSet();
+
+  printRow("setContractByString (LIN)", refTime, timer.seconds(),
+    static_cast<double>(texts.size()) * reps * NUM_DEALS);
+}
+
+
+static void timeValuations(
+  const vector<BenchDeal>& deals,
+  const unsigned reps)
+{
+  vector<int> keys;
+  for (auto& bd: deals)
+  {
+    for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+    {
+      int key = 0;
+      for (unsigned s = 0; s < BRIDGE_SUITS; s++)
+      {
+        int len = 0;
+        for (unsigned h = bd.holding[p][s]; h; h &= h-1)
+          len++;
+        key = (key << 4) | len;
+      }
+      keys.push_back(key);
+    }
+  }
+
+  Timer timer;
+  timer.start();
+  for (unsigned r = 0; r < reps; r++)
+    for (auto key: keys)
+      sink += REF_DIST_TO_NO.find(key)->second;
+  timer.stop();
+  const double refTime = timer.seconds();
+
+  Valuation valuation;
+  timer.reset();
+  timer.start();
+  for (unsigned r = 0; r < reps; r++)
+  {
+    for (auto& bd: deals)
+    {
+      for (unsigned p = 0; p < BRIDGE_PLAYERS; p++)
+      {
+        valuation.reset();
+        valuation.evaluate(bd.holding[p]);
+      }
+    }
+  }
+  timer.stop();
+  sink += static_cast<unsigned>(valuation.handDist());
+
+  printRow("Valuation lookup (evaluate)", refTime, timer.seconds(),
+    4. * reps * deals.size());
+}
+
+
+static void timeLabels(const unsigned reps)
+{
+  const vector<string> labels =
+    {"pn", "st", "md", "sv", "mb", "an", "pc", "pg", "mc", "qx",
+     "rh", "ah", "nt", "vg", "rs", "PC", "MB", "xx", "p", "pcs"};
+
+  Timer timer;
+  timer.start();
+  for (unsigned r = 0; r < reps * NUM_DEALS; r++)
+    for (auto& label: labels)
+      sink += refLookup(REF_LIN_TO_LABEL, label, false);
+  timer.stop();
+  const double refTime = timer.seconds();
+
+  timer.reset();
+  timer.start();
+  for (unsigned r = 0; r < reps * NUM_DEALS; r++)
+    for (auto& label: labels)
+      sink += lookupLINLabel(label);
+  timer.stop();
+
+  printRow("lookupLINLabel", refTime, timer.seconds(),
+    static_cast<double>(labels.size()) * reps * NUM_DEALS);
+}
+
+
+int main(int argc, char * argv[])
+{
+  if (argc > 2)
+  {
+    cout << "Usage: " << argv[0] << " [reps]\n";
+    exit(0);
+  }
+
+  const unsigned reps = (argc == 2 ?
+    static_cast<unsigned>(atoi(argv[1])) : 100);
+
+  setTables();
+  setRefTables();
+
+  mt19937 rng(1);
+  vector<BenchDeal> deals(NUM_DEALS);
+  for (auto& bd: deals)
+    makeDeal(rng, bd);
+
+  cout << setw(32) << left << "ns per token" << right <<
+    setw(8) << "map" << setw(8) << "table" << setw(8) << "ratio" << "\n";
+  cout << fixed << setprecision(1);
+
+  try
+  {
+    timeSuits(deals, reps);
+    timePlays(deals, reps);
+    timeCalls(reps);
+    timeContracts(reps);
+    timeValuations(deals, reps);
+    timeLabels(reps);
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(cout);
+    exit(1);
+  }
+
+  if (sink == 0)
+    cout << "\n";
+}
+
@@ -0,0 +1,102 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Times dispatchWrite for each text output format on one input file.
+//
+// Usage: benchWrite file format [reps]
+//
+// The format is the input format by name (LIN, LIN-RP, PBN, ...).
+// The file is read once, and then the whole group is written to a
+// string in every text format.  The time is the best of the
+// repetitions.  Nothing is written to disk.
+
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "Group.h"
+#include "Buffer.h"
+#include "RefLines.h"
+#include "Timer.h"
+#include "dispatch.h"
+#include "funcRead.h"
+#include "funcWrite.h"
+
+using namespace std;
+
+
+static bool formatByName(
+  const string& name,
+  Format& format)
+{
+  for (unsigned f = 0; f < BRIDGE_FORMAT_SIZE; f++)
+  {
+    if (name == FORMAT_NAMES[f])
+    {
+      format = static_cast<Format>(f);
+      return true;
+    }
+  }
+  return false;
+}
+
+
+int main(int argc, char * argv[])
+{
+  Format format;
+  if (argc < 3 || argc > 4 || ! formatByName(argv[2], format))
+  {
+    cout << "Usage: " << argv[0] << " file format [reps]\n";
+    exit(0);
+  }
+
+  const int reps = (argc == 4 ? atoi(argv[3]) : 10);
+
+  setTables();
+
+  Options options = Options();
+  options.splitPieces = 1;
+
+  Group group;
+  RefLines refLines;
+  Buffer buffer;
+  if (! buffer.read(argv[1], format, refLines))
+  {
+    cout << "Could not read " << argv[1] << "\n";
+    exit(1);
+  }
+
+  group.setName(argv[1]);
+  BoardOrder order = ORDER_GENERAL;
+  if (! dispatchReadBuffer(format, options, buffer, group, order, cout))
+    exit(1);
+
+  string text;
+  for (unsigned f = BRIDGE_FORMAT_LIN; f <= BRIDGE_FORMAT_REC; f++)
+  {
+    const Format formatOut = static_cast<Format>(f);
+    double best = 1.e9;
+    for (int r = 0; r < reps; r++)
+    {
+      Timer timer;
+      timer.start();
+      dispatchWrite("", formatOut, order, group, false, text, cout);
+      timer.stop();
+      if (timer.seconds() < best)
+        best = timer.seconds();
+    }
+
+    cout << setw(8) << left << FORMAT_NAMES[f] << right <<
+      fixed << setprecision(2) << setw(8) << 1000. * best << " ms" <<
+      setw(10) << text.length() << " bytes" <<
+      setprecision(1) << setw(9) <<
+      (best > 0. ? text.length() / best / 1.e6 : 0.) << " MB/s\n";
+  }
+}
+
@@ -0,0 +1,47 @@
+/*
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Macros to fill a constant table at compile time from a constexpr
+// function of the index, e.g.
+//
+//   static constexpr unsigned TABLE[256] = { CTABLE_256(f, 0) };
+//
+// which expands to f(0), f(1), ..., f(255).  C++11 has no way to
+// loop in a constant initializer, so the expansion is spelled out.
+
+#ifndef BRIDGE_CTABLE_H
+#define BRIDGE_CTABLE_H
+
+#define CTABLE_1(f, i) f(i)
+
+#define CTABLE_4(f, i) \
+  f(i), f((i)+1), f((i)+2), f((i)+3)
+
+#define CTABLE_16(f, i) \
+  CTABLE_4(f, i), CTABLE_4(f, (i)+4), \
+  CTABLE_4(f, (i)+8), CTABLE_4(f, (i)+12)
+
+#define CTABLE_32(f, i) \
+  CTABLE_16(f, i), CTABLE_16(f, (i)+16)
+
+#define CTABLE_64(f, i) \
+  CTABLE_16(f, i), CTABLE_16(f, (i)+16), \
+  CTABLE_16(f, (i)+32), CTABLE_16(f, (i)+48)
+
+#define CTABLE_128(f, i) \
+  CTABLE_64(f, i), CTABLE_64(f, (i)+64)
+
+#define CTABLE_256(f, i) \
+  CTABLE_64(f, i), CTABLE_64(f, (i)+64), \
+  CTABLE_64(f, (i)+128), CTABLE_64(f, (i)+192)
+
+#define CTABLE_512(f, i) \
+  CTABLE_256(f, i), CTABLE_256(f, (i)+256)
+
+#endif
+
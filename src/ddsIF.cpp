@@ -6,9 +6,17 @@
    See LICENSE and README.
 */
 
+// With a single worker thread, the batch functions of DDS spread
+// the work over all the DDS threads internally.  With several
+// worker threads, each worker owns a DDS thread context and solves
+// its own deals in that context, so the workers solve concurrently.
+
 
 #include <iostream>
+#include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <cstring>
 
 #if defined(_WIN32) && defined(__MINGW32__)
   #include "mingw.thread.h"
@@ -19,13 +27,57 @@
 #endif
 
 #include "ddsIF.h"
+#include "bconst.h"
 #include "Bexcept.h"
 
 static mutex mtx;
+static mutex mtxContext[MAXNOOFCORES];
+
+static bool batchFlag = true;
+static unsigned numContexts = 1;
+static thread_local unsigned contextNo = 0;
+
+static atomic<unsigned> countTables(0);
+static atomic<unsigned> countTraces(0);
 
 using namespace std;
 
 
+void setDDThreads(const unsigned numThreads)
+{
+  batchFlag = true;
+  numContexts = 1;
+
+  if (numThreads <= 1)
+    return;
+
+  SetMaxThreads(static_cast<int>(numThreads));
+
+  DDSInfo info;
+  GetDDSInfo(&info);
+  if (info.noOfThreads <= 1)
+    return;
+
+  numContexts = Min(static_cast<unsigned>(info.noOfThreads), 
+    static_cast<unsigned>(MAXNOOFCORES));
+  batchFlag = false;
+}
+
+
+void setDDThreadNumber(const unsigned thrNo)
+{
+  contextNo = thrNo % numContexts;
+}
+
+
+static mutex& lockDD()
+{
+  mutex& m = (batchFlag ? mtx : mtxContext[contextNo]);
+  m.lock();
+  return m;
+}
+
+
 void errorDD(const int res)
 {
   char line[80];
@@ -42,9 +94,10 @@ unsigned tricksDD(
   RunningDD& running)
 {
   futureTricks fut;
-  mtx.lock();
-  int res = SolveBoard(running.dl, -1, 1, 1, &fut, 0);
-  mtx.unlock();
+  mutex& m = lockDD();
+  int res = SolveBoard(running.dl, -1, 1, 1, &fut, 
+    static_cast<int>(contextNo));
+  m.unlock();
 
   if (res != RETURN_NO_FAULT)
     errorDD(res);
@@ -54,18 +107,62 @@ unsigned tricksDD(
 }
 
 
+static int tableauContext(
+  const ddTableDealPBN& tableDeal,
+  ddTableResults& tableRes)
+{
+  dealPBN dl;
+  for (unsigned i = 0; i < 3; i++)
+  {
+    dl.currentTrickSuit[i] = 0;
+    dl.currentTrickRank[i] = 0;
+  }
+  strcpy(dl.remainCards, tableDeal.cards);
+
+  futureTricks fut;
+  for (int strain = 0; strain < DDS_STRAINS; strain++)
+  {
+    dl.trump = strain;
+    for (int hand = 0; hand < DDS_HANDS; hand++)
+    {
+      // The hand to the left of declarer leads.
+      dl.first = (hand + 1) % DDS_HANDS;
+      const int res = SolveBoardPBN(dl, -1, 1, 1, &fut, 
+        static_cast<int>(contextNo));
+      if (res != RETURN_NO_FAULT)
+        return res;
+
+      tableRes.resTable[strain][hand] = BRIDGE_TRICKS - fut.score[0];
+    }
+  }
+  return RETURN_NO_FAULT;
+}
+
+
 void tableauDD(
   ddTableDealsPBN * tablePBN,
   ddTablesRes * resDDS)
 {
-  int trumpFilter[5] = {0, 0, 0, 0, 0};
-
-  mtx.lock();
-  int res = CalcAllTablesPBN(tablePBN, -1, trumpFilter, resDDS, nullptr);
-  mtx.unlock();
+  int res = RETURN_NO_FAULT;
+  mutex& m = lockDD();
+  if (batchFlag)
+  {
+    int trumpFilter[5] = {0, 0, 0, 0, 0};
+    res = CalcAllTablesPBN(tablePBN, -1, trumpFilter, resDDS, nullptr);
+  }
+  else
+  {
+    resDDS->noOfBoards = DDS_STRAINS * tablePBN->noOfTables;
+    for (int i = 0; i < tablePBN->noOfTables && 
+        res == RETURN_NO_FAULT; i++)
+      res = tableauContext(tablePBN->deals[i], resDDS->results[i]);
+  }
+  m.unlock();
 
   if (res != RETURN_NO_FAULT)
     errorDD(res);
+
+  countTables += static_cast<unsigned>(tablePBN->noOfTables);
 }
 
 
@@ -74,11 +171,54 @@ void traceDD(
   playTracesPBN * plpPBN,
   solvedPlays * resDDS)
 {
-  mtx.lock();
-  int res = AnalyseAllPlaysPBN(bopPBN, plpPBN, resDDS, 0);
-  mtx.unlock();
+  int res = RETURN_NO_FAULT;
+  mutex& m = lockDD();
+  if (batchFlag)
+    res = AnalyseAllPlaysPBN(bopPBN, plpPBN, resDDS, 0);
+  else
+  {
+    resDDS->noOfBoards = bopPBN->noOfBoards;
+    for (int i = 0; i < bopPBN->noOfBoards && 
+        res == RETURN_NO_FAULT; i++)
+      res = AnalysePlayPBN(bopPBN->deals[i], plpPBN->plays[i], 
+        &resDDS->solved[i], static_cast<int>(contextNo));
+  }
+  m.unlock();
 
   if (res != RETURN_NO_FAULT)
     errorDD(res);
+
+  countTraces += static_cast<unsigned>(bopPBN->noOfBoards);
+}
+
+
+string strDDThroughput(const double seconds)
+{
+  if (countTables == 0 && countTraces == 0)
+    return "";
+
+  stringstream ss;
+  ss << "DD solver: " << 
+    (batchFlag ? "batch" : STR(numContexts) + " thread contexts") << "\n";
+  
+  if (countTables > 0)
+  {
+    ss << "DD tables solved: " << countTables;
+    if (seconds > 0.)
+      ss << " (" << fixed << setprecision(1) << 
+        countTables / seconds << " per second)";
+    ss << "\n";
+  }
+
+  if (countTraces > 0)
+  {
+    ss << "DD traces solved: " << countTraces;
+    if (seconds > 0.)
+      ss << " (" << fixed << setprecision(1) << 
+        countTraces / seconds << " per second)";
+    ss << "\n";
+  }
+
+  return ss.str();
 }
 
@@ -9,8 +9,12 @@
 #ifndef BRIDGE_DDSIF_H
 #define BRIDGE_DDSIF_H
 
+#include <string>
+
 #include "dll.h"
 
+using namespace std;
+
 
 struct RunningDD
 {
@@ -20,6 +24,10 @@ struct RunningDD
   deal dl;
 };
 
+void setDDThreads(const unsigned numThreads);
+
+void setDDThreadNumber(const unsigned thrNo);
+
 unsigned tricksDD(
   RunningDD& running);
 
@@ -32,4 +40,6 @@ void traceDD(
   playTracesPBN * plpPBN,
   solvedPlays * resDDS);
 
+string strDDThroughput(const double seconds);
+
 #endif
@@ -11,12 +11,23 @@
 #include <sstream>
 #include <fstream>
 
+#include "Arena.h"
 #include "Group.h"
+#include "Deal.h"
+#include "Auction.h"
+#include "Contract.h"
+#include "Play.h"
+#include "Players.h"
+#include "Valuation.h"
+#include "RefComment.h"
+#include "Pipeline.h"
 #include "dispatch.h"
 #include "validate.h"
 #include "Files.h"
+#include "DDBatch.h"
 #include "AllStats.h"
 #include "RefLines.h"
+#include "ddsIF.h"
 
 #include "funcCompare.h"
 #include "funcDD.h"
@@ -35,15 +46,305 @@
 
 void setTables()
 {
+  // The model tables are filled once here, before any threads start.
+  Deal::setTables();
+  Auction::setTables();
+  Contract::setTables();
+  Play::setTables();
+  Players::setTables();
+  Valuation::setTables();
+  RefComment::setTables();
+
   setReadTables();
   setWriteTables();
   setValidateTables();
 }
 
 
+static bool dispatchReadStage(
+  const FileTask& task,
+  const Options& options,
+  Group& group,
+  RefLines& refLines,
+  AllStats& allStats,
+  ostream& flog)
+{
+  refLines.reset();
+  allStats.timers.start(BRIDGE_TIMER_READ, task.formatInput);
+  bool b = dispatchReadFile(task.fileInput, task.formatInput, 
+    options, group, refLines, flog);
+  allStats.timers.stop(BRIDGE_TIMER_READ, task.formatInput);
+  if (! b)
+  {
+    flog << "Failed to read " << task.fileInput << endl;
+    return false;
+  }
+
+  if (options.quoteFlag)
+  {
+    if (options.verboseIO)
+      flog << "Ref file for " << task.fileInput << endl;
+  
+    allStats.timers.start(BRIDGE_TIMER_REF_STATS, task.formatInput);
+    dispatchRefStats(task.fileInput, task.formatInput, 
+      refLines, allStats.refstats, flog);
+    allStats.timers.stop(BRIDGE_TIMER_REF_STATS, task.formatInput);
+  }
+
+  return ! refLines.skip();
+}
+
+
+static void dispatchAnalyzeStage(
+  const FileTask& task,
+  const Options& options,
+  Files& files,
+  DDBatch& ddBatch,
+  Group& group,
+  RefLines& refLines,
+  AllStats& allStats,
+  ostream& flog)
+{
+  if (options.playersFlag)
+    dispatchPlayersValidate(group, flog);
+
+  if (options.solveFlag)
+  {
+    allStats.timers.start(BRIDGE_TIMER_DD, task.formatInput);
+    dispatchDD(group, files, ddBatch, task.fileInput, flog);
+    allStats.timers.stop(BRIDGE_TIMER_DD, task.formatInput);
+  }
+
+  if (options.traceFlag)
+  {
+    allStats.timers.start(BRIDGE_TIMER_TRACE, task.formatInput);
+    dispatchTrace(group, files, ddBatch, task.fileInput, flog);
+    allStats.timers.stop(BRIDGE_TIMER_TRACE, task.formatInput);
+  }
+
+  if (options.statsFlag)
+  {
+    if (options.verboseIO)
+      flog << "Input " << task.fileInput << endl;
+  
+    allStats.timers.start(BRIDGE_TIMER_STATS, task.formatInput);
+    dispatchTextStats(task, group, allStats.tstats, flog);
+    allStats.timers.stop(BRIDGE_TIMER_STATS, task.formatInput);
+  }
+
+  if (options.valuationFlag)
+  {
+    if (options.verboseIO)
+      flog << "Valuation " << task.fileInput << endl;
+
+    allStats.timers.start(BRIDGE_TIMER_VALUE, task.formatInput);
+    dispatchValuation(group, flog);
+    allStats.timers.stop(BRIDGE_TIMER_VALUE, task.formatInput);
+  }
+
+  if (options.equalFlag)
+  {
+    if (options.verboseIO)
+      flog << "Hand hashes " << task.fileInput << endl;
+
+    dispatchDupl(group, refLines, allStats.duplstats, flog);
+  }
+
+  if (options.freezeFlag)
+  {
+    const unsigned firstNo = files.freezeGroup(group);
+
+    if (options.compareFlag)
+    {
+      if (options.verboseIO)
+        flog << "Comparing frozen " << task.fileInput << endl;
+
+      allStats.timers.start(BRIDGE_TIMER_COMPARE, BRIDGE_FORMAT_BDB);
+      dispatchCompareFrozen(task.fileInput, group, files, firstNo,
+        allStats.cstats, flog);
+      allStats.timers.stop(BRIDGE_TIMER_COMPARE, BRIDGE_FORMAT_BDB);
+    }
+  }
+}
+
+
+static bool keepsText(
+  const FileTask& task,
+  const FileOutputTask& t,
+  const Options& options,
+  const RefLines& refLines)
+{
+  // The written text is only needed again for validation and for
+  // comparison.  Otherwise the output can be streamed to its file.
+  return ((t.refFlag && refLines.validate()) ||
+    (options.compareFlag && task.formatInput == t.formatOutput));
+}
+
+
+static void dispatchWriteStage(
+  const FileTask& task,
+  const FileOutputTask& t,
+  const Options& options,
+  Group& group,
+  RefLines& refLines,
+  string& text,
+  AllStats& allStats,
+  ostream& flog)
+{
+  if (options.verboseIO && t.fileOutput != "")
+    flog << "Output " << t.fileOutput << endl;
+
+  allStats.timers.start(BRIDGE_TIMER_WRITE, t.formatOutput);
+  dispatchWrite(t.fileOutput, t.formatOutput, refLines.order(), 
+    group, ! keepsText(task, t, options, refLines), text, flog);
+  allStats.timers.stop(BRIDGE_TIMER_WRITE, t.formatOutput);
+}
+
+
+static void dispatchWriteAllStage(
+  const FileTask& task,
+  const Options& options,
+  Group& group,
+  RefLines& refLines,
+  vector<string>& texts,
+  AllStats& allStats,
+  ostream& flog)
+{
+  if (options.verboseIO)
+  {
+    for (auto &t: task.taskList)
+      if (t.fileOutput != "")
+        flog << "Output " << t.fileOutput << endl;
+  }
+
+  // The formats are written together, so the time is all counted
+  // under the first one.
+  vector<bool> streamFlags;
+  for (auto &t: task.taskList)
+    streamFlags.push_back(! keepsText(task, t, options, refLines));
+
+  const Format format = task.taskList.front().formatOutput;
+  allStats.timers.start(BRIDGE_TIMER_WRITE, format);
+  dispatchWriteAll(task.taskList, refLines.order(), group,
+    streamFlags, options.multiWrite, texts, flog);
+  allStats.timers.stop(BRIDGE_TIMER_WRITE, format);
+}
+
+
+static void dispatchValidateStage(
+  const FileTask& task,
+  const FileOutputTask& t,
+  const Options& options,
+  Group& group,
+  RefLines& refLines,
+  string& text,
+  AllStats& allStats,
+  ostream& flog)
+{
+  if (t.refFlag && refLines.validate())
+  {
+    if (options.verboseIO)
+      flog << "Validating " << t.fileOutput <<
+          " against " << t.fileRef << endl;
+
+    allStats.timers.start(BRIDGE_TIMER_VALIDATE, t.formatOutput);
+    dispatchValidate(task, t, options, text, allStats.vstats, flog);
+    allStats.timers.stop(BRIDGE_TIMER_VALIDATE, t.formatOutput);
+  }
+
+  if (options.compareFlag && task.formatInput == t.formatOutput)
+  {
+    if (options.verboseIO)
+      flog << "Comparing " << t.fileOutput <<
+          " against " << task.fileInput << endl;
+
+    allStats.timers.start(BRIDGE_TIMER_COMPARE, t.formatOutput);
+    dispatchCompare(task.fileInput, task.formatInput, options,
+      text, group, allStats.cstats, flog);
+    allStats.timers.stop(BRIDGE_TIMER_COMPARE, t.formatOutput);
+  }
+
+  if (task.removeOutputFlag)
+    remove(t.fileOutput.c_str());
+}
+
+
+static void dispatchDigestStage(
+  const FileTask& task,
+  const Options& options,
+  AllStats& allStats,
+  ostream& flog)
+{
+  if (options.verboseIO)
+    flog << "Digest input " << task.fileInput << endl;
+
+  allStats.timers.start(BRIDGE_TIMER_DIGEST, task.formatInput);
+  dispatchDigest(task, options, flog);
+  allStats.timers.stop(BRIDGE_TIMER_DIGEST, task.formatInput);
+}
+
+
+static bool dispatchFile(
+  const FileTask& task,
+  const Options& options,
+  Files& files,
+  DDBatch& ddBatch,
+  RefLines& refLines,
+  string& text,
+  Arena& arena,
+  AllStats& allStats,
+  ostream& flog)
+{
+  // The group goes before the arena is reset.
+  ArenaScope scope(arena);
+  Group group;
+
+  if (! options.fileDigest.setFlag && ! options.dirDigest.setFlag)
+  {
+    if (! dispatchReadStage(task, options, group, refLines, 
+        allStats, flog))
+      return refLines.skip();
+
+    dispatchAnalyzeStage(task, options, files, ddBatch, group,
+      refLines, allStats, flog);
+
+    if (options.multiWrite > 0 && task.taskList.size() > 1)
+    {
+      vector<string> texts;
+      dispatchWriteAllStage(task, options, group, refLines, texts,
+        allStats, flog);
+      for (unsigned i = 0; i < task.taskList.size(); i++)
+        dispatchValidateStage(task, task.taskList[i], options, group,
+          refLines, texts[i], allStats, flog);
+    }
+    else
+    {
+      for (auto &t: task.taskList)
+      {
+        dispatchWriteStage(task, t, options, group, refLines, text,
+          allStats, flog);
+        dispatchValidateStage(task, t, options, group, refLines, text,
+          allStats, flog);
+      }
+    }
+  }
+  else
+    dispatchDigestStage(task, options, allStats, flog);
+
+  if (options.tableIMPFlag)
+    dispatchIMPSheet(group, flog);
+
+  if (options.verboseIO)
+    flog << "Arena " << task.fileInput << ": " << arena.count() <<
+      " allocations, " << arena.bytes() << " bytes" << endl;
+  return true;
+}
+
+
 void dispatch(
   const int thrNo,
   Files& files,
+  DDBatch& ddBatch,
   const Options& options,
   AllStats& allStats)
 {
@@ -57,129 +358,162 @@ void dispatch(
   text.reserve(100000);
 
   RefLines refLines;
+  Arena arena;
+
+  setDDThreadNumber(static_cast<unsigned>(thrNo));
+
+  // In incremental mode each file gets its own stats, so that they
+  // can be kept in the manifest.
+  const bool incrFlag = files.incremental();
+  AllStats * fileStats = (incrFlag ? new AllStats : nullptr);
+  string hash, stats;
 
-  while (files.next(task))
+  while (files.next(static_cast<unsigned>(thrNo), task))
   {
     if (options.verboseIO)
       flog << "Input " << task.fileInput << endl;
 
-    Group group;
-
-    if (options.fileDigest.setFlag || options.dirDigest.setFlag)
-      goto DIGEST;
-
-    refLines.reset();
-    allStats.timers.start(BRIDGE_TIMER_READ, task.formatInput);
-    bool b = dispatchReadFile(task.fileInput, task.formatInput, 
-      options, group, refLines, flog);
-    allStats.timers.stop(BRIDGE_TIMER_READ, task.formatInput);
-    if (! b)
+    if (! incrFlag)
     {
-      flog << "Failed to read " << task.fileInput << endl;
+      dispatchFile(task, options, files, ddBatch, refLines, text,
+        arena, allStats, flog);
       continue;
     }
 
-    if (options.quoteFlag)
+    hash = files.hashTask(task);
+    if (files.haveTask(task, hash, stats))
     {
       if (options.verboseIO)
-        flog << "Ref file for " << task.fileInput << endl;
-    
-      allStats.timers.start(BRIDGE_TIMER_REF_STATS, task.formatInput);
-      dispatchRefStats(task.fileInput, task.formatInput, 
-        refLines, allStats.refstats, flog);
-      allStats.timers.stop(BRIDGE_TIMER_REF_STATS, task.formatInput);
-    }
+        flog << "Unchanged " << task.fileInput << endl;
 
-    if (refLines.skip())
+      istringstream iss(stats);
+      deserializeStats(allStats, iss);
       continue;
+    }
 
-    if (options.playersFlag)
-      dispatchPlayersValidate(group, flog);
+    resetStats(* fileStats);
+    const bool b = dispatchFile(task, options, files, ddBatch, 
+      refLines, text, arena, * fileStats, flog);
 
-    if (options.solveFlag)
-      dispatchDD(group, files, task.fileInput, flog);
+    ostringstream oss;
+    serializeStats(* fileStats, oss);
+    stats = oss.str();
 
-    if (options.traceFlag)
-      dispatchTrace(group, files, task.fileInput, flog);
+    // A file that could not be read is tried again next time.
+    if (b)
+      files.addTask(task, hash, stats);
 
-    if (options.statsFlag)
-    {
-      if (options.verboseIO)
-        flog << "Input " << task.fileInput << endl;
-    
-      allStats.timers.start(BRIDGE_TIMER_STATS, task.formatInput);
-      dispatchTextStats(task, group, allStats.tstats, flog);
-      allStats.timers.stop(BRIDGE_TIMER_STATS, task.formatInput);
-    }
+    istringstream iss(stats);
+    deserializeStats(allStats, iss);
+    allStats.timers += fileStats->timers;
+  }
 
-    if (options.valuationFlag)
-    {
-      if (options.verboseIO)
-        flog << "Valuation " << task.fileInput << endl;
+  delete fileStats;
+  ddBatch.stopWorker();
+}
 
-      allStats.timers.start(BRIDGE_TIMER_VALUE, task.formatInput);
-      dispatchValuation(group, flog);
-      allStats.timers.stop(BRIDGE_TIMER_VALUE, task.formatInput);
-    }
 
-    if (options.equalFlag)
-    {
-      if (options.verboseIO)
-        flog << "Hand hashes " << task.fileInput << endl;
+void dispatchStage(
+  const PipeStage stage,
+  const int thrNo,
+  const unsigned stageThrNo,
+  Files& files,
+  DDBatch& ddBatch,
+  Pipeline& pipeline,
+  const Options& options,
+  AllStats& allStats)
+{
+  ofstream freal;
+  if (options.fileLog.setFlag)
+    freal.open(options.fileLog.name + (thrNo == 0 ? "" : STR(thrNo)));
+  ostream& flog = (options.fileLog.setFlag ? freal : cout);
 
-      dispatchDupl(group, refLines, allStats.duplstats, flog);
-    }
+  if (stage == BRIDGE_STAGE_ANALYZE)
+    setDDThreadNumber(stageThrNo);
 
-    for (auto &t: task.taskList)
+  const bool digestFlag = 
+    (options.fileDigest.setFlag || options.dirDigest.setFlag);
+
+  allStats.timers.setStage(stage);
+  PipeItem * item = nullptr;
+
+  while (true)
+  {
+    if (stage == BRIDGE_STAGE_READ)
     {
-      if (options.verboseIO && t.fileOutput != "")
-        flog << "Output " << t.fileOutput << endl;
+      FileTask task;
+      if (! files.next(stageThrNo, task))
+        break;
 
-      allStats.timers.start(BRIDGE_TIMER_WRITE, t.formatOutput);
-      dispatchWrite(t.fileOutput, t.formatOutput, refLines.order(), 
-        group, text, flog);
-      allStats.timers.stop(BRIDGE_TIMER_WRITE, t.formatOutput);
+      if (options.verboseIO)
+        flog << "Input " << task.fileInput << endl;
 
-      if (t.refFlag && refLines.validate())
+      allStats.timers.startStage(stage, BRIDGE_STAGE_BUSY);
+      if (digestFlag)
       {
-        if (options.verboseIO)
-          flog << "Validating " << t.fileOutput <<
-              " against " << t.fileRef << endl;
-
-        allStats.timers.start(BRIDGE_TIMER_VALIDATE, t.formatOutput);
-        dispatchValidate(task, t, options, text, allStats.vstats, flog);
-        allStats.timers.stop(BRIDGE_TIMER_VALIDATE, t.formatOutput);
+        // Digests only need the file list, so they stop here.
+        dispatchDigestStage(task, options, allStats, flog);
+        allStats.timers.stopStage(stage, BRIDGE_STAGE_BUSY);
+        continue;
       }
 
-      if (options.compareFlag && task.formatInput == t.formatOutput)
+      item = new PipeItem;
+      item->task = task;
+      if (! dispatchReadStage(item->task, options, item->group, 
+          item->refLines, allStats, flog))
       {
-        if (options.verboseIO)
-          flog << "Comparing " << t.fileOutput <<
-              " against " << task.fileInput << endl;
-
-        allStats.timers.start(BRIDGE_TIMER_COMPARE, t.formatOutput);
-        dispatchCompare(task.fileInput, task.formatInput, options,
-          text, group, allStats.cstats, flog);
-        allStats.timers.stop(BRIDGE_TIMER_COMPARE, t.formatOutput);
+        delete item;
+        allStats.timers.stopStage(stage, BRIDGE_STAGE_BUSY);
+        continue;
       }
-
-      if (task.removeOutputFlag)
-        remove(t.fileOutput.c_str());
+      allStats.timers.stopStage(stage, BRIDGE_STAGE_BUSY);
     }
-
-    DIGEST:
-    if (options.fileDigest.setFlag || options.dirDigest.setFlag)
+    else
     {
-      if (options.verboseIO)
-        flog << "Digest input " << task.fileInput << endl;
-    
-      allStats.timers.start(BRIDGE_TIMER_DIGEST, task.formatInput);
-      dispatchDigest(task, options, flog);
-      allStats.timers.stop(BRIDGE_TIMER_DIGEST, task.formatInput);
+      if (! pipeline.pop(stage, item, allStats.timers))
+        break;
+
+      allStats.timers.startStage(stage, BRIDGE_STAGE_BUSY);
+      const FileTask& task = item->task;
+
+      if (stage == BRIDGE_STAGE_ANALYZE)
+        dispatchAnalyzeStage(task, options, files, ddBatch, 
+          item->group, item->refLines, allStats, flog);
+      else if (stage == BRIDGE_STAGE_WRITE)
+      {
+        if (options.multiWrite > 0 && task.taskList.size() > 1)
+          dispatchWriteAllStage(task, options, item->group,
+            item->refLines, item->texts, allStats, flog);
+        else
+        {
+          item->texts.resize(task.taskList.size());
+          for (unsigned i = 0; i < task.taskList.size(); i++)
+            dispatchWriteStage(task, task.taskList[i], options,
+              item->group, item->refLines, item->texts[i], allStats,
+              flog);
+        }
+      }
+      else
+      {
+        for (unsigned i = 0; i < task.taskList.size(); i++)
+          dispatchValidateStage(task, task.taskList[i], options, 
+            item->group, item->refLines, item->texts[i], 
+            allStats, flog);
+
+        if (options.tableIMPFlag)
+          dispatchIMPSheet(item->group, flog);
+      }
+      allStats.timers.stopStage(stage, BRIDGE_STAGE_BUSY);
     }
 
-    if (options.tableIMPFlag)
-      dispatchIMPSheet(group, flog);
+    if (stage == BRIDGE_STAGE_VALIDATE)
+      delete item;
+    else
+      pipeline.push(stage, item, allStats.timers);
   }
+
+  pipeline.finish(stage);
+  if (stage == BRIDGE_STAGE_ANALYZE)
+    ddBatch.stopWorker();
 }
 
@@ -10,6 +10,8 @@
 #define BRIDGE_DISPATCH_H
 
 class Files;
+class DDBatch;
+class Pipeline;
 struct AllStats;
 
 using namespace std;
@@ -19,6 +21,17 @@ void setTables();
 void dispatch(
   const int thrNo, 
   Files& files,
+  DDBatch& ddBatch,
+  const Options& options,
+  AllStats& allStats);
+
+void dispatchStage(
+  const PipeStage stage,
+  const int thrNo,
+  const unsigned stageThrNo,
+  Files& files,
+  DDBatch& ddBatch,
+  Pipeline& pipeline,
   const Options& options,
   AllStats& allStats);
 
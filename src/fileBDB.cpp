@@ -0,0 +1,57 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// A BDB file is a string table followed by the Group itself,
+// see BDB.h.  The board order of the original file comes first, 
+// as the writers need it.
+
+
+#include <sstream>
+
+#include "Group.h"
+#include "BDB.h"
+
+#include "fileBDB.h"
+#include "Bexcept.h"
+
+using namespace std;
+
+
+void readBDBGroup(
+  const char * data,
+  const size_t len,
+  Group& group,
+  BoardOrder& order)
+{
+  BDBReader br;
+  br.set(data, len);
+
+  const unsigned u = br.getByte();
+  if (u > ORDER_GENERAL)
+    THROW("Bad board order: " + STR(u));
+  order = static_cast<BoardOrder>(u);
+
+  group.readBDB(br);
+  group.setFormat(BRIDGE_FORMAT_BDB);
+
+  if (! br.done())
+    THROW("Trailing data in BDB file");
+}
+
+
+void writeBDBGroup(
+  string& text,
+  const Group& group,
+  const BoardOrder order)
+{
+  BDBWriter bw;
+  bw.putByte(order);
+  group.writeBDB(bw);
+  bw.finish(text);
+}
+
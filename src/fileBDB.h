@@ -0,0 +1,32 @@
+/* 
+   Part of BridgeData.
+
+   Copyright (C) 2016-17 by Soren Hein.
+
+   See LICENSE and README.
+*/
+
+#ifndef BRIDGE_FILEBDB_H
+#define BRIDGE_FILEBDB_H
+
+#include <string>
+
+#include "bconst.h"
+
+class Group;
+
+using namespace std;
+
+
+void readBDBGroup(
+  const char * data,
+  const size_t len,
+  Group& group,
+  BoardOrder& order);
+
+void writeBDBGroup(
+  string& text,
+  const Group& group,
+  const BoardOrder order);
+
+#endif
@@ -416,12 +416,12 @@ void readEMLChunk(
 }
 
 
+template <Format F>
 void writeEMLBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format)
+  WriteInfo& writeInfo)
 {
   const Instance& instance = board.getInstance(writeInfo.instNo);
 
@@ -430,9 +430,9 @@ void writeEMLBoardLevel(
 
   // Convert deal, auction and play from \n to vectors.
   vector<string> deal, auction, play;
-  str2lines(board.strDeal(BRIDGE_WEST, format), deal);
-  str2lines(instance.strAuction(format), auction);
-  str2lines(instance.strPlay(format), play);
+  str2lines(board.strDeal(BRIDGE_WEST, F), deal);
+  str2lines(instance.strAuction(F), auction);
+  str2lines(instance.strPlay(F), play);
 
   // Height of auction determines dimensions.
   // It seems we leave out the play if that makes the canvas too large.
@@ -451,20 +451,20 @@ void writeEMLBoardLevel(
   if (playFlag)
     canvas.setRectangle(play, alstart, acstart);
 
-  canvas.setLine(segment.strScoring(format), 0, 0);
-  canvas.setLine(instance.strPlayer(BRIDGE_WEST, format), 7, 4);
-  canvas.setLine(instance.strPlayer(BRIDGE_NORTH, format), 1, 16);
-  canvas.setLine(instance.strPlayer(BRIDGE_EAST, format), 7, 27);
-  canvas.setLine(instance.strPlayer(BRIDGE_SOUTH, format), 13, 16);
-  canvas.setLine(instance.strPlayer(BRIDGE_WEST, format), 3, 42);
-  canvas.setLine(instance.strPlayer(BRIDGE_NORTH, format), 3, 51);
-  canvas.setLine(instance.strPlayer(BRIDGE_EAST, format), 3, 60);
-  canvas.setLine(instance.strPlayer(BRIDGE_SOUTH, format), 3, 69);
-  canvas.setLine(segment.strNumber(writeInfo.bno, format), 0, 42);
-
-  canvas.setLine(instance.strDealer(format), 1, 0);
-  canvas.setLine(instance.strVul(format), 2, 0);
-  const string l = instance.strLead(format);
+  canvas.setLine(segment.strScoring(F), 0, 0);
+  canvas.setLine(instance.strPlayer(BRIDGE_WEST, F), 7, 4);
+  canvas.setLine(instance.strPlayer(BRIDGE_NORTH, F), 1, 16);
+  canvas.setLine(instance.strPlayer(BRIDGE_EAST, F), 7, 27);
+  canvas.setLine(instance.strPlayer(BRIDGE_SOUTH, F), 13, 16);
+  canvas.setLine(instance.strPlayer(BRIDGE_WEST, F), 3, 42);
+  canvas.setLine(instance.strPlayer(BRIDGE_NORTH, F), 3, 51);
+  canvas.setLine(instance.strPlayer(BRIDGE_EAST, F), 3, 60);
+  canvas.setLine(instance.strPlayer(BRIDGE_SOUTH, F), 3, 69);
+  canvas.setLine(segment.strNumber(writeInfo.bno, F), 0, 42);
+
+  canvas.setLine(instance.strDealer(F), 1, 0);
+  canvas.setLine(instance.strVul(F), 2, 0);
+  const string l = instance.strLead(F);
   unsigned p;
   if (l == "Opening Lead:")
     p = a+3;
@@ -473,19 +473,19 @@ void writeEMLBoardLevel(
     canvas.setLine(l, a+3, 42);
     p = a+4;
   }
-  canvas.setLine(instance.strResult(format), p, 42);
+  canvas.setLine(instance.strResult(F), p, 42);
 
   string ss;
   if (segment.scoringIsIMPs() && writeInfo.ino == 1)
-    ss = board.strScore(writeInfo.instNo, format);
+    ss = board.strScore(writeInfo.instNo, F);
   else
-    ss = instance.strScore(format);
+    ss = instance.strScore(F);
   canvas.setLine(ss, p+1, 42);
 
   if (auction.size() == 3 && auction[2] == "")
   {
     // Not standard EML: Give the contract.
-    canvas.setLine("Contract: " + instance.strContract(format), p+2, 42);
+    canvas.setLine("Contract: " + instance.strContract(F), p+2, 42);
   }
 
   st += canvas.str() + "\n";
@@ -496,3 +496,6 @@ void writeEMLBoardLevel(
     st += EMLequals + "\n\n";
 }
 
+
+template void writeEMLBoardLevel<BRIDGE_FORMAT_EML>(
+  string&, const Segment&, const Board&, WriteInfo&);
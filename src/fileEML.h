@@ -24,11 +24,11 @@ void readEMLChunk(
   Chunk& chunk,
   bool& newSegFlag);
 
+template <Format F>
 void writeEMLBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format);
+  WriteInfo& writeInfo);
 
 #endif
@@ -8,69 +8,163 @@
 
 
 #include <sstream>
-#include <map>
 
 #include "Segment.h"
 #include "Board.h"
 #include "Buffer.h"
 #include "Chunk.h"
+#include "LINScan.h"
 
 #include "fileLIN.h"
 #include "parse.h"
 #include "Bexcept.h"
+#include "ctable.h"
 
 using namespace std;
 
 
-map<string, Label> LINmap;
+// LIN labels are two letters, so they index a table directly.
+// Entries are BRIDGE_FORMAT_LABELS_SIZE for labels that we ignore,
+// and BIGNUM for labels that do not exist.  The table is fixed at
+// compile time.
 
+static constexpr unsigned LINlabelIndex(
+  const int a,
+  const int b)
+{
+  return 26 * static_cast<unsigned>(a - 'a') +
+    static_cast<unsigned>(b - 'a');
+}
+
+
+static constexpr unsigned LINlabel(const unsigned i)
+{
+  return (
+    i == LINlabelIndex('v', 'g') ? BRIDGE_FORMAT_TITLE :
+    i == LINlabelIndex('r', 's') ? BRIDGE_FORMAT_RESULTS_LIST :
+    i == LINlabelIndex('p', 'w') ? BRIDGE_FORMAT_PLAYERS_LIST :
+    i == LINlabelIndex('p', 'x') ? BRIDGE_FORMAT_PLAYERS_HEADER :
+    i == LINlabelIndex('m', 'p') ? BRIDGE_FORMAT_SCORES_LIST :
+    i == LINlabelIndex('b', 'n') ? BRIDGE_FORMAT_BOARDS_LIST :
+    i == LINlabelIndex('q', 'x') ? BRIDGE_FORMAT_BOARD_NO :
+    i == LINlabelIndex('p', 'n') ? BRIDGE_FORMAT_PLAYERS : // Also header
+    i == LINlabelIndex('m', 'd') ? BRIDGE_FORMAT_DEAL :
+    i == LINlabelIndex('s', 'v') ? BRIDGE_FORMAT_VULNERABLE :
+    i == LINlabelIndex('m', 'b') ? BRIDGE_FORMAT_AUCTION :
+    i == LINlabelIndex('p', 'c') ? BRIDGE_FORMAT_PLAY :
+    i == LINlabelIndex('m', 'c') ? BRIDGE_FORMAT_RESULT :
+
+    // We ignore some labels.
+    i == LINlabelIndex('p', 'f') ? BRIDGE_FORMAT_LABELS_SIZE :
+    i == LINlabelIndex('p', 'g') ? BRIDGE_FORMAT_LABELS_SIZE :
+    i == LINlabelIndex('s', 't') ? BRIDGE_FORMAT_LABELS_SIZE :
+    i == LINlabelIndex('r', 'h') ? BRIDGE_FORMAT_LABELS_SIZE :
+    i == LINlabelIndex('a', 'h') ? BRIDGE_FORMAT_LABELS_SIZE :
+    i == LINlabelIndex('n', 't') ? BRIDGE_FORMAT_LABELS_SIZE : // Chat
+    BIGNUM);
+}
 
-void setLINTables()
+
+static constexpr unsigned LINlabels[26 * 26] =
+{
+  CTABLE_512(LINlabel, 0),
+  CTABLE_128(LINlabel, 512),
+  CTABLE_32(LINlabel, 640),
+  CTABLE_4(LINlabel, 672)
+};
+
+
+unsigned lookupLINLabel(const string& label)
 {
-  LINmap["vg"] = BRIDGE_FORMAT_TITLE;
-  LINmap["rs"] = BRIDGE_FORMAT_RESULTS_LIST;
-  LINmap["pw"] = BRIDGE_FORMAT_PLAYERS_LIST;
-  LINmap["px"] = BRIDGE_FORMAT_PLAYERS_HEADER;
-  LINmap["mp"] = BRIDGE_FORMAT_SCORES_LIST;
-  LINmap["bn"] = BRIDGE_FORMAT_BOARDS_LIST;
-  LINmap["qx"] = BRIDGE_FORMAT_BOARD_NO;
-  LINmap["pn"] = BRIDGE_FORMAT_PLAYERS; // May also occur in header
-  LINmap["md"] = BRIDGE_FORMAT_DEAL;
-  LINmap["sv"] = BRIDGE_FORMAT_VULNERABLE;
-  LINmap["mb"] = BRIDGE_FORMAT_AUCTION;
-  LINmap["pc"] = BRIDGE_FORMAT_PLAY;
-  LINmap["mc"] = BRIDGE_FORMAT_RESULT;
-
-  // We ignore some labels.
-  LINmap["pf"] = BRIDGE_FORMAT_LABELS_SIZE;
-  LINmap["pg"] = BRIDGE_FORMAT_LABELS_SIZE;
-  LINmap["st"] = BRIDGE_FORMAT_LABELS_SIZE;
-  LINmap["rh"] = BRIDGE_FORMAT_LABELS_SIZE;
-  LINmap["ah"] = BRIDGE_FORMAT_LABELS_SIZE;
-  LINmap["nt"] = BRIDGE_FORMAT_LABELS_SIZE; // Chat
+  // Upper case is also accepted.
+  if (label.length() != 2)
+    return BIGNUM;
+
+  const int a = tolower(static_cast<unsigned char>(label[0]));
+  const int b = tolower(static_cast<unsigned char>(label[1]));
+  if (a < 'a' || a > 'z' || b < 'a' || b > 'z')
+    return BIGNUM;
+
+  return LINlabels[LINlabelIndex(a, b)];
+}
+
+
+static void addLINCalls(
+  Chunk& chunk,
+  const string& value)
+{
+  // A LIN "mb" value is normally a single call, possibly alerted
+  // with a trailing "!".  The calls go straight into the chunk.
+  string s = value;
+  toUpper(s);
+  const size_t l = s.length();
+  size_t pos = 0;
+  while (pos < l)
+  {
+    const char c = s.at(pos);
+    if (c == 'A')
+    {
+      if (pos != l-1)
+        THROW("Characters trailing all-pass");
+
+      chunk.addEvent(BRIDGE_FORMAT_AUCTION, CHUNK_EVENT_PASSES);
+      pos++;
+    }
+    else if (c == ':')
+      pos++;
+    else if (c == '*' || c == '!')
+    {
+      chunk.addAlert(BRIDGE_FORMAT_AUCTION, "!");
+      pos++;
+    }
+    else if (c == 'P' || c == 'X' || c == 'D' || c == 'R')
+    {
+      chunk.addEvent(BRIDGE_FORMAT_AUCTION, CHUNK_EVENT_CALL,
+        string(1, c));
+      pos++;
+    }
+    else if (pos == l-1)
+      THROW("Missing end of bid");
+    else
+    {
+      chunk.addEvent(BRIDGE_FORMAT_AUCTION, CHUNK_EVENT_CALL,
+        s.substr(pos, 2));
+      pos += 2;
+    }
+  }
 }
 
 
-static bool nextLINPair(
-  const string& line,
-  unsigned& pos,
-  string& label,
-  string& value)
+static void addLINCards(
+  Chunk& chunk,
+  const string& value,
+  unsigned& cardCount,
+  char& suitLed)
 {
-  if (pos == line.size())
-    return false;
-
-  size_t lpos = line.find('|', pos);
-  if (lpos == string::npos)
-    return false;
-  size_t vpos = line.find('|', lpos+1);
-  if (vpos == string::npos)
-    return false;
-
-  label = line.substr(pos, lpos-pos);
-  value = line.substr(lpos+1, vpos-lpos-1);
-  pos = static_cast<unsigned>(vpos)+1;
-  return true;
+  string card = value;
+  toUpper(card);
+  if (card == "")
+    return;
+
+  // This is not rigorously correct, but it is how tricks are
+  // delimited in LIN.
+  if (cardCount % 4 == 0)
+    suitLed = card.at(0);
+
+  if (card.length() > 2)
+  {
+    // Several cards at once, usually a whole trick.
+    chunk.addEvent(BRIDGE_FORMAT_PLAY, CHUNK_EVENT_TRICK, card);
+    cardCount += 4;
+  }
+  else
+  {
+    if (card.length() == 1)
+      card = string(1, suitLed) + card;
+
+    chunk.addEvent(BRIDGE_FORMAT_PLAY, CHUNK_EVENT_CARD, card);
+    cardCount++;
+  }
 }
 
 
@@ -80,11 +174,13 @@ void readLINChunk(
   bool& newSegFlag)
 {
   LineData lineData;
+  LINScanner scanner;
+  StrView labelView, valueView;
+  string label, value;
   bool qxSeen = false;
   bool doneFlag = false;
   unsigned cardCount = 0;
-  stringstream alerts;
-  unsigned aNo = 1;
+  char suitLed = ' ';
   while (! doneFlag && buffer.next(lineData))
   {
     if (lineData.type != BRIDGE_BUFFER_EMPTY)
@@ -102,10 +198,15 @@ void readLINChunk(
     if (lineData.type == BRIDGE_BUFFER_EMPTY)
       continue;
     
-    unsigned pos = 0;
-    string label, value;
-    while (nextLINPair(lineData.line, pos, label, value))
+    // Only LIN_RP lines have more than one pair.
+    scanner.set(lineData.line.data(),
+      static_cast<unsigned>(lineData.line.length()));
+    size_t pos = 0;
+    while (scanner.nextPair(pos, labelView, valueView))
     {
+      label.assign(labelView.text, labelView.len);
+      value.assign(valueView.text, valueView.len);
+
       if (label == "pn")
       {
         if (! qxSeen)
@@ -126,22 +227,15 @@ void readLINChunk(
 
       if (label == "an")
       {
-        alerts << aNo << " " << value << "\n";
-        chunk.append(BRIDGE_FORMAT_AUCTION, "^" + STR(aNo));
-        aNo++;
+        chunk.addAlert(BRIDGE_FORMAT_AUCTION, value);
         continue;
       }
 
-      auto it = LINmap.find(label);
-      if (it == LINmap.end())
-      {
-        toLower(label);
-        it = LINmap.find(label);
-        if (it == LINmap.end())
-          THROW("Illegal LIN label in line '" + lineData.line + "'");
-      }
+      const unsigned labelCode = lookupLINLabel(label);
+      if (labelCode == BIGNUM)
+        THROW("Illegal LIN label in line '" + lineData.line + "'");
 
-      const Label labelNo = it->second;
+      const Label labelNo = static_cast<Label>(labelCode);
       if (labelNo <= BRIDGE_FORMAT_VISITTEAM)
         newSegFlag = true;
 
@@ -150,15 +244,7 @@ void readLINChunk(
         continue;
 
       if (labelNo == BRIDGE_FORMAT_PLAY)
-      {
-        // This is not rigorously correct
-        if (cardCount > 0 && cardCount % 4 == 0)
-          chunk.append(labelNo, ":");
-
-        cardCount += (value.size() > 2 ? 4u : 1u);
-
-        chunk.append(labelNo, value);
-      }
+        addLINCards(chunk, value, cardCount, suitLed);
       else if (labelNo == BRIDGE_FORMAT_AUCTION)
       {
         if (value.length() > 4)
@@ -166,7 +252,7 @@ void readLINChunk(
           trimLeading(value, '-');
           value = trimTrailing(value, '-');
         }
-        chunk.append(labelNo, value);
+        addLINCalls(chunk, value);
       }
       else if (chunk.isEmpty(labelNo))
         chunk.set(labelNo, value, lineData.no);
@@ -193,8 +279,6 @@ void readLINChunk(
     }
   }
 
-  if (alerts.str() != "")
-    chunk.append(BRIDGE_FORMAT_AUCTION, "\n" + alerts.str());
   if (! qxSeen && buffer.peek() != 0x00)
     THROW("No deal found");
   if (chunk.isSet(BRIDGE_FORMAT_BOARD_NO) &&
@@ -203,51 +287,68 @@ void readLINChunk(
 }
 
 
+template <Format F>
 void writeLINSegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format)
+  const Segment& segment)
 {
-  st += segment.strTitle(format);
-  st += segment.strContracts(format);
-  st += segment.strPlayers(format);
-  st += segment.strScores(format);
-  st += segment.strBoards(format);
+  st += segment.strTitle(F);
+  st += segment.strContracts(F);
+  st += segment.strPlayers(F);
+  st += segment.strScores(F);
+  st += segment.strBoards(F);
 }
 
 
+template <Format F>
 void writeLINBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format)
+  WriteInfo& writeInfo)
 {
   const Instance& instance = board.getInstance(writeInfo.instNo);
 
-  if (format != BRIDGE_FORMAT_LIN_RP && board.skipped(writeInfo.instNo))
+  if (F != BRIDGE_FORMAT_LIN_RP && board.skipped(writeInfo.instNo))
     return;
 
   st += instance.strRoom(writeInfo.bno, BRIDGE_FORMAT_LIN_RP);
 
-  if (format == BRIDGE_FORMAT_LIN)
-    st += "pn|" + board.strPlayersBoard(format, segment.scoringIsIMPs()) + "|";
-  else if (format == BRIDGE_FORMAT_LIN_TRN)
-    st += instance.strPlayers(format);
+  if (F == BRIDGE_FORMAT_LIN)
+    st += "pn|" + board.strPlayersBoard(F, segment.scoringIsIMPs()) + "|";
+  else if (F == BRIDGE_FORMAT_LIN_TRN)
+    st += instance.strPlayers(F);
 
-  st += board.strDeal(format);
+  board.appendDeal(st, F);
 
-  if (format == BRIDGE_FORMAT_LIN || format == BRIDGE_FORMAT_LIN_TRN)
-    st += segment.strNumber(writeInfo.bno, format);
+  if (F == BRIDGE_FORMAT_LIN || F == BRIDGE_FORMAT_LIN_TRN)
+    st += segment.strNumber(writeInfo.bno, F);
 
-  st += instance.strVul(format);
+  st += instance.strVul(F);
 
   if (! board.skipped(writeInfo.instNo))
   {
-    st += instance.strAuction(format);
-    st += instance.strPlay(format);
+    instance.appendAuction(st, F);
+    instance.appendPlay(st, F);
   }
 
-  st += instance.strClaim(format);
+  st += instance.strClaim(F);
 }
 
+
+template void writeLINSegmentLevel<BRIDGE_FORMAT_LIN>(
+  string&, const Segment&);
+template void writeLINSegmentLevel<BRIDGE_FORMAT_LIN_RP>(
+  string&, const Segment&);
+template void writeLINSegmentLevel<BRIDGE_FORMAT_LIN_VG>(
+  string&, const Segment&);
+template void writeLINSegmentLevel<BRIDGE_FORMAT_LIN_TRN>(
+  string&, const Segment&);
+template void writeLINBoardLevel<BRIDGE_FORMAT_LIN>(
+  string&, const Segment&, const Board&, WriteInfo&);
+template void writeLINBoardLevel<BRIDGE_FORMAT_LIN_RP>(
+  string&, const Segment&, const Board&, WriteInfo&);
+template void writeLINBoardLevel<BRIDGE_FORMAT_LIN_VG>(
+  string&, const Segment&, const Board&, WriteInfo&);
+template void writeLINBoardLevel<BRIDGE_FORMAT_LIN_TRN>(
+  string&, const Segment&, const Board&, WriteInfo&);
@@ -18,23 +18,25 @@ class Buffer;
 class Chunk;
 
 
-void setLINTables();
+// Returns the Label of a two-letter LIN label, BRIDGE_FORMAT_LABELS_SIZE
+// for a label that is read but ignored, and BIGNUM for an illegal one.
+unsigned lookupLINLabel(const string& label);
 
 void readLINChunk(
   Buffer& buffer,
   Chunk& chunk,
   bool& newSegFlag);
 
+template <Format F>
 void writeLINSegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format);
+  const Segment& segment);
 
+template <Format F>
 void writeLINBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format);
+  WriteInfo& writeInfo);
 
 #endif
@@ -237,25 +237,25 @@ void readPBNChunk(
 }
 
 
+template <Format F>
 void writePBNBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format)
+  WriteInfo& writeInfo)
 {
   const Instance& instance = board.getInstance(writeInfo.instNo);
 
   if (writeInfo.first)
   {
-    st += segment.strEvent(format);
-    st += segment.strLocation(format);
-    st += segment.strDate(format);
+    st += segment.strEvent(F);
+    st += segment.strLocation(F);
+    st += segment.strDate(F);
   }
   else
   {
     st += "[Event \"#\"]\n";
-    if (segment.strLocation(format) == "[Site \"\"]\n")
+    if (segment.strLocation(F) == "[Site \"\"]\n")
       st += "[Site \"\"]\n";
     else
       st += "[Site \"#\"]\n";
@@ -263,41 +263,41 @@ void writePBNBoardLevel(
   }
 
   if (writeInfo.ino == 0)
-    st += segment.strNumber(writeInfo.bno, format);
+    st += segment.strNumber(writeInfo.bno, F);
   else
     st += "[Board \"#\"]\n";
 
-  st += instance.strPlayer(BRIDGE_WEST, format);
-  st += instance.strPlayer(BRIDGE_NORTH, format);
-  st += instance.strPlayer(BRIDGE_EAST, format);
-  st += instance.strPlayer(BRIDGE_SOUTH, format);
+  st += instance.strPlayer(BRIDGE_WEST, F);
+  st += instance.strPlayer(BRIDGE_NORTH, F);
+  st += instance.strPlayer(BRIDGE_EAST, F);
+  st += instance.strPlayer(BRIDGE_SOUTH, F);
 
-  st += instance.strDealer(format);
-  st += instance.strVul(format);
-  st += board.strDeal(BRIDGE_WEST, format);
+  st += instance.strDealer(F);
+  st += instance.strVul(F);
+  board.appendDeal(st, BRIDGE_WEST, F);
 
   if (writeInfo.first)
-    st += segment.strScoring(format);
+    st += segment.strScoring(F);
   else
     st += "[Scoring \"#\"]\n";
 
-  st += instance.strDeclarer(format);
-  st += instance.strContract(format);
-  st += instance.strResult(format);
+  st += instance.strDeclarer(F);
+  instance.appendContract(st, F);
+  st += instance.strResult(F);
 
   if (! board.skipped(writeInfo.instNo))
   {
-    st += instance.strAuction(format);
-    st += instance.strPlay(format);
+    instance.appendAuction(st, F);
+    instance.appendPlay(st, F);
   }
 
   const bool swapFlag = segment.getCOCO();
   if (writeInfo.first)
   {
-    st += segment.strTitle(format);
-    st += segment.strSession(format);
-    st += segment.strFirstTeam(format, swapFlag);
-    st += segment.strSecondTeam(format, swapFlag);
+    st += segment.strTitle(F);
+    st += segment.strSession(F);
+    st += segment.strFirstTeam(F, swapFlag);
+    st += segment.strSecondTeam(F, swapFlag);
   }
   else
   {
@@ -307,16 +307,19 @@ void writePBNBoardLevel(
     st += "[VisitTeam \"#\"]\n";
   }
 
-  st += instance.strRoom(0, format);
+  st += instance.strRoom(0, F);
   if (segment.scoringIsIMPs() && writeInfo.ino == 1)
-    st += board.strScore(writeInfo.instNo, format);
+    st += board.strScore(writeInfo.instNo, F);
   else
-    st += instance.strScore(format);
+    st += instance.strScore(F);
 
   if (writeInfo.ino == 0 && writeInfo.numInst == 1)
-    st += board.strGivenScore(format);
-  st += board.strTableau(format);
+    st += board.strGivenScore(F);
+  st += board.strTableau(F);
 
   st += "\n";
 }
 
+
+template void writePBNBoardLevel<BRIDGE_FORMAT_PBN>(
+  string&, const Segment&, const Board&, WriteInfo&);
@@ -28,11 +28,11 @@ void readPBNChunk(
   Chunk& chunk,
   bool& newSegFlag);
 
+template <Format F>
 void writePBNBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format);
+  WriteInfo& writeInfo);
 
 #endif
@@ -83,31 +83,31 @@ void readRBNChunk(
 }
 
 
+template <Format F>
 void writeRBNSegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format)
+  const Segment& segment)
 {
-  st += segment.strTitle(format);
-  st += segment.strDate(format);
-  st += segment.strLocation(format);
-  st += segment.strEvent(format);
-  st += segment.strSession(format);
-  st += segment.strScoring(format);
-  st += segment.strTeams(format);
+  st += segment.strTitle(F);
+  st += segment.strDate(F);
+  st += segment.strLocation(F);
+  st += segment.strEvent(F);
+  st += segment.strSession(F);
+  st += segment.strScoring(F);
+  st += segment.strTeams(F);
 }
 
 
+template <Format F>
 void writeRBNBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format)
+  WriteInfo& writeInfo)
 {
   const Instance& instance = board.getInstance(writeInfo.instNo);
 
-  string names = instance.strPlayers(format);
+  string names = instance.strPlayers(F);
   if (names != writeInfo.namesOld[writeInfo.ino])
   {
     st += names;
@@ -116,22 +116,31 @@ void writeRBNBoardLevel(
         
   if (writeInfo.ino == 0)
   {
-    st += segment.strNumber(writeInfo.bno, format);
-    st += board.strDeal(BRIDGE_WEST, format);
+    st += segment.strNumber(writeInfo.bno, F);
+    board.appendDeal(st, BRIDGE_WEST, F);
   }
 
   if (! board.skipped(writeInfo.instNo))
-    st += instance.strAuction(format);
+    instance.appendAuction(st, F);
 
-  st += instance.strContract(format);
+  instance.appendContract(st, F);
 
   if (! board.skipped(writeInfo.instNo))
-    st += instance.strPlay(format);
+    instance.appendPlay(st, F);
 
   if (writeInfo.ino == 0 || ! segment.scoringIsIMPs())
-    st += instance.strResult(format);
+    st += instance.strResult(F);
   else
-    st += board.strResult(writeInfo.instNo, format);
+    st += board.strResult(writeInfo.instNo, F);
   st += "\n";
 }
 
+
+template void writeRBNSegmentLevel<BRIDGE_FORMAT_RBN>(
+  string&, const Segment&);
+template void writeRBNSegmentLevel<BRIDGE_FORMAT_RBX>(
+  string&, const Segment&);
+template void writeRBNBoardLevel<BRIDGE_FORMAT_RBN>(
+  string&, const Segment&, const Board&, WriteInfo&);
+template void writeRBNBoardLevel<BRIDGE_FORMAT_RBX>(
+  string&, const Segment&, const Board&, WriteInfo&);
@@ -26,16 +26,16 @@ void readRBNChunk(
   Chunk& chunk,
   bool& newSegFlag);
 
+template <Format F>
 void writeRBNSegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format);
+  const Segment& segment);
 
+template <Format F>
 void writeRBNBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format);
+  WriteInfo& writeInfo);
 
 #endif
@@ -351,25 +351,25 @@ void readRECChunk(
 
 
 
+template <Format F>
 void writeRECBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format)
+  WriteInfo& writeInfo)
 {
   const Instance& instance = board.getInstance(writeInfo.instNo);
 
-  const string dstr = board.strDeal(BRIDGE_WEST, format);
-  const string sstr = segment.strScoring(format);
-  const string estr = instance.strDealer(format);
-  const string bstr = segment.strNumber(writeInfo.bno, format);
-  const string vstr = instance.strVul(format);
+  const string dstr = board.strDeal(BRIDGE_WEST, F);
+  const string sstr = segment.strScoring(F);
+  const string estr = instance.strDealer(F);
+  const string bstr = segment.strNumber(writeInfo.bno, F);
+  const string vstr = instance.strVul(F);
 
-  const string west = instance.strPlayer(BRIDGE_WEST, format);
-  const string north = instance.strPlayer(BRIDGE_NORTH, format);
-  const string east = instance.strPlayer(BRIDGE_EAST, format);
-  const string south = instance.strPlayer(BRIDGE_SOUTH, format);
+  const string west = instance.strPlayer(BRIDGE_WEST, F);
+  const string north = instance.strPlayer(BRIDGE_NORTH, F);
+  const string east = instance.strPlayer(BRIDGE_EAST, F);
+  const string south = instance.strPlayer(BRIDGE_SOUTH, F);
 
   // Convert deal, auction and play from \n to vectors.
   vector<string> deal;
@@ -391,21 +391,21 @@ void writeRECBoardLevel(
 
   st += canvas.str(true) + "\n";
 
-  st += instance.strPlayers(format) + "\n";
+  st += instance.strPlayers(F) + "\n";
 
   if (! board.skipped(writeInfo.instNo))
   {
-    st += instance.strAuction(format);
-    st += instance.strLead(format) + "    ";
+    st += instance.strAuction(F);
+    st += instance.strLead(F) + "    ";
   }
   else
     st += "Opening lead:       ";
 
-  st += instance.strResult(format) + "\n";
-  st += instance.strScore(format);
+  st += instance.strResult(F) + "\n";
+  st += instance.strScore(F);
 
   if (writeInfo.ino == 1)
-    st += board.strScoreIMP(writeInfo.instNo, format);
+    st += board.strScoreIMP(writeInfo.instNo, F);
   else
     st += "Points:       ";
   st += "\n";
@@ -415,6 +415,9 @@ void writeRECBoardLevel(
   st += "\n";
 
   if (! board.skipped(writeInfo.instNo))
-    st += instance.strPlay(format);
+    st += instance.strPlay(F);
 }
 
+
+template void writeRECBoardLevel<BRIDGE_FORMAT_REC>(
+  string&, const Segment&, const Board&, WriteInfo&);
@@ -24,11 +24,11 @@ void readRECChunk(
   Chunk& chunk,
   bool& newSegFlag);
 
+template <Format F>
 void writeRECBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format);
+  WriteInfo& writeInfo);
 
 #endif
@@ -463,10 +463,10 @@ void readTXTChunk(
 }
 
 
+template <Format F>
 void writeTXTSegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format)
+  const Segment& segment)
 {
   if (segment.firstBoardNumber() != 1 || segment.hasCarry())
   {
@@ -474,12 +474,12 @@ void writeTXTSegmentLevel(
     st += TXTdashes + "\n";
   }
 
-  st += "\n" + segment.strTitle(format) + "\n";
-  st += segment.strDate(format);
-  st += segment.strLocation(format);
-  st += segment.strEvent(format);
-  st += segment.strSession(format);
-  st += segment.strTeams(format) + "\n\n";
+  st += "\n" + segment.strTitle(F) + "\n";
+  st += segment.strDate(F);
+  st += segment.strLocation(F);
+  st += segment.strEvent(F);
+  st += segment.strSession(F);
+  st += segment.strTeams(F) + "\n\n";
 }
 
 
@@ -548,51 +548,56 @@ static void writeTXTUpdateScore(
 }
 
 
+template <Format F>
 void writeTXTBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format)
+  WriteInfo& writeInfo)
 {
   const Instance& instance = board.getInstance(writeInfo.instNo);
   bool swapFlag;
 
   if (writeInfo.ino == 0)
   {
-    st += writeTXTDiagram(segment, board, instance, writeInfo, format);
-    st += instance.strPlayers(format);
-    st += instance.strAuction(format) + "\n";
-    st += instance.strContract(format);
+    st += writeTXTDiagram(segment, board, instance, writeInfo, F);
+    st += instance.strPlayers(F);
+    st += instance.strAuction(F) + "\n";
+    st += instance.strContract(F);
 
     if (! board.skipped(writeInfo.instNo))
-      st += instance.strPlay(format);
+      st += instance.strPlay(F);
 
-    st += instance.strResult(format) + "\n";
+    st += instance.strResult(F) + "\n";
   }
   else
   {
     // Pavlicek bug?
-    const string p = instance.strPlayers(format);
+    const string p = instance.strPlayers(F);
     st += (p == "" ? "\n" : p);
 
-    st += instance.strAuction(format) + "\n";
-    st += instance.strContract(format);
-    st += instance.strPlay(format);
+    st += instance.strAuction(F) + "\n";
+    st += instance.strContract(F);
+    st += instance.strPlay(F);
 
     swapFlag = segment.getCOCO();
     string tWin;
-    writeTXTUpdateScore(segment, board, writeInfo, tWin, format, swapFlag);
+    writeTXTUpdateScore(segment, board, writeInfo, tWin, F, swapFlag);
 
-    st += board.strResult(writeInfo.instNo, tWin, format) + "\n";
+    st += board.strResult(writeInfo.instNo, tWin, F) + "\n";
   }
 
   if (writeInfo.ino > 0 || writeInfo.numInst == 1)
   {
     st += segment.strTeams(writeInfo.score1, writeInfo.score2, 
-        format, swapFlag) + "\n";
+        F, swapFlag) + "\n";
     if (! writeInfo.last)
       st += TXTdashes + "\n\n";
   }
 }
 
+
+template void writeTXTSegmentLevel<BRIDGE_FORMAT_TXT>(
+  string&, const Segment&);
+template void writeTXTBoardLevel<BRIDGE_FORMAT_TXT>(
+  string&, const Segment&, const Board&, WriteInfo&);
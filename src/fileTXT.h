@@ -27,16 +27,16 @@ void readTXTChunk(
   Chunk& chunk,
   bool& newSegFlag);
 
+template <Format F>
 void writeTXTSegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format);
+  const Segment& segment);
 
+template <Format F>
 void writeTXTBoardLevel(
   string& st,
   const Segment& segment,
   const Board& board,
-  WriteInfo& writeInfo,
-  const Format format);
+  WriteInfo& writeInfo);
 
 #endif
@@ -10,9 +10,11 @@
 #include "Group.h"
 #include "Buffer.h"
 #include "CompStats.h"
+#include "Files.h"
 
 #include "funcCompare.h"
 #include "funcRead.h"
+#include "fileBDB.h"
 
 #include "Bexcept.h"
 #include "Bdiff.h"
@@ -30,6 +32,16 @@ void dispatchCompare(
   try
   {
     Group groupNew;
+    if (format == BRIDGE_FORMAT_BDB)
+    {
+      // Team swaps are stored as they are.
+      BoardOrder orderStored;
+      readBDBGroup(text.data(), text.size(), groupNew, orderStored);
+      group == groupNew;
+      cstats.add(true, format);
+      return;
+    }
+
     if (group.isCOCO() &&
        (format == BRIDGE_FORMAT_TXT ||
         format == BRIDGE_FORMAT_EML ||
@@ -69,3 +81,39 @@ void dispatchCompare(
   }
 }
 
+
+void dispatchCompareFrozen(
+  const string& fname,
+  const Group& group,
+  const Files& files,
+  const unsigned firstNo,
+  CompStats& cstats,
+  ostream& flog)
+{
+  // The frozen boards use the BDB encoding, so they are counted there.
+  try
+  {
+    unsigned no = firstNo;
+    for (auto &segment: group)
+    {
+      for (auto &bpair: segment)
+      {
+        Board board;
+        files.thawBoard(no++, board);
+        bpair.board == board;
+      }
+    }
+    cstats.add(true, BRIDGE_FORMAT_BDB);
+  }
+  catch (Bdiff& bdiff)
+  {
+    cout << "Difference: " << fname << ", frozen\n";
+    bdiff.print(flog);
+    cstats.add(false, BRIDGE_FORMAT_BDB);
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(flog);
+    cstats.add(false, BRIDGE_FORMAT_BDB);
+  }
+}
@@ -13,6 +13,7 @@
 #include "bconst.h"
 
 class Group;
+class Files;
 class CompStats;
 
 using namespace std;
@@ -27,4 +28,12 @@ void dispatchCompare(
   CompStats& cstats,
   ostream& flog);
 
+void dispatchCompareFrozen(
+  const string& fname,
+  const Group& group,
+  const Files& files,
+  const unsigned firstNo,
+  CompStats& cstats,
+  ostream& flog);
+
 #endif
@@ -14,6 +14,7 @@
 
 #include "Group.h"
 #include "Files.h"
+#include "DDBatch.h"
 #include "parse.h"
 
 #include "dll.h"
@@ -24,10 +25,12 @@ using namespace std;
 
 
 void makeTableau(
+  Files& files,
   ddTableDealsPBN * tablePBN,
   array<Board *, MAXNOOFTABLES> bpMissing,
   vector<string>& infoMissing)
 {
+  unsigned holding[BRIDGE_PLAYERS][BRIDGE_SUITS];
   ddTablesRes resDDS;
   tableauDD(tablePBN, &resDDS);
 
@@ -38,6 +41,9 @@ void makeTableau(
 
     const string s = bpMissing[u]->strTableau(BRIDGE_FORMAT_RBN);
     infoMissing.push_back(s.substr(4, s.length()-6));
+
+    bpMissing[u]->getDealDDS(holding);
+    files.addTableau(holding, infoMissing.back());
   }
 
   tablePBN->noOfTables = 0;
@@ -62,6 +68,8 @@ void str2Board(
 void makeDD(
   Group& group,
   Files& files,
+  DDBatch& ddBatch,
+  DDBatch::Tickets& tickets,
   const string& fname)
 {
   // It is a bug that multiple segments in an input file which use
@@ -83,6 +91,8 @@ void makeDD(
       boardsIn.push_back(to_string(bp.extNo));
     
     vector<string> boardsMissAll, boardsMissing, infoMissing;
+    vector<string> boardsCached, infoCached;
+    unsigned holding[BRIDGE_PLAYERS][BRIDGE_SUITS];
     CaseResults infoSeen;
     array<Board *, MAXNOOFTABLES> bpMissing;
     files.haveResults(BRIDGE_DD_INFO_SOLVE, fname, 
@@ -95,6 +105,9 @@ void makeDD(
       Board * bd;
       str2Board(itSeen.first, segptr, &bd);
       bd->setTableau("::" + itSeen.second, BRIDGE_FORMAT_RBN);
+
+      bd->getDealDDS(holding);
+      files.addTableau(holding, itSeen.second);
     }
 
     for (string extStr: boardsMissAll)
@@ -102,11 +115,30 @@ void makeDD(
       Board * bd;
       str2Board(extStr, segptr, &bd);
 
+      // The same deal may already be solved elsewhere in the corpus.
+      string info;
+      bd->getDealDDS(holding);
+      if (files.haveTableau(holding, info))
+      {
+        bd->setTableau("::" + info, BRIDGE_FORMAT_RBN);
+        boardsCached.push_back(extStr);
+        infoCached.push_back(info);
+        continue;
+      }
+
       string tmp = bd->strDeal(BRIDGE_WEST,BRIDGE_FORMAT_PBN);
       const size_t l = tmp.length();
       if (l < 40)
         THROW("Not PBN: " + tmp);
 
+      if (ddBatch.active())
+      {
+        // Skip "Deal [" and the trailing stuff.
+        ddBatch.addTableau(fname, extStr, bd, 
+          string(tmp.begin()+7, tmp.end()-3), tickets);
+        continue;
+      }
+
       // Skip "Deal [" and the trailing stuff.
       copy(tmp.begin()+7, tmp.end()-3, 
         tablePBN.deals[tablePBN.noOfTables].cards);
@@ -119,7 +151,7 @@ void makeDD(
 
       if (tablePBN.noOfTables == MAXNOOFTABLES)
       {
-        makeTableau(&tablePBN, bpMissing, infoMissing);
+        makeTableau(files, &tablePBN, bpMissing, infoMissing);
         files.addDDInfo(BRIDGE_DD_INFO_SOLVE, fname, 
           boardsMissing, infoMissing);
         tablePBN.noOfTables = 0;
@@ -131,10 +163,14 @@ void makeDD(
     if (tablePBN.noOfTables > 0)
     {
       // Stragglers.
-      makeTableau(&tablePBN, bpMissing, infoMissing);
+      makeTableau(files, &tablePBN, bpMissing, infoMissing);
       files.addDDInfo(BRIDGE_DD_INFO_SOLVE, fname, 
         boardsMissing, infoMissing);
     }
+
+    if (boardsCached.size() > 0)
+      files.addDDInfo(BRIDGE_DD_INFO_SOLVE, fname, 
+        boardsCached, infoCached);
   }
 }
 
@@ -142,12 +178,27 @@ void makeDD(
 void dispatchDD(
   Group& group,
   Files& files,
+  DDBatch& ddBatch,
   const string& fname,
   ostream& flog)
 {
+  DDBatch::Tickets tickets;
+  try
+  {
+    makeDD(group, files, ddBatch, tickets, fname);
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(flog);
+  }
+
+  // The batches refer to boards in group, so always wait for them.
+  if (tickets.empty())
+    return;
+
   try
   {
-    makeDD(group, files, fname);
+    ddBatch.wait(tickets);
   }
   catch (Bexcept& bex)
   {
@@ -36,7 +36,7 @@ void writeDupl(
     segNo++;
 
     for (auto &bp: segment)
-      duplstats.append(bp.board.hash12());
+      duplstats.append(bp.board.fingerprint());
     
     duplstats.sortActive();
   }
@@ -12,10 +12,18 @@
 #include <iomanip>
 #include <sstream>
 #include <fstream>
+#include <exception>
+
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+#else
+  #include <thread>
+#endif
 
 #include "Group.h"
 #include "Chunk.h"
 #include "RefLines.h"
+#include "MappedFile.h"
 
 #include "fileLIN.h"
 #include "filePBN.h"
@@ -23,6 +31,7 @@
 #include "fileTXT.h"
 #include "fileEML.h"
 #include "fileREC.h"
+#include "fileBDB.h"
 
 #include "funcRead.h"
 #include "OrderCounts.h"
@@ -43,10 +52,58 @@ static SegPtr segPtr[BRIDGE_FORMAT_LABELS_SIZE];
 static BoardPtr boardPtr[BRIDGE_FORMAT_LABELS_SIZE];
 static InstPtr instPtr[BRIDGE_FORMAT_LABELS_SIZE];
 
+// A file is only split if each piece gets at least this many lines.
+const unsigned SPLIT_MIN_LINES = 2000;
+
+// What the reader carries from one chunk to the next.
+
+struct ReadState
+{
+  Chunk prevChunk;
+  Segment * segment;
+  Board * board;
+  Counts counts;
+  Counts countsPrev;
+  OrderCounts orderCounts;
+};
+
+// What happened when a chunk of a piece was stored.
+
+struct ChunkTrace
+{
+  Counts counts;
+  bool newSegFlag; // Started a segment
+  bool newBoardFlag; // Went to another board
+  bool madeBoardFlag; // ... which was new in its segment
+};
+
+// A part of a file that is read on its own and then stitched
+// together with the parts before it.
+
+struct ReadPiece
+{
+  unsigned start; // First line index
+  unsigned stop; // Next piece starts here
+  unsigned end; // Line index after the last chunk that was read
+
+  bool readFlag; // All chunks could be read
+  bool endFlag; // The file ends in this piece
+  bool storeFlag; // All chunks could be stored
+
+  // A Bexcept only means that the piece could not be read on its
+  // own, and the sequential reader reports it again.  Anything else
+  // is kept here and thrown again on the main thread.
+  exception_ptr error;
+
+  vector<Chunk> chunks;
+  vector<bool> segFlags; // From the chunk reader
+  vector<ChunkTrace> traces;
+  Group group;
+};
+
 
 void setReadTables()
 {
-  setLINTables();
   setPBNTables();
   setRBNTables();
   setTXTTables();
@@ -106,13 +163,14 @@ void setReadTables()
 static void printCounts(
   const string& fname,
   const Chunk& chunk,
-  const Counts& counts)
+  const Counts& counts,
+  ostream& fout)
 {
-  cout << "Input file:   " << fname << endl;
-  cout << "Segment:      " << counts.segno << endl;
-  cout << "Board:        " << counts.bno << endl;
-  cout << "Room:         " << (counts.openFlag ? "Open" : "Closed") << endl;
-  cout << chunk.strRange();
+  fout << "Input file:   " << fname << endl;
+  fout << "Segment:      " << counts.segno << endl;
+  fout << "Board:        " << counts.bno << endl;
+  fout << "Room:         " << (counts.openFlag ? "Open" : "Closed") << endl;
+  fout << chunk.strRange();
 }
 
 
@@ -123,7 +181,8 @@ static bool storeLINHeader(
   const Counts& counts,
   Segment * segment,
   Chunk& chunk,
-  ostream& flog)
+  ostream& flog,
+  ostream& fout)
 {
   try
   {
@@ -142,12 +201,12 @@ static bool storeLINHeader(
   catch (Bexcept& bex)
   {
     if (options.verboseThrow)
-      printCounts(fname, chunk, counts);
+      printCounts(fname, chunk, counts, fout);
 
     bex.print(flog);
 
     if (options.verboseBatch)
-      cout << chunk.str();
+      fout << chunk.str();
     return false;
   }
 
@@ -155,6 +214,65 @@ static bool storeLINHeader(
 }
 
 
+static void storeEvents(
+  const vector<ChunkEvent>& events,
+  const Label label,
+  const Format format,
+  Instance * instance)
+{
+  // In Vugraph LIN the cards of a trick may have to be rotated
+  // into place, so they are collected a trick at a time.
+  vector<string> trick;
+  for (auto &event: events)
+  {
+    switch(event.type)
+    {
+      case CHUNK_EVENT_CALL:
+        instance->addCall(event.text, event.alert);
+        break;
+
+      case CHUNK_EVENT_PASSES:
+        instance->addPasses();
+        break;
+
+      case CHUNK_EVENT_CARD:
+        if (format == BRIDGE_FORMAT_LIN_VG)
+        {
+          trick.push_back(event.text);
+          if (trick.size() == BRIDGE_PLAYERS)
+          {
+            instance->addTrick(trick, format);
+            trick.clear();
+          }
+        }
+        else
+          instance->addPlay(event.text);
+        break;
+
+      case CHUNK_EVENT_TRICK:
+        if (! trick.empty())
+        {
+          instance->addTrick(trick, format);
+          trick.clear();
+        }
+        instance->addTrick(event.text, format);
+        break;
+
+      default:
+        THROW("Unknown chunk event: " + STR(event.type));
+    }
+  }
+
+  if (! trick.empty())
+    instance->addTrick(trick, format);
+
+  if (label == BRIDGE_FORMAT_AUCTION)
+    instance->finishAuction();
+  else if (label == BRIDGE_FORMAT_PLAY)
+    instance->finishPlays();
+}
+
+
 static bool storeChunk(
   const string& fname,
   const Format format,
@@ -164,7 +282,8 @@ static bool storeChunk(
   Board * board,
   Instance * instance,
   Chunk& chunk,
-  ostream& flog)
+  ostream& flog,
+  ostream& fout)
 {
   if (((format == BRIDGE_FORMAT_RBN || format == BRIDGE_FORMAT_RBX) &&
       chunk.isEmpty(BRIDGE_FORMAT_AUCTION)) ||
@@ -194,40 +313,517 @@ static bool storeChunk(
 
     for (i = BRIDGE_FORMAT_PLAYERS; i < BRIDGE_FORMAT_LABELS_SIZE; i++)
     {
+      const Label label = static_cast<Label>(i);
       const string text = chunk.get(i);
       if (text != "")
         (instance->*instPtr[i])(text, format);
+      else if (! chunk.getEvents(label).empty())
+        storeEvents(chunk.getEvents(label), label, format, instance);
     }
   }
   catch (Bexcept& bex)
   {
     if (options.verboseThrow)
     {
-      printCounts(fname, chunk, counts);
-      cout << chunk.str(static_cast<Label>(i));
+      printCounts(fname, chunk, counts, fout);
+      fout << chunk.str(static_cast<Label>(i));
     }
 
     bex.print(flog);
 
-    cout << board->strDeal(BRIDGE_FORMAT_TXT) << endl;
-    cout << instance->strContract(BRIDGE_FORMAT_TXT) << endl;
+    fout << board->strDeal(BRIDGE_FORMAT_TXT) << endl;
+    fout << instance->strContract(BRIDGE_FORMAT_TXT) << endl;
 
     if (options.verboseBatch)
-      cout << chunk.str();
+      fout << chunk.str();
     return false;
   }
 
   if (! instance->auctionIsOver() && instance->lengthAuction() > 0)
   {
-    printCounts(fname, chunk, counts);
-    cout << board->strDeal(BRIDGE_FORMAT_TXT) << endl;
-    cout << instance->strContract(BRIDGE_FORMAT_TXT) << endl;
-    cout << instance->strAuction(BRIDGE_FORMAT_TXT) << endl;
-    cout << instance->strPlay(BRIDGE_FORMAT_TXT) << endl;
-    cout << "Error: Auction incomplete\n";
+    printCounts(fname, chunk, counts, fout);
+    fout << board->strDeal(BRIDGE_FORMAT_TXT) << endl;
+    fout << instance->strContract(BRIDGE_FORMAT_TXT) << endl;
+    fout << instance->strAuction(BRIDGE_FORMAT_TXT) << endl;
+    fout << instance->strPlay(BRIDGE_FORMAT_TXT) << endl;
+    fout << "Error: Auction incomplete\n";
+    return false;
+  }
+
+  return true;
+}
+
+
+static void resetState(ReadState& state)
+{
+  state.segment = nullptr;
+  state.board = nullptr;
+  state.counts = {0, 0, 0, true};
+  state.countsPrev = {0, 0, 0, true};
+}
+
+
+static bool storeNextChunk(
+  const Format format,
+  const Options& options,
+  Group& group,
+  Chunk& chunk,
+  bool newSegFlag,
+  ReadState& state,
+  ostream& flog,
+  ostream& fout)
+{
+  // In PBN, the header may just be repeated.
+  if (newSegFlag && format == BRIDGE_FORMAT_PBN)
+    newSegFlag = chunk.differsFrom(state.prevChunk, CHUNK_HEADER);
+
+  if (state.segment == nullptr || newSegFlag)
+  {
+    if (state.board != nullptr)
+      state.board->calculateScore();
+
+    state.segment = group.make();
+    state.counts.segno++;
+    state.countsPrev.bno = 0;
+
+    if (FORMAT_INPUT_MAP[format] == BRIDGE_FORMAT_LIN)
+    {
+      // Need to store the LIN header first, as it contains default
+      // information for boards.
+      if (! storeLINHeader(group.name(), format, options, state.counts,
+          state.segment, chunk, flog, fout))
+        return false;
+    }
+    else if (format == BRIDGE_FORMAT_TXT ||
+        format == BRIDGE_FORMAT_EML ||
+        format == BRIDGE_FORMAT_REC)
+    {
+      // If COCO, then we start with open room here, so that the
+      // first inversion is closed, and vice versa.
+      state.counts.openFlag = state.segment->getCOCO();
+    }
+  }
+
+  chunk.getCounts(format, state.counts);
+  state.orderCounts.incr(state.counts, state.countsPrev);
+  state.countsPrev = state.counts;
+
+  if (state.board == nullptr || state.counts.bno != state.counts.prevno)
+  {
+    if (state.board != nullptr)
+      state.board->calculateScore();
+
+    state.board = state.segment->acquireBoard(state.counts.bno);
+    state.counts.prevno = state.counts.bno;
+  }
+
+  const unsigned instNo = (state.counts.openFlag ? 0u : 1u);
+  Instance * instance = state.board->acquireInstance(instNo);
+  state.board->markUsed(instNo);
+
+  if (! storeChunk(group.name(), format, options, state.counts,
+      state.segment, state.board, instance, chunk, flog, fout))
+    return false;
+
+  if (format == BRIDGE_FORMAT_PBN)
+    state.prevChunk.copyFrom(chunk, CHUNK_HEADER);
+  return true;
+}
+
+
+static void readPiece(
+  const Format format,
+  const Options& options,
+  const Buffer& buffer,
+  ReadPiece& piece)
+{
+  // Reads and stores a piece as if it were a file of its own.
+  // Nothing is printed, as the piece is only a guess at first.
+  ostream silent(nullptr);
+  ReadState state;
+  resetState(state);
+
+  piece.readFlag = true;
+  piece.endFlag = false;
+  piece.storeFlag = true;
+
+  try
+  {
+    Buffer view;
+    view.view(buffer, piece.start);
+
+    while (view.position() < piece.stop)
+    {
+      piece.chunks.emplace_back();
+      Chunk& chunk = piece.chunks.back();
+      bool newSegFlag = false;
+      try
+      {
+        (* readChunk[format])(view, chunk, newSegFlag);
+      }
+      catch (Bexcept& bex)
+      {
+        UNUSED(bex);
+        piece.readFlag = false;
+        break;
+      }
+
+      if (chunk.seemsEmpty())
+      {
+        piece.chunks.pop_back();
+        piece.endFlag = true;
+        break;
+      }
+
+      piece.segFlags.push_back(newSegFlag);
+      if (! piece.storeFlag)
+        continue;
+
+      const Segment * segmentOld = state.segment;
+      const Board * boardOld = state.board;
+      const unsigned prevnoOld = state.counts.prevno;
+      const unsigned sizeOld =
+        (segmentOld == nullptr ? 0 : segmentOld->size());
+
+      try
+      {
+        if (! storeNextChunk(format, options, piece.group, chunk,
+            newSegFlag, state, silent, silent))
+          piece.storeFlag = false;
+      }
+      catch (Bexcept& bex)
+      {
+        UNUSED(bex);
+        piece.storeFlag = false;
+      }
+
+      if (! piece.storeFlag)
+        continue;
+
+      piece.traces.emplace_back();
+      ChunkTrace& trace = piece.traces.back();
+      trace.counts = state.counts;
+      trace.newSegFlag = (state.segment != segmentOld);
+      trace.newBoardFlag = (boardOld == nullptr ||
+        state.counts.prevno != prevnoOld);
+      trace.madeBoardFlag = (trace.newSegFlag ?
+        state.segment->size() > 0 : state.segment->size() > sizeOld);
+    }
+
+    piece.end = view.position();
+
+    if (piece.storeFlag && state.board != nullptr)
+      state.board->calculateScore();
+  }
+  catch (Bexcept& bex)
+  {
+    UNUSED(bex);
+    piece.readFlag = false;
+  }
+  catch (exception& ex)
+  {
+    UNUSED(ex);
+    piece.readFlag = false;
+    piece.error = current_exception();
+  }
+}
+
+
+static void redoPlayers(
+  const Format format,
+  const Board& boardPrev,
+  const ReadPiece& piece,
+  const unsigned cfirst,
+  const unsigned clast,
+  Board& board)
+{
+  // Takes the board's players from boardPrev as Segment does, and
+  // then sets them again from the chunks of the board.
+  const unsigned instCount = boardPrev.countAll();
+  if (instCount == 0)
+    THROW("Empty predecessor board");
+
+  board.acquireInstance(instCount-1);
+  board.copyPlayers(boardPrev);
+
+  for (unsigned c = cfirst; c < clast; c++)
+  {
+    const Chunk& chunk = piece.chunks[c];
+    Instance * instance = board.acquireInstance(
+      piece.traces[c].counts.openFlag ? 0u : 1u);
+
+    for (unsigned i = BRIDGE_FORMAT_PLAYERS;
+        i <= BRIDGE_FORMAT_SOUTH; i++)
+    {
+      const string text = chunk.get(i);
+      if (text != "")
+        (instance->*instPtr[i])(text, format);
+    }
+  }
+}
+
+
+static bool canSplice(
+  const ReadPiece& piece,
+  const unsigned cfirst,
+  ReadState& state)
+{
+  // From chunk cfirst on, the piece on its own must have done
+  // exactly what the sequential reader would do.  The counts
+  // must agree, the boards must not have been seen before, and
+  // the board before must have the same number of instances.
+  // Only the players can then differ, and these are fixed later.
+  const Counts& counts = piece.traces[cfirst-1].counts;
+  if (state.counts.bno != counts.bno ||
+      state.counts.prevno != counts.prevno ||
+      state.counts.openFlag != counts.openFlag)
+    return false;
+
+  const Segment& segPiece = * piece.group.begin();
+  const Board& boardPiece = segPiece.begin()->board;
+  const Board& boardLast = (state.segment->mend() - 1)->board;
+  if (boardPiece.countAll() != boardLast.countAll())
+    return false;
+
+  bool firstFlag = true;
+  for (unsigned c = cfirst; c < piece.traces.size(); c++)
+  {
+    const ChunkTrace& trace = piece.traces[c];
+    if (trace.newSegFlag)
+    {
+      // The chunk must also start a board in the new segment.
+      if (! trace.newBoardFlag)
+        return false;
+      firstFlag = false;
+    }
+    else if (firstFlag && trace.newBoardFlag && ! trace.madeBoardFlag)
+      return false;
+  }
+
+  for (auto it = segPiece.begin() + 1; it != segPiece.end(); it++)
+  {
+    if (state.segment->getBoard(it->extNo) != nullptr)
+      return false;
+  }
+
+  return true;
+}
+
+
+static void splicePiece(
+  const Format format,
+  ReadPiece& piece,
+  const unsigned cfirst,
+  Group& group,
+  ReadState& state)
+{
+  const unsigned n = static_cast<unsigned>(piece.chunks.size());
+  Segment& segPiece = * piece.group.mbegin();
+
+  // The sequential reader would finish the board here.
+  state.board->calculateScore();
+
+  // A new board starts out with the players of the board before,
+  // so redo the players until the piece agrees with the sequence.
+  const Board * boardPrev = &(state.segment->mend() - 1)->board;
+  unsigned c = cfirst;
+  for (auto it = segPiece.mbegin() + 1; it != segPiece.mend(); it++)
+  {
+    unsigned cnext = c+1;
+    while (cnext < n && ! piece.traces[cnext].newBoardFlag)
+      cnext++;
+
+    Board board;
+    redoPlayers(format, * boardPrev, piece, c, cnext, board);
+    if (it->board.samePlayers(board))
+      break;
+
+    it->board.copyPlayers(board);
+    boardPrev = &it->board;
+    c = cnext;
+  }
+
+  // The segment-level fields go into the ongoing segment.
+  for (c = cfirst; c < n && ! piece.traces[c].newSegFlag; c++)
+  {
+    for (unsigned i = 0; i <= BRIDGE_FORMAT_ROOM; i++)
+    {
+      const string text = piece.chunks[c].get(i);
+      if (text != "")
+        (state.segment->*segPtr[i])(text, format);
+    }
+  }
+
+  state.segment->moveBoards(segPiece, 1);
+  if (piece.group.size() > 1)
+    state.segment = group.splice(piece.group, 1);
+
+  for (c = cfirst; c < n; c++)
+  {
+    const ChunkTrace& trace = piece.traces[c];
+    if (trace.newSegFlag)
+      state.countsPrev.bno = 0;
+    state.orderCounts.incr(trace.counts, state.countsPrev);
+    state.countsPrev = trace.counts;
+  }
+
+  const unsigned segno = state.counts.segno -
+    piece.traces[cfirst-1].counts.segno;
+  state.counts = piece.traces[n-1].counts;
+  state.counts.segno += segno;
+  state.countsPrev.segno = state.counts.segno;
+
+  if (format == BRIDGE_FORMAT_PBN)
+    state.prevChunk.copyFrom(piece.chunks[n-1], CHUNK_HEADER);
+
+  state.board = state.segment->acquireBoard(state.counts.prevno);
+}
+
+
+static bool stitchPiece(
+  const Format format,
+  const Options& options,
+  ReadPiece& piece,
+  Group& group,
+  ReadState& state,
+  ostream& silent)
+{
+  const unsigned n = static_cast<unsigned>(piece.chunks.size());
+
+  // The first board of a piece may continue from the previous
+  // piece, so it is always stored again in sequence.
+  unsigned cfirst = n;
+  if (piece.storeFlag)
+  {
+    for (unsigned c = 1; c < n; c++)
+    {
+      if (piece.traces[c].newBoardFlag || piece.traces[c].newSegFlag)
+      {
+        cfirst = c;
+        break;
+      }
+    }
+  }
+
+  for (unsigned c = 0; c < cfirst; c++)
+  {
+    if (! storeNextChunk(format, options, group, piece.chunks[c],
+        piece.segFlags[c], state, silent, silent))
+      return false;
+  }
+
+  if (cfirst == n)
+    return true;
+
+  if (canSplice(piece, cfirst, state))
+  {
+    splicePiece(format, piece, cfirst, group, state);
+    return true;
+  }
+
+  for (unsigned c = cfirst; c < n; c++)
+  {
+    if (! storeNextChunk(format, options, group, piece.chunks[c],
+        piece.segFlags[c], state, silent, silent))
+      return false;
+  }
+  return true;
+}
+
+
+static bool dispatchReadPieces(
+  const Format format,
+  const Options& options,
+  Buffer& buffer,
+  Group& group,
+  BoardOrder& order)
+{
+  // Reads the buffer as several pieces in parallel.  Returns false
+  // if this is not possible or if anything goes wrong, and then
+  // the caller reads the buffer in sequence, which also produces
+  // any error messages.
+  if (format != BRIDGE_FORMAT_PBN &&
+      format != BRIDGE_FORMAT_RBN &&
+      format != BRIDGE_FORMAT_TXT)
+    return false;
+
+  vector<unsigned> starts;
+  buffer.boardStarts(options.splitPieces, SPLIT_MIN_LINES, starts);
+  const unsigned n = static_cast<unsigned>(starts.size());
+  if (n < 2)
+    return false;
+
+  vector<ReadPiece> pieces(n);
+  for (unsigned k = 0; k < n; k++)
+  {
+    pieces[k].start = starts[k];
+    pieces[k].stop = (k+1 < n ? starts[k+1] : BIGNUM);
+  }
+
+  vector<thread> thr(n-1);
+  for (unsigned k = 1; k < n; k++)
+    thr[k-1] = thread(readPiece, format, cref(options), cref(buffer),
+      ref(pieces[k]));
+
+  readPiece(format, options, buffer, pieces[0]);
+
+  for (auto &t: thr)
+    t.join();
+
+  for (auto &piece: pieces)
+  {
+    if (piece.error)
+      rethrow_exception(piece.error);
+  }
+
+  // Each piece must end exactly where the next one starts, as the
+  // sequential reader would otherwise read different chunks.
+  unsigned used = n;
+  for (unsigned k = 0; k < n; k++)
+  {
+    if (! pieces[k].readFlag)
+      return false;
+
+    if (pieces[k].endFlag)
+    {
+      used = k+1;
+      break;
+    }
+
+    if (k+1 < n && pieces[k].end != pieces[k+1].start)
+      return false;
+  }
+
+  Group stitched;
+  stitched.setName(group.name());
+  stitched.setFormat(format);
+  if (group.isCOCO())
+    stitched.setCOCO();
+
+  ostream silent(nullptr);
+  ReadState state;
+  resetState(state);
+
+  try
+  {
+    for (unsigned k = 0; k < used; k++)
+    {
+      if (! stitchPiece(format, options, pieces[k], stitched,
+          state, silent))
+        return false;
+    }
+
+    if (state.board != nullptr)
+      state.board->calculateScore();
+  }
+  catch (Bexcept& bex)
+  {
+    UNUSED(bex);
     return false;
   }
 
+  group.splice(stitched, 0);
+  order = state.orderCounts.classify();
   return true;
 }
 
@@ -241,21 +837,19 @@ bool dispatchReadBuffer(
   ostream& flog)
 {
   group.setFormat(format);
-  Chunk chunk, prevChunk;
-  Segment * segment = nullptr;
-  Board * board = nullptr;
-  Instance * instance = nullptr;
-  bool newSegFlag = false;
-  Counts counts = {0, 0, 0, true};
-  Counts countsPrev = {0, 0, 0, true};
-  OrderCounts orderCounts;
+
+  if (options.splitPieces > 1 &&
+      dispatchReadPieces(format, options, buffer, group, order))
+    return true;
+
+  Chunk chunk;
+  ReadState state;
+  resetState(state);
 
   while (true)
   {
-    if (format == BRIDGE_FORMAT_PBN)
-      prevChunk.copyFrom(chunk, CHUNK_HEADER);
-
     chunk.reset();
+    bool newSegFlag = false;
     try
     {
       (* readChunk[format])(buffer, chunk, newSegFlag);
@@ -263,7 +857,7 @@ bool dispatchReadBuffer(
     catch (Bexcept& bex)
     {
       if (options.verboseThrow)
-        printCounts(group.name(), chunk, counts);
+        printCounts(group.name(), chunk, state.counts, cout);
 
       bex.print(flog);
 
@@ -275,64 +869,42 @@ bool dispatchReadBuffer(
     if (chunk.seemsEmpty())
       break;
 
-    // In PBN, the header may just be repeated.
-    if (newSegFlag && format == BRIDGE_FORMAT_PBN)
-      newSegFlag = chunk.differsFrom(prevChunk, CHUNK_HEADER);
-
-    if (segment == nullptr || newSegFlag)
-    {
-      if (board != nullptr)
-        board->calculateScore();
+    if (! storeNextChunk(format, options, group, chunk, newSegFlag,
+        state, flog, cout))
+      return false;
+  }
 
-      segment = group.make();
-      newSegFlag = false;
-      counts.segno++;
-      countsPrev.bno = 0;
+  if (state.board != nullptr)
+    state.board->calculateScore();
 
-      if (FORMAT_INPUT_MAP[format] == BRIDGE_FORMAT_LIN)
-      {
-        // Need to store the LIN header first, as it contains default
-        // information for boards.
-        if (! storeLINHeader(group.name(), format, options, counts,
-            segment, chunk, flog))
-          return false;
-      }
-      else if (format == BRIDGE_FORMAT_TXT ||
-          format == BRIDGE_FORMAT_EML ||
-          format == BRIDGE_FORMAT_REC)
-      {
-        // If COCO, then we start with open room here, so that the
-        // first inversion is closed, and vice versa.
-        counts.openFlag = segment->getCOCO();
-      }
-    }
+  order = state.orderCounts.classify();
+  return true;
+}
 
-    chunk.getCounts(format, counts);
-    orderCounts.incr(counts, countsPrev);
-    countsPrev = counts;
 
-    if (board == nullptr || counts.bno != counts.prevno)
-    {
-      if (board != nullptr)
-        board->calculateScore();
+static bool readBDBFile(
+  const string& fname,
+  Group& group,
+  RefLines& refLines)
+{
+  // The BDB file brings its own board order and team swaps.
+  refLines.read(fname);
+  if (refLines.skip())
+    return true;
 
-      board = segment->acquireBoard(counts.bno);
-      counts.prevno = counts.bno;
-    }
+  MappedFile mapping;
+  if (! mapping.open(fname))
+    THROW("Cannot read BDB file: " + fname);
 
-    const unsigned instNo = (counts.openFlag ? 0u : 1u);
-    instance = board->acquireInstance(instNo);
-    board->markUsed(instNo);
+  group.setName(fname);
 
-    if (! storeChunk(group.name(), format, options, counts,
-        segment, board, instance, chunk, flog))
-      return false;
-  }
+  BoardOrder orderSeen;
+  readBDBGroup(mapping.begin(), mapping.size(), group, orderSeen);
 
-  if (board != nullptr)
-    board->calculateScore();
+  if (refLines.validate())
+    refLines.setOrder(orderSeen);
 
-  order = orderCounts.classify();
+  refLines.setFileData(0, group.count(), group.countBoards());
   return true;
 }
 
@@ -347,6 +919,9 @@ bool dispatchReadFile(
 {
   try
   {
+    if (format == BRIDGE_FORMAT_BDB)
+      return readBDBFile(fname, group, refLines);
+
     Buffer buffer;
     buffer.read(fname, format, refLines);
     if (refLines.skip())
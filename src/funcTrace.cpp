@@ -14,6 +14,7 @@
 
 #include "Group.h"
 #include "Files.h"
+#include "DDBatch.h"
 #include "parse.h"
 
 #include "dll.h"
@@ -105,6 +106,8 @@ void str2BoardInstance(
 void makeTrace(
   Group& group,
   Files& files,
+  DDBatch& ddBatch,
+  DDBatch::Tickets& tickets,
   const string& fname)
 {
   // It is a bug that multiple segments in an input file which use
@@ -172,6 +175,13 @@ void makeTrace(
       copy(stPlay.begin(), stPlay.end(), pPBN.plays[u].cards);
       pPBN.plays[u].cards[stPlay.length()] = '\0';
 
+      if (ddBatch.active())
+      {
+        ddBatch.addTrace(fname, extStr, inst, bPBN.deals[u], 
+          pPBN.plays[u], tickets);
+        continue;
+      }
+
       bPBN.noOfBoards++;
       pPBN.noOfBoards++;
 
@@ -204,12 +214,27 @@ void makeTrace(
 void dispatchTrace(
   Group& group,
   Files& files,
+  DDBatch& ddBatch,
   const string& fname,
   ostream& flog)
 {
+  DDBatch::Tickets tickets;
+  try
+  {
+    makeTrace(group, files, ddBatch, tickets, fname);
+  }
+  catch (Bexcept& bex)
+  {
+    bex.print(flog);
+  }
+
+  // The batches refer to instances in group, so always wait for them.
+  if (tickets.empty())
+    return;
+
   try
   {
-    makeTrace(group, files, fname);
+    ddBatch.wait(tickets);
   }
   catch (Bexcept& bex)
   {
@@ -14,6 +14,7 @@
 
 class Group;
 class Files;
+class DDBatch;
 
 using namespace std;
 
@@ -21,6 +22,7 @@ using namespace std;
 void dispatchTrace(
   Group& group,
   Files& files,
+  DDBatch& ddBatch,
   const string& fname,
   ostream& flog);
 
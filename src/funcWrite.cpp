@@ -11,6 +11,12 @@
 #include <sstream>
 #include <fstream>
 
+#if defined(_WIN32) && defined(__MINGW32__)
+  #include "mingw.thread.h"
+#else
+  #include <thread>
+#endif
+
 #include "Group.h"
 
 #include "fileLIN.h"
@@ -19,6 +25,7 @@
 #include "fileTXT.h"
 #include "fileEML.h"
 #include "fileREC.h"
+#include "fileBDB.h"
 
 #include "parse.h"
 #include "Bexcept.h"
@@ -26,51 +33,235 @@
 
 using namespace std;
 
-typedef void (*SegPtr)(string&, const Segment&, const Format);
+// The writers are instantiated for each format, so the format is a
+// constant inside them.
+
+typedef void (*SegPtr)(string&, const Segment&);
 typedef void (*BoardPtr)(string&, const Segment&, const Board&, 
-  WriteInfo&, const Format);
+  WriteInfo&);
+typedef void (*FilePtr)(const string&, const Format, const BoardOrder,
+  const Group&, const bool, string&);
 
 static SegPtr segPtr[BRIDGE_FORMAT_LABELS_SIZE];
 static BoardPtr boardPtr[BRIDGE_FORMAT_LABELS_SIZE];
+static FilePtr filePtr[BRIDGE_FORMAT_LABELS_SIZE];
+
+// Output whose text is not needed afterwards is written to its file
+// as it is produced, in chunks of about this size.  Then the text
+// never holds much more than a chunk, whatever the size of the file,
+// and the same buffer is reused for each chunk.
+
+#define WRITE_CHUNK 65536
+
+struct WriteSink
+{
+  Format format;
+  string * text;
+  string fname;
+  bool streamFlag;
+  FILE * fp;
+  WriteInfo writeInfo;
+  bool failFlag;
+};
 
 
 static void writeDummySegmentLevel(
   string& st,
-  const Segment& segment,
-  const Format format)
+  const Segment& segment)
 {
   UNUSED(st);
   UNUSED(segment);
-  UNUSED(format);
 }
 
 
-void setWriteTables()
+static FILE * openOutput(const string& fname)
 {
-  segPtr[BRIDGE_FORMAT_LIN] = &writeLINSegmentLevel;
-  segPtr[BRIDGE_FORMAT_LIN_RP] = &writeLINSegmentLevel;
-  segPtr[BRIDGE_FORMAT_LIN_VG] = &writeLINSegmentLevel;
-  segPtr[BRIDGE_FORMAT_LIN_TRN] = &writeLINSegmentLevel;
-  segPtr[BRIDGE_FORMAT_PBN] = &writeDummySegmentLevel;
-  segPtr[BRIDGE_FORMAT_RBN] = &writeRBNSegmentLevel;
-  segPtr[BRIDGE_FORMAT_RBX] = &writeRBNSegmentLevel;
-  segPtr[BRIDGE_FORMAT_TXT] = &writeTXTSegmentLevel;
-  segPtr[BRIDGE_FORMAT_EML] = &writeDummySegmentLevel;
-  segPtr[BRIDGE_FORMAT_REC] = &writeDummySegmentLevel;
+  FILE * fp = fopen(fname.c_str(), "wb");
+  if (fp == nullptr)
+    THROW("Cannot open output file " + fname);
+  return fp;
+}
+
 
-  boardPtr[BRIDGE_FORMAT_LIN] = &writeLINBoardLevel;
-  boardPtr[BRIDGE_FORMAT_LIN_RP] = &writeLINBoardLevel;
-  boardPtr[BRIDGE_FORMAT_LIN_VG] = &writeLINBoardLevel;
-  boardPtr[BRIDGE_FORMAT_LIN_TRN] = &writeLINBoardLevel;
-  boardPtr[BRIDGE_FORMAT_PBN] = &writePBNBoardLevel;
-  boardPtr[BRIDGE_FORMAT_RBN] = &writeRBNBoardLevel;
-  boardPtr[BRIDGE_FORMAT_RBX] = &writeRBNBoardLevel;
-  boardPtr[BRIDGE_FORMAT_TXT] = &writeTXTBoardLevel;
-  boardPtr[BRIDGE_FORMAT_EML] = &writeEMLBoardLevel;
-  boardPtr[BRIDGE_FORMAT_REC] = &writeRECBoardLevel;
+static void flushOutput(
+  FILE * fp,
+  string& text,
+  const size_t chunk)
+{
+  // Writes out the text once it has grown to a chunk, and keeps the
+  // buffer for the next one.
+  if (fp == nullptr || text.length() < chunk)
+    return;
+
+  if (fwrite(text.data(), 1, text.length(), fp) != text.length())
+    THROW("Cannot write output file");
+  text.clear();
 }
 
 
+static void abandonOutput(
+  FILE * fp,
+  const string& fname)
+{
+  // A streamed file that fails half-way is not left behind.
+  if (fp == nullptr)
+    return;
+
+  fclose(fp);
+  remove(fname.c_str());
+}
+
+
+static void resetWriteInfo(
+  const Segment& segment,
+  WriteInfo& writeInfo)
+{
+  writeInfo.namesOld[0] = "";
+  writeInfo.namesOld[1] = "";
+  writeInfo.score1 = 0;
+  writeInfo.score2 = 0;
+  writeInfo.numBoards = segment.size();
+  writeInfo.first = true;
+  writeInfo.last = false;
+}
+
+
+static void copyPosition(
+  const WriteInfo& pos,
+  WriteInfo& writeInfo)
+{
+  // Only the fields that the board loop sets.  The names and scores
+  // belong to each format.
+  writeInfo.bno = pos.bno;
+  writeInfo.instNo = pos.instNo;
+  writeInfo.ino = pos.ino;
+  writeInfo.numInst = pos.numInst;
+  writeInfo.numInstActive = pos.numInstActive;
+  writeInfo.first = pos.first;
+  writeInfo.last = pos.last;
+}
+
+
+// A single format.  The writers are template arguments, so they are
+// called directly rather than through the tables.
+
+template <SegPtr writeSegment, BoardPtr writeBoardLevel>
+struct FormatSink
+{
+  string * text;
+  FILE * fp;
+  WriteInfo writeInfo;
+
+  void startSegment(const Segment& segment)
+  {
+    writeSegment(* text, segment);
+    resetWriteInfo(segment, writeInfo);
+  }
+
+  void writeBoard(
+    const Segment& segment,
+    const Board& board,
+    const WriteInfo& pos)
+  {
+    copyPosition(pos, writeInfo);
+    writeBoardLevel(* text, segment, board, writeInfo);
+    flushOutput(fp, * text, WRITE_CHUNK);
+  }
+};
+
+
+// Several formats that are fed from the same pass.  The boards are
+// queued in blocks, and each format writes a whole block in turn.
+// This keeps the board data in cache without switching between the
+// writers on every board, which would be slower than separate
+// passes.  As with separate passes, an error in one format only
+// stops that format.
+
+#define WRITE_BLOCK 64
+
+struct BoardSlot
+{
+  const Board * board;
+  WriteInfo pos;
+};
+
+struct SinkList
+{
+  vector<WriteSink *> sinks;
+  ostream * flog;
+  const Segment * segment;
+  vector<BoardSlot> slots;
+
+  void startSegment(const Segment& seg)
+  {
+    SinkList::flush();
+    segment = &seg;
+
+    for (auto sink: sinks)
+    {
+      if (sink->failFlag)
+        continue;
+
+      try
+      {
+        (* segPtr[sink->format])(* sink->text, seg);
+        resetWriteInfo(seg, sink->writeInfo);
+      }
+      catch (Bexcept& bex)
+      {
+        bex.print(* flog);
+        sink->failFlag = true;
+      }
+    }
+  }
+
+  void writeBoard(
+    const Segment& seg,
+    const Board& board,
+    const WriteInfo& pos)
+  {
+    UNUSED(seg);
+    BoardSlot slot;
+    slot.board = &board;
+    slot.pos = pos;
+    slots.push_back(slot);
+
+    if (slots.size() == WRITE_BLOCK)
+      SinkList::flush();
+  }
+
+  void flush()
+  {
+    if (slots.empty())
+      return;
+
+    for (auto sink: sinks)
+    {
+      if (sink->failFlag)
+        continue;
+
+      WriteInfo& writeInfo = sink->writeInfo;
+      try
+      {
+        for (auto &slot: slots)
+        {
+          copyPosition(slot.pos, writeInfo);
+          (* boardPtr[sink->format])(* sink->text, * segment,
+            * slot.board, writeInfo);
+        }
+        flushOutput(sink->fp, * sink->text, WRITE_CHUNK);
+      }
+      catch (Bexcept& bex)
+      {
+        bex.print(* flog);
+        sink->failFlag = true;
+      }
+    }
+    slots.clear();
+  }
+};
+
+
 static void writeHeader(
   const Format format,
   const Group& group,
@@ -106,38 +297,34 @@ static void writeFast(
   const string& fname,
   const string& text)
 {
-  FILE* pFile;
-  pFile = fopen(fname.c_str(), "wb");
-  fwrite(text.c_str(), 1, text.length(), pFile);
-  fclose(pFile);
+  FILE * fp = openOutput(fname);
+  const bool okFlag =
+    (fwrite(text.c_str(), 1, text.length(), fp) == text.length());
+  fclose(fp);
+
+  if (! okFlag)
+    THROW("Cannot write output file " + fname);
 }
 
 
-static void writeFormattedFile(
-  const string& fname,
-  const Format format,
-  const BoardOrder order,
+template <class Sink>
+static void writeBoards(
   const Group& group,
-  string& text)
+  const BoardOrder order,
+  const bool linFlag,
+  Sink& sink)
 {
-  WriteInfo writeInfo;
-
-  writeHeader(format, group, text);
+  // Goes over the boards once in output order.  The OOCC order is
+  // only used for LIN output.
+  WriteInfo pos;
 
   for (auto &segment: group)
   {
     if (segment.size() == 0)
       continue;
 
-    (* segPtr[format])(text, segment, format);
-
-    writeInfo.namesOld[0] = "";
-    writeInfo.namesOld[1] = "";
-    writeInfo.score1 = 0;
-    writeInfo.score2 = 0;
-    writeInfo.numBoards = segment.size();
-    writeInfo.first = true;
-    writeInfo.last = false;
+    sink.startSegment(segment);
+    resetWriteInfo(segment, pos);
     const unsigned lastRealNo = segment.lastRealBoardNumber();
 
     if (order == ORDER_COCO)
@@ -147,24 +334,23 @@ static void writeFormattedFile(
       {
         const Board& board = bpair.board;
         if (bpair.extNo == lastRealNo)
-          writeInfo.last = true;
+          pos.last = true;
 
-        writeInfo.bno = bpair.extNo;
-        writeInfo.numInst = board.countAll();
-        writeInfo.numInstActive = board.count();
+        pos.bno = bpair.extNo;
+        pos.numInst = board.countAll();
+        pos.numInstActive = board.count();
 
-        for (unsigned i = 0, j = writeInfo.numInst-1; 
-            i < writeInfo.numInst; i++, j--)
+        for (unsigned i = 0, j = pos.numInst-1;
+            i < pos.numInst; i++, j--)
         {
-          writeInfo.instNo = j;
-          writeInfo.ino = i;
-          (* boardPtr[format])(text, segment, board, writeInfo, format);
-          writeInfo.first = false;
+          pos.instNo = j;
+          pos.ino = i;
+          sink.writeBoard(segment, board, pos);
+          pos.first = false;
         }
       }
     }
-    else if (order == ORDER_OOCC &&
-        FORMAT_INPUT_MAP[format] == BRIDGE_FORMAT_LIN)
+    else if (order == ORDER_OOCC && linFlag)
     {
       // o1, o2, ..., c1, c2, ...
       for (unsigned i = 0; i < 2; i++)
@@ -173,18 +359,18 @@ static void writeFormattedFile(
         {
           const Board& board = bpair.board;
           if (bpair.extNo == lastRealNo)
-            writeInfo.last = true;
+            pos.last = true;
 
-          writeInfo.bno = bpair.extNo;
-          writeInfo.numInst = board.countAll();
-          writeInfo.numInstActive = board.count();
-          if (writeInfo.numInst > 2)
+          pos.bno = bpair.extNo;
+          pos.numInst = board.countAll();
+          pos.numInstActive = board.count();
+          if (pos.numInst > 2)
             THROW("Too many instances for OOCC output order");
 
-          writeInfo.instNo = i;
-          writeInfo.ino = i;
-          (* boardPtr[format])(text, segment, board, writeInfo, format);
-          writeInfo.first = false;
+          pos.instNo = i;
+          pos.ino = i;
+          sink.writeBoard(segment, board, pos);
+          pos.first = false;
         }
       }
     }
@@ -195,40 +381,137 @@ static void writeFormattedFile(
       {
         const Board& board = bpair.board;
         if (bpair.extNo == lastRealNo)
-          writeInfo.last = true;
+          pos.last = true;
 
-        writeInfo.bno = bpair.extNo;
-        writeInfo.numInst = board.countAll();
-        writeInfo.numInstActive = board.count();
+        pos.bno = bpair.extNo;
+        pos.numInst = board.countAll();
+        pos.numInstActive = board.count();
 
-        for (unsigned i = 0; i < writeInfo.numInst; i++)
+        for (unsigned i = 0; i < pos.numInst; i++)
         {
-          writeInfo.instNo = i;
-          writeInfo.ino = i;
-          (* boardPtr[format])(text, segment, board, writeInfo, format);
-          writeInfo.first = false;
+          pos.instNo = i;
+          pos.ino = i;
+          sink.writeBoard(segment, board, pos);
+          pos.first = false;
         }
       }
     }
   }
+}
+
+
+template <SegPtr writeSegment, BoardPtr writeBoardLevel>
+static void writeFormattedFile(
+  const string& fname,
+  const Format format,
+  const BoardOrder order,
+  const Group& group,
+  const bool streamFlag,
+  string& text)
+{
+  FormatSink<writeSegment, writeBoardLevel> sink;
+  sink.text = &text;
+  sink.fp = (streamFlag && fname != "" ? openOutput(fname) : nullptr);
+
+  try
+  {
+    writeHeader(format, group, text);
+    writeBoards(group, order, FORMAT_INPUT_MAP[format] == BRIDGE_FORMAT_LIN,
+      sink);
+    flushOutput(sink.fp, text, 0);
+  }
+  catch (Bexcept&)
+  {
+    abandonOutput(sink.fp, fname);
+    throw;
+  }
 
-  if (fname != "")
+  if (sink.fp != nullptr)
+    fclose(sink.fp);
+  else if (fname != "")
     writeFast(fname, text);
 }
 
 
+void setWriteTables()
+{
+  segPtr[BRIDGE_FORMAT_LIN] = &writeLINSegmentLevel<BRIDGE_FORMAT_LIN>;
+  segPtr[BRIDGE_FORMAT_LIN_RP] = &writeLINSegmentLevel<BRIDGE_FORMAT_LIN_RP>;
+  segPtr[BRIDGE_FORMAT_LIN_VG] = &writeLINSegmentLevel<BRIDGE_FORMAT_LIN_VG>;
+  segPtr[BRIDGE_FORMAT_LIN_TRN] =
+    &writeLINSegmentLevel<BRIDGE_FORMAT_LIN_TRN>;
+  segPtr[BRIDGE_FORMAT_PBN] = &writeDummySegmentLevel;
+  segPtr[BRIDGE_FORMAT_RBN] = &writeRBNSegmentLevel<BRIDGE_FORMAT_RBN>;
+  segPtr[BRIDGE_FORMAT_RBX] = &writeRBNSegmentLevel<BRIDGE_FORMAT_RBX>;
+  segPtr[BRIDGE_FORMAT_TXT] = &writeTXTSegmentLevel<BRIDGE_FORMAT_TXT>;
+  segPtr[BRIDGE_FORMAT_EML] = &writeDummySegmentLevel;
+  segPtr[BRIDGE_FORMAT_REC] = &writeDummySegmentLevel;
+
+  boardPtr[BRIDGE_FORMAT_LIN] = &writeLINBoardLevel<BRIDGE_FORMAT_LIN>;
+  boardPtr[BRIDGE_FORMAT_LIN_RP] = &writeLINBoardLevel<BRIDGE_FORMAT_LIN_RP>;
+  boardPtr[BRIDGE_FORMAT_LIN_VG] = &writeLINBoardLevel<BRIDGE_FORMAT_LIN_VG>;
+  boardPtr[BRIDGE_FORMAT_LIN_TRN] =
+    &writeLINBoardLevel<BRIDGE_FORMAT_LIN_TRN>;
+  boardPtr[BRIDGE_FORMAT_PBN] = &writePBNBoardLevel<BRIDGE_FORMAT_PBN>;
+  boardPtr[BRIDGE_FORMAT_RBN] = &writeRBNBoardLevel<BRIDGE_FORMAT_RBN>;
+  boardPtr[BRIDGE_FORMAT_RBX] = &writeRBNBoardLevel<BRIDGE_FORMAT_RBX>;
+  boardPtr[BRIDGE_FORMAT_TXT] = &writeTXTBoardLevel<BRIDGE_FORMAT_TXT>;
+  boardPtr[BRIDGE_FORMAT_EML] = &writeEMLBoardLevel<BRIDGE_FORMAT_EML>;
+  boardPtr[BRIDGE_FORMAT_REC] = &writeRECBoardLevel<BRIDGE_FORMAT_REC>;
+
+  filePtr[BRIDGE_FORMAT_LIN] = &writeFormattedFile<
+    &writeLINSegmentLevel<BRIDGE_FORMAT_LIN>,
+    &writeLINBoardLevel<BRIDGE_FORMAT_LIN>>;
+  filePtr[BRIDGE_FORMAT_LIN_RP] = &writeFormattedFile<
+    &writeLINSegmentLevel<BRIDGE_FORMAT_LIN_RP>,
+    &writeLINBoardLevel<BRIDGE_FORMAT_LIN_RP>>;
+  filePtr[BRIDGE_FORMAT_LIN_VG] = &writeFormattedFile<
+    &writeLINSegmentLevel<BRIDGE_FORMAT_LIN_VG>,
+    &writeLINBoardLevel<BRIDGE_FORMAT_LIN_VG>>;
+  filePtr[BRIDGE_FORMAT_LIN_TRN] = &writeFormattedFile<
+    &writeLINSegmentLevel<BRIDGE_FORMAT_LIN_TRN>,
+    &writeLINBoardLevel<BRIDGE_FORMAT_LIN_TRN>>;
+  filePtr[BRIDGE_FORMAT_PBN] = &writeFormattedFile<
+    &writeDummySegmentLevel,
+    &writePBNBoardLevel<BRIDGE_FORMAT_PBN>>;
+  filePtr[BRIDGE_FORMAT_RBN] = &writeFormattedFile<
+    &writeRBNSegmentLevel<BRIDGE_FORMAT_RBN>,
+    &writeRBNBoardLevel<BRIDGE_FORMAT_RBN>>;
+  filePtr[BRIDGE_FORMAT_RBX] = &writeFormattedFile<
+    &writeRBNSegmentLevel<BRIDGE_FORMAT_RBX>,
+    &writeRBNBoardLevel<BRIDGE_FORMAT_RBX>>;
+  filePtr[BRIDGE_FORMAT_TXT] = &writeFormattedFile<
+    &writeTXTSegmentLevel<BRIDGE_FORMAT_TXT>,
+    &writeTXTBoardLevel<BRIDGE_FORMAT_TXT>>;
+  filePtr[BRIDGE_FORMAT_EML] = &writeFormattedFile<
+    &writeDummySegmentLevel,
+    &writeEMLBoardLevel<BRIDGE_FORMAT_EML>>;
+  filePtr[BRIDGE_FORMAT_REC] = &writeFormattedFile<
+    &writeDummySegmentLevel,
+    &writeRECBoardLevel<BRIDGE_FORMAT_REC>>;
+}
+
+
 void dispatchWrite(
   const string& fname,
   const Format format,
   const BoardOrder order,
   const Group& group,
+  const bool streamFlag,
   string& text,
   ostream& flog)
 {
   try
   {
     text = "";
-    writeFormattedFile(fname, format, order, group, text);
+    if (format == BRIDGE_FORMAT_BDB)
+    {
+      writeBDBGroup(text, group, order);
+      if (fname != "")
+        writeFast(fname, text);
+    }
+    else
+      (* filePtr[format])(fname, format, order, group, streamFlag, text);
   }
   catch (Bexcept& bex)
   {
@@ -236,3 +519,138 @@ void dispatchWrite(
   }
 }
 
+
+static void writeSinks(
+  const BoardOrder order,
+  const Group& group,
+  vector<WriteSink>& sinks,
+  ostream& flog)
+{
+  // One pass over the boards for all the sinks, except that with
+  // OOCC order the LIN formats need a pass of their own.
+  SinkList passes[2];
+  for (unsigned p = 0; p < 2; p++)
+  {
+    passes[p].flog = &flog;
+    passes[p].segment = nullptr;
+    passes[p].slots.reserve(WRITE_BLOCK);
+  }
+
+  for (auto &sink: sinks)
+  {
+    try
+    {
+      * sink.text = "";
+      if (sink.streamFlag && sink.fname != "")
+        sink.fp = openOutput(sink.fname);
+
+      if (sink.format == BRIDGE_FORMAT_BDB)
+        writeBDBGroup(* sink.text, group, order);
+      else
+      {
+        writeHeader(sink.format, group, * sink.text);
+        const bool linFlag =
+          (FORMAT_INPUT_MAP[sink.format] == BRIDGE_FORMAT_LIN);
+        passes[order == ORDER_OOCC && linFlag ? 1 : 0].
+          sinks.push_back(&sink);
+      }
+    }
+    catch (Bexcept& bex)
+    {
+      bex.print(flog);
+      sink.failFlag = true;
+    }
+  }
+
+  for (unsigned p = 0; p < 2; p++)
+  {
+    if (passes[p].sinks.empty())
+      continue;
+
+    try
+    {
+      writeBoards(group, order, p == 1, passes[p]);
+      passes[p].flush();
+    }
+    catch (Bexcept& bex)
+    {
+      // The traversal itself failed, so the whole pass did.
+      bex.print(flog);
+      for (auto sink: passes[p].sinks)
+        sink->failFlag = true;
+    }
+  }
+
+  for (auto &sink: sinks)
+  {
+    if (sink.failFlag)
+    {
+      abandonOutput(sink.fp, sink.fname);
+      continue;
+    }
+
+    try
+    {
+      if (sink.fp != nullptr)
+      {
+        flushOutput(sink.fp, * sink.text, 0);
+        fclose(sink.fp);
+      }
+      else if (sink.fname != "")
+        writeFast(sink.fname, * sink.text);
+    }
+    catch (Bexcept& bex)
+    {
+      bex.print(flog);
+      abandonOutput(sink.fp, sink.fname);
+    }
+  }
+}
+
+
+void dispatchWriteAll(
+  const vector<FileOutputTask>& taskList,
+  const BoardOrder order,
+  const Group& group,
+  const vector<bool>& streamFlags,
+  const unsigned numThreads,
+  vector<string>& texts,
+  ostream& flog)
+{
+  // Writes all the output formats of a group from a shared pass over
+  // its boards.  With several threads, the formats are dealt out
+  // among them, and each thread makes its own pass.
+  const unsigned n = static_cast<unsigned>(taskList.size());
+  texts.resize(n);
+  if (n == 0)
+    return;
+
+  const unsigned m = (numThreads == 0 ? 1 : min(numThreads, n));
+  vector<vector<WriteSink>> sinkGroups(m);
+  for (unsigned i = 0; i < n; i++)
+  {
+    WriteSink sink = WriteSink();
+    sink.format = taskList[i].formatOutput;
+    sink.text = &texts[i];
+    sink.fname = taskList[i].fileOutput;
+    sink.streamFlag = streamFlags[i];
+    sink.fp = nullptr;
+    sink.failFlag = false;
+    sinkGroups[i % m].push_back(sink);
+  }
+
+  // Errors from the other threads are collected and printed in order.
+  vector<stringstream> logs(m);
+  vector<thread> thr(m-1);
+  for (unsigned k = 1; k < m; k++)
+    thr[k-1] = thread(writeSinks, order, cref(group),
+      ref(sinkGroups[k]), ref(logs[k]));
+
+  writeSinks(order, group, sinkGroups[0], flog);
+
+  for (auto &t: thr)
+    t.join();
+
+  for (unsigned k = 1; k < m; k++)
+    flog << logs[k].str();
+}
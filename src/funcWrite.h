@@ -10,6 +10,8 @@
 #ifndef BRIDGE_FUNCWRITE_H
 #define BRIDGE_FUNCWRITE_H
 
+#include <vector>
+
 #include "bconst.h"
 
 class Group;
@@ -24,7 +26,17 @@ void dispatchWrite(
   const Format format,
   const BoardOrder order,
   const Group& group,
+  const bool streamFlag,
   string& text,
   ostream& flog);
 
+void dispatchWriteAll(
+  const vector<FileOutputTask>& taskList,
+  const BoardOrder order,
+  const Group& group,
+  const vector<bool>& streamFlags,
+  const unsigned numThreads,
+  vector<string>& texts,
+  ostream& flog);
+
 #endif
@@ -22,12 +22,52 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "parse.h"
+#include "Bexcept.h"
 
 using namespace std;
 
 
+static StrView makeView(
+  const char * text,
+  const size_t len)
+{
+  StrView view;
+  view.text = text;
+  view.len = static_cast<unsigned>(len);
+  return view;
+}
+
+
+StrView str2view(const string& text)
+{
+  return makeView(text.data(), text.length());
+}
+
+
+string view2str(const StrView& view)
+{
+  return string(view.text, view.len);
+}
+
+
+static bool isDelimiter(
+  const char c,
+  const string& delimiters)
+{
+  return (delimiters.find(c) != string::npos);
+}
+
+
+static bool isWhitespace(const char c)
+{
+  return (c == ' ' || c == '\t' || c == '\n' ||
+      c == '\v' || c == '\f' || c == '\r');
+}
+
+
 // tokenize splits a string into tokens separated by delimiter.
 // http://stackoverflow.com/questions/236129/split-a-string-in-c
 
@@ -58,6 +98,47 @@ void tokenize(
 }
 
 
+bool tokenize(
+  const StrView& text,
+  StrView tokens[],
+  const unsigned maxCount,
+  unsigned& actualCount,
+  const string& delimiters)
+{
+  actualCount = 0;
+  unsigned lastPos = 0;
+  for (unsigned pos = 0; pos <= text.len; pos++)
+  {
+    if (pos < text.len && ! isDelimiter(text.text[pos], delimiters))
+      continue;
+
+    if (actualCount == maxCount)
+      return false;
+
+    tokens[actualCount++] = makeView(text.text + lastPos, pos - lastPos);
+    lastPos = pos + 1;
+  }
+  return true;
+}
+
+
+void tokenize(
+  const StrView& text,
+  vector<StrView>& tokens,
+  const string& delimiters)
+{
+  unsigned lastPos = 0;
+  for (unsigned pos = 0; pos <= text.len; pos++)
+  {
+    if (pos < text.len && ! isDelimiter(text.text[pos], delimiters))
+      continue;
+
+    tokens.push_back(makeView(text.text + lastPos, pos - lastPos));
+    lastPos = pos + 1;
+  }
+}
+
+
 void tokenizeMinus(
   const string& text, 
   vector<string>& tokens,
@@ -70,6 +151,19 @@ void tokenizeMinus(
 }
 
 
+void tokenizeMinus(
+  const StrView& text,
+  vector<StrView>& tokens,
+  const string& delimiters)
+{
+  // Only works for a length-1 delimiters string.
+  tokenize(text, tokens, delimiters);
+  if (text.len > 0 && delimiters.length() == 1 &&
+      text.text[text.len-1] == delimiters.at(0))
+    tokens.pop_back();
+}
+
+
 unsigned countDelimiters(
   const string& text,
   const string& delimiters)
@@ -82,6 +176,20 @@ unsigned countDelimiters(
 }
 
 
+unsigned countDelimiters(
+  const StrView& text,
+  const string& delimiters)
+{
+  unsigned c = 0;
+  for (unsigned pos = 0; pos < text.len; pos++)
+  {
+    if (isDelimiter(text.text[pos], delimiters))
+      c++;
+  }
+  return c;
+}
+
+
 void splitIntoWords(
   const string& text,
   vector<string>& words)
@@ -114,6 +222,40 @@ void splitIntoWords(
     words.push_back(text.substr(startPos, pos-startPos));
 }
 
+
+bool splitIntoWords(
+  const StrView& text,
+  StrView words[],
+  const unsigned maxCount,
+  unsigned& actualCount)
+{
+  // Split into words (split on \s+, effectively).
+  actualCount = 0;
+  unsigned startPos = 0;
+  bool isSpace = true;
+
+  for (unsigned pos = 0; pos <= text.len; pos++)
+  {
+    if (pos < text.len && text.text[pos] != ' ')
+    {
+      if (isSpace)
+      {
+        isSpace = false;
+        startPos = pos;
+      }
+    }
+    else if (! isSpace)
+    {
+      if (actualCount == maxCount)
+        return false;
+
+      words[actualCount++] = makeView(text.text + startPos, pos - startPos);
+      isSpace = true;
+    }
+  }
+  return true;
+}
+
 // https://en.wikibooks.org/wiki/Algorithm_Implementation/Strings/Levenshtein_distance#C.2B.2B
 unsigned levenshtein(
   const string& s1, 
@@ -193,27 +335,73 @@ bool levenshtein_test(
 
 // getWords splits on one or more whitespaces
 
+static bool nextWord(
+  const StrView& text,
+  unsigned& pos,
+  StrView& word)
+{
+  while (pos < text.len && isWhitespace(text.text[pos]))
+    pos++;
+
+  if (pos == text.len)
+    return false;
+
+  const unsigned startPos = pos;
+  while (pos < text.len && ! isWhitespace(text.text[pos]))
+    pos++;
+
+  word = makeView(text.text + startPos, pos - startPos);
+  return true;
+}
+
+
 bool getWords(
   const string& text,
   string words[],
   const int maxCount,
   unsigned& actualCount)
 {
-  regex whitespace("(\\S+)");
-  auto wordsBegin = sregex_iterator(text.begin(), text.end(), whitespace);
-  auto wordsEnd = sregex_iterator();
+  const StrView view = str2view(text);
+  StrView word;
+  unsigned pos = 0;
+  int count = 0;
+  while (nextWord(view, pos, word))
+    count++;
 
-  if (distance(wordsBegin, wordsEnd) > maxCount)
+  if (count > maxCount)
     return false;
 
   actualCount = 0;
-  for (sregex_iterator it = wordsBegin; it != wordsEnd; it++)
-    words[actualCount++] = it->str();
+  pos = 0;
+  while (nextWord(view, pos, word))
+    words[actualCount++] = view2str(word);
 
   return true;
 }
 
 
+bool getWords(
+  const StrView& text,
+  StrView words[],
+  const int maxCount,
+  unsigned& actualCount)
+{
+  StrView word;
+  unsigned pos = 0;
+  int count = 0;
+  while (nextWord(text, pos, word))
+  {
+    if (count == maxCount)
+      return false;
+
+    words[count++] = word;
+  }
+
+  actualCount = static_cast<unsigned>(count);
+  return true;
+}
+
+
 string posOrDash(const unsigned u)
 {
   if (u == 0)
@@ -459,6 +647,35 @@ void str2lines(
 }
 
 
+bool str2lines(
+  const StrView& text,
+  StrView lines[],
+  const unsigned maxCount,
+  unsigned& actualCount)
+{
+  actualCount = 0;
+  unsigned p = 0;
+  while (p < text.len)
+  {
+    if (actualCount == maxCount)
+      return false;
+
+    const char * found = static_cast<const char *>
+      (memchr(text.text + p, '\n', text.len - p));
+    if (found == nullptr)
+    {
+      lines[actualCount++] = makeView(text.text + p, text.len - p);
+      return true;
+    }
+
+    const unsigned pos = static_cast<unsigned>(found - text.text);
+    lines[actualCount++] = makeView(text.text + p, pos - p);
+    p = pos+1;
+  }
+  return true;
+}
+
+
 string chars2str(char * buffer, unsigned buflen)
 {
   return string(buffer, buflen);
@@ -509,6 +726,8 @@ Format ext2format(const string& text)
     return BRIDGE_FORMAT_EML;
   else if (st == "REC")
     return BRIDGE_FORMAT_REC;
+  else if (st == "BDB")
+    return BRIDGE_FORMAT_BDB;
   else
     return BRIDGE_FORMAT_SIZE;
 }
@@ -598,6 +817,14 @@ void appendFile(
 }
 
 
+size_t heapSize(const string& st)
+{
+  // The common libraries keep strings of up to 15 characters in the
+  // string object itself.
+  return (st.capacity() > 15 ? st.capacity() + 1 : 0);
+}
+
+
 string basefile(const string& path)
 {
   size_t pos = path.find_last_of("/\\");
@@ -891,3 +1118,62 @@ string guessOriginalLine(
   }
 }
 
+
+// Fields for cached stats.  A string is written with its length
+// first, as it may contain spaces and newlines.
+
+void writeField(
+  ostream& fout,
+  const string& text)
+{
+  fout << text.length() << " " << text << "\n";
+}
+
+
+void writeField(
+  ostream& fout,
+  const unsigned u)
+{
+  fout << u << "\n";
+}
+
+
+void writeField(
+  ostream& fout,
+  const uint64_t u)
+{
+  fout << u << "\n";
+}
+
+
+void readField(
+  istream& fin,
+  string& text)
+{
+  size_t l;
+  if (! (fin >> l) || fin.get() != ' ')
+    THROW("Bad string field");
+
+  text.resize(l);
+  if (l > 0 && ! fin.read(&text[0], static_cast<streamsize>(l)))
+    THROW("Truncated string field");
+}
+
+
+void readField(
+  istream& fin,
+  unsigned& u)
+{
+  if (! (fin >> u))
+    THROW("Bad number field");
+}
+
+
+void readField(
+  istream& fin,
+  uint64_t& u)
+{
+  if (! (fin >> u))
+    THROW("Bad number field");
+}
+
@@ -9,32 +9,80 @@
 #ifndef BRIDGE_PARSE_H
 #define BRIDGE_PARSE_H
 
+#include <iostream>
 #include <string>
 #include <vector>
+#include <cstdint>
 
 #include "bconst.h"
 
 using namespace std;
 
 
+// A StrView is a piece of text that is owned by someone else, so it
+// is only valid as long as that text is unchanged.  The StrView
+// versions of the parsing functions below give the same pieces as
+// the string versions without copying them.  The array versions
+// never allocate and return false if there are more than maxCount
+// pieces.  The vector versions append like the string versions, so
+// a vector that the caller clears and reuses stops allocating once
+// it is large enough.
+
+struct StrView
+{
+  const char * text;
+  unsigned len;
+};
+
+StrView str2view(const string& text);
+
+string view2str(const StrView& view);
+
 void tokenize(
   const string& text,
   vector<string>& tokens,
   const string& delimiters);
 
+bool tokenize(
+  const StrView& text,
+  StrView tokens[],
+  const unsigned maxCount,
+  unsigned& actualCount,
+  const string& delimiters);
+
+void tokenize(
+  const StrView& text,
+  vector<StrView>& tokens,
+  const string& delimiters);
+
 void tokenizeMinus(
   const string& text,
   vector<string>& tokens,
   const string& delimiters);
 
+void tokenizeMinus(
+  const StrView& text,
+  vector<StrView>& tokens,
+  const string& delimiters);
+
 unsigned countDelimiters(
   const string& text,
   const string& delimiters);
 
+unsigned countDelimiters(
+  const StrView& text,
+  const string& delimiters);
+
 void splitIntoWords(
   const string& text,
   vector<string>& words);
 
+bool splitIntoWords(
+  const StrView& text,
+  StrView words[],
+  const unsigned maxCount,
+  unsigned& actualCount);
+
 unsigned levenshtein(
   const string& s1,
   const string& s2);
@@ -50,6 +98,12 @@ bool getWords(
   const int maxCount,
   unsigned& actualCount);
 
+bool getWords(
+  const StrView& text,
+  StrView words[],
+  const int maxCount,
+  unsigned& actualCount);
+
 string concat(
   const vector<string>& list,
   const string& delim);
@@ -86,6 +140,12 @@ void str2lines(
   const string& sin,
   vector<string>& sout);
 
+bool str2lines(
+  const StrView& text,
+  StrView lines[],
+  const unsigned maxCount,
+  unsigned& actualCount);
+
 string chars2str(
   char * buffer,
   unsigned buflen);
@@ -109,6 +169,8 @@ void appendFile(
 void toUpper(string& text);
 void toLower(string& text);
 
+size_t heapSize(const string& st);
+
 string basefile(const string& path);
 string filepath(const string& path);
 
@@ -160,4 +222,28 @@ string guessOriginalLine(
   const string& fname,
   const unsigned count);
 
+void writeField(
+  ostream& fout,
+  const string& text);
+
+void writeField(
+  ostream& fout,
+  const unsigned u);
+
+void writeField(
+  ostream& fout,
+  const uint64_t u);
+
+void readField(
+  istream& fin,
+  string& text);
+
+void readField(
+  istream& fin,
+  unsigned& u);
+
+void readField(
+  istream& fin,
+  uint64_t& u);
+
 #endif
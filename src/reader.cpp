@@ -17,8 +17,11 @@
 
 #include "args.h"
 #include "Files.h"
+#include "DDBatch.h"
+#include "Pipeline.h"
 #include "AllStats.h"
 #include "dispatch.h"
+#include "ddsIF.h"
 
 using namespace std;
 
@@ -30,17 +33,44 @@ int main(int argc, char * argv[])
 
   setTables();
 
+  // Only the analyze stage does DD work in pipelined mode.
+  const unsigned numDDThreads = (options.pipelineFlag ?
+    options.stageThreads[BRIDGE_STAGE_ANALYZE] : options.numThreads);
+
+  // Cross-file batches are solved with the DDS batch functions.
+  setDDThreads(options.ddWait > 0 ? 1 : numDDThreads);
+
   Files files;
   files.set(options);
 
+  DDBatch ddBatch;
+  ddBatch.set(files, options.ddWait, numDDThreads);
+
+  Pipeline pipeline;
+  pipeline.set(options);
+
   vector<thread> thr(options.numThreads);
   vector<AllStats> allStatsList(options.numThreads);
 
   Timer timer;
   timer.start();
 
-  for (unsigned i = 0; i < options.numThreads; i++)
-    thr[i] = thread(dispatch, i, ref(files), options, ref(allStatsList[i]));
+  if (options.pipelineFlag)
+  {
+    unsigned i = 0;
+    for (unsigned s = 0; s < BRIDGE_STAGE_SIZE; s++)
+    {
+      for (unsigned j = 0; j < options.stageThreads[s]; j++, i++)
+        thr[i] = thread(dispatchStage, static_cast<PipeStage>(s), i, j,
+          ref(files), ref(ddBatch), ref(pipeline), options, 
+          ref(allStatsList[i]));
+    }
+  }
+  else
+  {
+    for (unsigned i = 0; i < options.numThreads; i++)
+      thr[i] = thread(dispatch, i, ref(files), ref(ddBatch), options, ref(allStatsList[i]));
+  }
 
   for (unsigned i = 0; i < options.numThreads; i++)
     thr[i].join();
@@ -52,9 +82,14 @@ int main(int argc, char * argv[])
     files.writeDDInfo(BRIDGE_DD_INFO_SOLVE);
   if (options.traceFlag)
     files.writeDDInfo(BRIDGE_DD_INFO_TRACE);
+  files.writeManifest();
 
   timer.stop();
 
   cout << "Time spent overall (elapsed): " << timer.str(2) << "\n";
+  cout << strDDThroughput(timer.seconds());
+  cout << files.strDDCache();
+  cout << files.strManifest();
+  cout << files.strCorpus();
 }
 